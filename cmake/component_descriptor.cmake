@@ -0,0 +1,32 @@
+# 嵌入式组件描述符：构建时校验组件的 metadata.json，并生成固定布局的二进制描述符（见
+# src/extsystem/include/extsystem/EmbeddedDescriptor.h）编译进组件库。ComponentLoader 扫描组件时直接读取该描述符，
+# 不再解析 JSON 元数据；没有嵌入式描述符的第三方插件仍走 Qt 插件元数据的路径。
+#
+# 用法（组件的 user_config.cmake）：
+#   if(COMMAND add_component_descriptor)
+#     add_component_descriptor(${PROJECT_NAME} "${CMAKE_CURRENT_SOURCE_DIR}/metadata.json")
+#   endif()
+#
+# metadata.json 不符合要求（缺少名称、版本号格式错误、字段类型错误等）时构建失败。
+
+set(_DS_COMPONENT_DESCRIPTOR_DIR "${CMAKE_CURRENT_LIST_DIR}")
+
+function(add_component_descriptor target metadata_file)
+  string(MAKE_C_IDENTIFIER "${target}" _descriptor_symbol)
+
+  set(_descriptor_source "${CMAKE_CURRENT_BINARY_DIR}/${target}_descriptor.cpp")
+
+  add_custom_command(
+    OUTPUT "${_descriptor_source}"
+    COMMAND
+      ${CMAKE_COMMAND} "-DMETADATA_FILE=${metadata_file}" "-DOUTPUT_FILE=${_descriptor_source}"
+      "-DDESCRIPTOR_SYMBOL=${_descriptor_symbol}"
+      "-DTEMPLATE_FILE=${_DS_COMPONENT_DESCRIPTOR_DIR}/component_descriptor.cpp.in" -P
+      "${_DS_COMPONENT_DESCRIPTOR_DIR}/component_descriptor_generate.cmake"
+    DEPENDS "${metadata_file}" "${_DS_COMPONENT_DESCRIPTOR_DIR}/component_descriptor.cpp.in"
+            "${_DS_COMPONENT_DESCRIPTOR_DIR}/component_descriptor_generate.cmake"
+    COMMENT "Validating ${metadata_file} and generating the embedded descriptor of ${target}"
+    VERBATIM)
+
+  target_sources(${target} PRIVATE "${_descriptor_source}")
+endfunction()
@@ -0,0 +1,240 @@
+# 由 cmake/component_descriptor.cmake 以脚本模式调用：校验 METADATA_FILE，并用 TEMPLATE_FILE 生成 OUTPUT_FILE。
+#
+# 字段区的布局与 src/extsystem/include/extsystem/EmbeddedDescriptor.h 中的 EmbeddedDescriptorField 保持一致。
+
+foreach(_variable METADATA_FILE OUTPUT_FILE DESCRIPTOR_SYMBOL TEMPLATE_FILE)
+  if(NOT DEFINED ${_variable})
+    message(FATAL_ERROR "component_descriptor_generate: ${_variable} is not set")
+  endif()
+endforeach()
+
+file(READ "${METADATA_FILE}" _metadata)
+
+function(_descriptor_error message)
+  message(FATAL_ERROR "${METADATA_FILE}: ${message}")
+endfunction()
+
+string(JSON _type ERROR_VARIABLE _error TYPE "${_metadata}")
+
+if(_error OR NOT _type STREQUAL "OBJECT")
+  _descriptor_error("the metadata must be a JSON object ${_error}")
+endif()
+
+# 把值转换为 C++ 原始字符串字面量，拒绝会破坏字段区布局的字符
+function(_descriptor_literal value key out_variable)
+  string(ASCII 30 _record_separator)
+  string(ASCII 31 _unit_separator)
+
+  if(value MATCHES "[\r\n]" OR value MATCHES "${_record_separator}" OR value MATCHES "${_unit_separator}")
+    _descriptor_error("\"${key}\" must not contain line breaks or control separators")
+  endif()
+
+  string(FIND "${value}" ")dsdesc\"" _position)
+
+  if(NOT _position EQUAL -1)
+    _descriptor_error("\"${key}\" must not contain ')dsdesc\"'")
+  endif()
+
+  if(value STREQUAL "")
+    set(${out_variable} "\"\"" PARENT_SCOPE)
+  else()
+    set(${out_variable} "R\"dsdesc(${value})dsdesc\"" PARENT_SCOPE)
+  endif()
+endfunction()
+
+# 读取可选的字符串字段，缺少时为空
+function(_descriptor_string json key required out_variable)
+  string(JSON _type ERROR_VARIABLE _error TYPE "${json}" "${key}")
+
+  if(_error)
+    if(required)
+      _descriptor_error("\"${key}\" is required")
+    endif()
+
+    set(${out_variable} "" PARENT_SCOPE)
+    return()
+  endif()
+
+  if(NOT _type STREQUAL "STRING")
+    _descriptor_error("\"${key}\" must be a string")
+  endif()
+
+  string(JSON _value GET "${json}" "${key}")
+
+  if(required AND _value STREQUAL "")
+    _descriptor_error("\"${key}\" must not be empty")
+  endif()
+
+  set(${out_variable} "${_value}" PARENT_SCOPE)
+endfunction()
+
+# 读取可选的字符串数组字段，返回以 0x1F 分隔的字面量
+function(_descriptor_string_array json key out_variable)
+  set(_literal "\"\"")
+
+  string(JSON _type ERROR_VARIABLE _error TYPE "${json}" "${key}")
+
+  if(NOT _error)
+    if(NOT _type STREQUAL "ARRAY")
+      _descriptor_error("\"${key}\" must be an array of strings")
+    endif()
+
+    string(JSON _length LENGTH "${json}" "${key}")
+
+    if(_length GREATER 0)
+      set(_literal "")
+      math(EXPR _last "${_length} - 1")
+
+      foreach(_index RANGE ${_last})
+        string(JSON _item_type TYPE "${json}" "${key}" ${_index})
+
+        if(NOT _item_type STREQUAL "STRING")
+          _descriptor_error("\"${key}\" must be an array of strings")
+        endif()
+
+        string(JSON _item GET "${json}" "${key}" ${_index})
+        _descriptor_literal("${_item}" "${key}" _item_literal)
+
+        if(_index GREATER 0)
+          string(APPEND _literal " \"\\x1f\" ")
+        endif()
+
+        string(APPEND _literal "${_item_literal}")
+      endforeach()
+    endif()
+  endif()
+
+  set(${out_variable} "${_literal}" PARENT_SCOPE)
+endfunction()
+
+# 读取可选的布尔字段
+function(_descriptor_bool json key default out_variable)
+  string(JSON _type ERROR_VARIABLE _error TYPE "${json}" "${key}")
+
+  if(_error)
+    set(${out_variable} ${default} PARENT_SCOPE)
+    return()
+  endif()
+
+  if(NOT _type STREQUAL "BOOLEAN")
+    _descriptor_error("\"${key}\" must be true or false")
+  endif()
+
+  string(JSON _value GET "${json}" "${key}")
+
+  if(_value)
+    set(${out_variable} 1 PARENT_SCOPE)
+  else()
+    set(${out_variable} 0 PARENT_SCOPE)
+  endif()
+endfunction()
+
+set(_name_pattern "^[A-Za-z0-9_.-]+$")
+set(_version_pattern "^[0-9]+(\\.[0-9]+)*$")
+
+_descriptor_string("${_metadata}" Name TRUE _name)
+
+if(NOT _name MATCHES "${_name_pattern}")
+  _descriptor_error("\"Name\" must only contain letters, digits, '_', '.' and '-'")
+endif()
+
+_descriptor_string("${_metadata}" Version TRUE _version)
+
+if(NOT _version MATCHES "${_version_pattern}")
+  _descriptor_error("\"Version\" must be a dotted version number, for example 1.0.0")
+endif()
+
+_descriptor_string("${_metadata}" Vendor TRUE _vendor)
+_descriptor_string("${_metadata}" Branch FALSE _branch)
+_descriptor_string("${_metadata}" Revision FALSE _revision)
+_descriptor_string("${_metadata}" Category FALSE _category)
+_descriptor_string("${_metadata}" Copyright FALSE _copyright)
+_descriptor_string("${_metadata}" Url FALSE _url)
+
+# 依赖项
+set(_dependencies "\"\"")
+
+string(JSON _type ERROR_VARIABLE _error TYPE "${_metadata}" Dependencies)
+
+if(NOT _error)
+  if(NOT _type STREQUAL "ARRAY")
+    _descriptor_error("\"Dependencies\" must be an array of objects")
+  endif()
+
+  string(JSON _length LENGTH "${_metadata}" Dependencies)
+
+  if(_length GREATER 0)
+    set(_dependencies "")
+    math(EXPR _last "${_length} - 1")
+
+    foreach(_index RANGE ${_last})
+      string(JSON _dependency_type TYPE "${_metadata}" Dependencies ${_index})
+
+      if(NOT _dependency_type STREQUAL "OBJECT")
+        _descriptor_error("\"Dependencies\" must be an array of objects")
+      endif()
+
+      string(JSON _dependency GET "${_metadata}" Dependencies ${_index})
+
+      _descriptor_string("${_dependency}" Name TRUE _dependency_name)
+      _descriptor_string("${_dependency}" Version TRUE _dependency_version)
+
+      if(NOT _dependency_name MATCHES "${_name_pattern}")
+        _descriptor_error("dependency \"${_dependency_name}\" is not a valid component name")
+      endif()
+
+      if(NOT _dependency_version MATCHES "${_version_pattern}")
+        _descriptor_error("dependency \"${_dependency_name}\" has an invalid version \"${_dependency_version}\"")
+      endif()
+
+      if(_index GREATER 0)
+        string(APPEND _dependencies " \"\\x1e\" ")
+      endif()
+
+      string(APPEND _dependencies "\"${_dependency_name}\" \"\\x1f\" \"${_dependency_version}\"")
+    endforeach()
+  endif()
+endif()
+
+# 激活条件
+set(_activation "{}")
+
+string(JSON _type ERROR_VARIABLE _error TYPE "${_metadata}" Activation)
+
+if(NOT _error)
+  if(NOT _type STREQUAL "OBJECT")
+    _descriptor_error("\"Activation\" must be an object")
+  endif()
+
+  string(JSON _activation GET "${_metadata}" Activation)
+endif()
+
+_descriptor_string_array("${_metadata}" License _license)
+_descriptor_string_array("${_metadata}" Description _description)
+_descriptor_string_array("${_activation}" Modes _activation_modes)
+_descriptor_string_array("${_activation}" Contexts _activation_contexts)
+_descriptor_string_array("${_activation}" Commands _activation_commands)
+
+# 选项，与 ComponentDescriptor::Flag 的取值保持一致
+_descriptor_bool("${_metadata}" CanBeDisabled 1 _can_be_disabled)
+_descriptor_bool("${_metadata}" ConcurrentInitialise 0 _concurrent_initialise)
+_descriptor_bool("${_metadata}" FinaliseOnExit 0 _finalise_on_exit)
+
+math(EXPR _options "${_can_be_disabled} * 1 + ${_concurrent_initialise} * 2 + ${_finalise_on_exit} * 8")
+
+# 按 EmbeddedDescriptorField 的顺序组装字段区，字段值可能含有 ';'，因此不使用 CMake 列表
+set(DESCRIPTOR_FIELDS "")
+set(_field_separator " \"\\0\" \\\n    ")
+
+foreach(_field name version branch revision vendor category copyright url)
+  _descriptor_literal("${_${_field}}" "${_field}" _literal)
+  string(APPEND DESCRIPTOR_FIELDS "${_literal}${_field_separator}")
+endforeach()
+
+foreach(_field license description dependencies activation_modes activation_contexts activation_commands)
+  string(APPEND DESCRIPTOR_FIELDS "${_${_field}}${_field_separator}")
+endforeach()
+
+string(APPEND DESCRIPTOR_FIELDS "\"${_options}\"")
+
+configure_file("${TEMPLATE_FILE}" "${OUTPUT_FILE}" @ONLY)
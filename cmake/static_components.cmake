@@ -0,0 +1,112 @@
+# 静态组件包：将选定的组件作为 Qt 静态插件（Q_IMPORT_PLUGIN）链接进 app，启动时无需扫描目录、读取 ELF 元数据和 dlopen。
+#
+# 用法（根目录 CMakeLists.txt）：
+#   configure_static_components()              # 在 add_subdirectory() 之前调用
+#   link_static_components(app)                # 在所有 add_subdirectory() 之后调用
+#
+# 组件在其 user_config.cmake 中通过以下目标属性声明静态链接所需的信息：
+#   DS_COMPONENT_PLUGIN_CLASS   Q_PLUGIN_METADATA 所在的类名（不含命名空间）
+#   DS_COMPONENT_RESOURCES      需要在启动时注册的 qrc 资源名称列表
+
+set(DS_COMPONENT_SUBPROJECTS
+    dscore
+    ws1
+    ws2)
+
+set(DS_STATIC_COMPONENTS
+    ""
+    CACHE STRING "Components linked into app as Qt static plugins, e.g. 'dscore;ws1;ws2'")
+
+# 为每个选定的组件关闭 <NAME>_BUILD_SHARED_LIBS，必须在 add_subdirectory() 之前调用
+macro(configure_static_components)
+  foreach(_static_component IN LISTS DS_STATIC_COMPONENTS)
+    if(NOT _static_component IN_LIST DS_COMPONENT_SUBPROJECTS)
+      message(FATAL_ERROR "DS_STATIC_COMPONENTS: '${_static_component}' is not a component subproject")
+    endif()
+
+    string(TOUPPER ${_static_component} _static_component_upper)
+    # 普通变量优先于子项目中的 option()（CMP0077），取消选择后自动恢复为动态库
+    set(${_static_component_upper}_BUILD_SHARED_LIBS OFF)
+  endforeach()
+
+  # dscore 被其他组件链接，静态的 dscore 不能再被动态组件各自复制一份
+  if("dscore" IN_LIST DS_STATIC_COMPONENTS)
+    foreach(_static_component IN LISTS DS_COMPONENT_SUBPROJECTS)
+      if(NOT _static_component IN_LIST DS_STATIC_COMPONENTS)
+        message(FATAL_ERROR "DS_STATIC_COMPONENTS: '${_static_component}' must be static when dscore is static")
+      endif()
+    endforeach()
+  endif()
+
+  if(DS_STATIC_COMPONENTS)
+    message(STATUS "Static components: ${DS_STATIC_COMPONENTS}")
+  endif()
+endmacro()
+
+# 链接静态组件并生成导入它们的源文件，必须在所有 add_subdirectory() 之后调用
+function(link_static_components target)
+  if(NOT DS_STATIC_COMPONENTS)
+    return()
+  endif()
+
+  set(_imports "")
+  set(_resources "")
+
+  foreach(_static_component IN LISTS DS_STATIC_COMPONENTS)
+    get_target_property(_plugin_class ${_static_component} DS_COMPONENT_PLUGIN_CLASS)
+    get_target_property(_plugin_resources ${_static_component} DS_COMPONENT_RESOURCES)
+
+    if(NOT _plugin_class)
+      message(FATAL_ERROR "Component '${_static_component}' does not set DS_COMPONENT_PLUGIN_CLASS")
+    endif()
+
+    string(APPEND _imports "Q_IMPORT_PLUGIN(${_plugin_class})\n")
+
+    if(_plugin_resources)
+      foreach(_resource IN LISTS _plugin_resources)
+        string(APPEND _resources "    Q_INIT_RESOURCE(${_resource});\n")
+      endforeach()
+    endif()
+
+    target_link_libraries(${target} PRIVATE ${_static_component})
+  endforeach()
+
+  set(_static_components_source "${CMAKE_BINARY_DIR}/${target}_static_components.cpp")
+
+  # Q_INIT_RESOURCE 不能在命名空间中使用，因此注册器定义在全局作用域；内容不变时不会重写文件
+  file(
+    CONFIGURE
+    OUTPUT
+    ${_static_components_source}
+    CONTENT
+    "// 由 cmake/static_components.cmake 生成，请勿修改
+
+#include <QtGlobal>
+#include <QtPlugin>
+
+${_imports}
+struct DsStaticComponentResources {
+  DsStaticComponentResources() {
+${_resources}  }
+};
+
+static const DsStaticComponentResources ds_static_component_resources;
+"
+    @ONLY)
+
+  target_sources(${target} PRIVATE ${_static_components_source})
+
+  # 所有组件都是静态的时候，app 不再扫描组件目录
+  set(_all_static TRUE)
+  foreach(_component IN LISTS DS_COMPONENT_SUBPROJECTS)
+    if(NOT _component IN_LIST DS_STATIC_COMPONENTS)
+      set(_all_static FALSE)
+    endif()
+  endforeach()
+
+  if(_all_static)
+    target_compile_definitions(${target} PRIVATE DS_STATIC_COMPONENTS_ONLY)
+  endif()
+
+  message(STATUS "Linked static components into ${target}: ${DS_STATIC_COMPONENTS}")
+endfunction()
@@ -13,6 +13,8 @@ constexpr auto kSplashScreenWidth = 700;
 constexpr auto kAlphaLevel = 255.0 * 0.8;
 constexpr auto kTextColour = qRgba(0xFF, 0xFF, 0xFF, kAlphaLevel);
 constexpr auto kVersionRect = QRectF(45, 123, 210, 32);
+constexpr auto kProgressHeight = 3;
+constexpr auto kProgressMessageFlags = Qt::AlignBottom | Qt::AlignLeft;
 
 sss::SplashScreen::SplashScreen() : QSplashScreen(QPixmap(), Qt::WindowStaysOnTopHint) {
   auto pixmap = QPixmap(kSplashScreenFilename);
@@ -57,7 +59,17 @@ auto sss::SplashScreen::GetInstance() -> sss::SplashScreen* {
   return (instance);
 }
 
+auto sss::SplashScreen::ShowProgress(const QString& message, int value, int maximum) -> void {
+  progress_value_ = value;
+  progress_maximum_ = maximum;
+
+  // showMessage() 会立即重绘启动画面
+  showMessage(message, kProgressMessageFlags, QColor::fromRgba(kTextColour));
+}
+
 auto sss::SplashScreen::drawContents(QPainter* painter) -> void {
+  QSplashScreen::drawContents(painter);
+
   auto font = QFont(kFontFamily, kFontSize, QFont::Weight::Bold);
   auto version_text = QString("1.0.0");
   auto text_rect = QRectF(kVersionRect.topLeft() * scale_factor_, kVersionRect.size() * scale_factor_).toRect();
@@ -76,5 +88,12 @@ auto sss::SplashScreen::drawContents(QPainter* painter) -> void {
 
   painter->drawText(kVersionRect, Qt::AlignCenter | Qt::AlignVCenter, version_text);
 
+  if (progress_maximum_ > 0) {
+    auto progress_width = width() * qBound(0, progress_value_, progress_maximum_) / progress_maximum_;
+
+    painter->fillRect(QRect(0, height() - kProgressHeight, progress_width, kProgressHeight),
+                      QColor::fromRgba(kTextColour));
+  }
+
   painter->restore();
 }
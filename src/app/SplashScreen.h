@@ -41,6 +41,17 @@ class SplashScreen : public QSplashScreen {
    */
   static auto GetInstance() -> SplashScreen*;
 
+  /**
+   * @brief           显示启动进度。
+   *
+   * @details         在启动画面底部显示消息和进度条，并立即重绘。
+   *
+   * @param[in]       message 进度消息。
+   * @param[in]       value 已完成的步骤数。
+   * @param[in]       maximum 总步骤数。
+   */
+  auto ShowProgress(const QString& message, int value, int maximum) -> void;
+
  protected:
   /**
    * @brief           绘制启动画面内容。
@@ -56,6 +67,8 @@ class SplashScreen : public QSplashScreen {
   //! @cond
 
   float scale_factor_;
+  int progress_value_ = 0;
+  int progress_maximum_ = 0;
 
   //! @endcond
 };
@@ -13,15 +13,60 @@
 #include <QStandardPaths>
 #include <QTimer>
 #include <QTranslator>
+#include <QWindow>
 #include <QtGlobal>
 #include <chrono>
+#include <cstdio>
+#include <cstdlib>
 
 #include "SplashScreen.h"
 #include "extsystem/Component.h"
 #include "extsystem/IComponentManager.h"
+#include "extsystem/StartupTrace.h"
 
 auto constexpr kSplashscreenTimeout = 3000;
 
+namespace {
+/**
+ * @brief       记录主窗口首次显示的启动跟踪跨度。
+ *
+ * @details     跨度从主窗口收到第一个 QEvent::Show 开始，到其原生窗口第一次被暴露（Expose）为止，
+ *              即窗口真正出现在屏幕上的时刻。记录后写出跟踪文件并移除自身。
+ */
+class FirstWindowShowTracer : public QObject {
+ public:
+  explicit FirstWindowShowTracer(QObject* parent) : QObject(parent) { qApp->installEventFilter(this); }
+
+  auto eventFilter(QObject* watched, QEvent* event) -> bool override {
+    if ((event->type() == QEvent::Show) && (main_window_ == nullptr)) {
+      auto* main_window = qobject_cast<QMainWindow*>(watched);
+
+      if (main_window != nullptr) {
+        main_window_ = main_window;
+        show_us_ = sss::extsystem::StartupTrace::Now();
+      }
+    } else if ((event->type() == QEvent::Expose) && (main_window_ != nullptr)) {
+      auto* window = qobject_cast<QWindow*>(watched);
+
+      if ((window != nullptr) && (window == main_window_->windowHandle()) && window->isExposed()) {
+        sss::extsystem::StartupTrace::AddSpan("First window show", "ui", show_us_,
+                                              sss::extsystem::StartupTrace::Now() - show_us_);
+        sss::extsystem::StartupTrace::Finish();
+
+        qApp->removeEventFilter(this);
+        deleteLater();
+      }
+    }
+
+    return false;
+  }
+
+ private:
+  QMainWindow* main_window_ = nullptr;
+  qint64 show_us_ = 0;
+};
+}  // namespace
+
 /**
  * 日志级别控制：
  *
@@ -31,6 +76,17 @@ auto constexpr kSplashscreenTimeout = 3000;
  *   ./executable --log-level warn     # 只显示警告和错误
  *   ./executable --log-level err    # 只显示错误信息
  *
+ * 启动跟踪：
+ *   ./executable --startup-trace startup.json
+ *   将各组件的扫描、加载、初始化等阶段耗时写入 Chrome trace 格式的 JSON 文件，
+ *   可在 chrome://tracing 或 Perfetto 中查看。
+ *
+ * 关闭方式：
+ *   默认按反向加载顺序结束并卸载所有组件。
+ *   ./executable --fast-shutdown
+ *   快速退出：只调用元数据中声明了 "FinaliseOnExit" 的组件的 FinaliseEvent，不卸载库，直接结束进程。
+ *   运行中的异步命令在退出事件循环时被取消并等待结束。
+ *
  * 日志级别说明：
  *   - trace: 最详细的跟踪信息
  *   - debug: 调试信息（开发用）
@@ -48,6 +104,8 @@ int main(int argc, char** argv) {
   // 解析命令行参数
   QStringList args = QApplication::arguments();
   spdlog::level::level_enum log_level = spdlog::level::debug;  // 默认debug级别
+  QString startup_trace_filename;
+  bool fast_shutdown = false;
 
   for (int i = 1; i < args.size(); ++i) {
     if (args[i] == "--log-level" && i + 1 < args.size()) {
@@ -65,10 +123,19 @@ int main(int argc, char** argv) {
       } else if (level_str == "critical") {
         log_level = spdlog::level::critical;
       }
-      break;
+      ++i;
+    } else if (args[i] == "--startup-trace" && i + 1 < args.size()) {
+      startup_trace_filename = args[i + 1];
+      ++i;
+    } else if (args[i] == "--fast-shutdown") {
+      fast_shutdown = true;
     }
   }
 
+  if (!startup_trace_filename.isEmpty()) {
+    sss::extsystem::StartupTrace::Start(startup_trace_filename);
+  }
+
   // 初始化spdlog日志系统
   auto file_logger = spdlog::basic_logger_mt("main", "ds.log", true);
   spdlog::set_default_logger(file_logger);
@@ -122,10 +189,29 @@ int main(int argc, char** argv) {
 
   // SPDLOG_DEBUG("Application started.");
 
+  // 与 Core::StorageFolder 相同的存储位置，用于应用程序设置和组件元数据缓存
+  QString settings_path;
+
+  if (QDir(application_dir).exists("data")) {
+    settings_path = QDir::cleanPath(application_dir.absolutePath() + "/data");
+  } else {
+    settings_path = QStandardPaths::standardLocations(QStandardPaths::GenericDataLocation).at(0) + "/" +
+                    qApp->organizationName() + "/" + qApp->applicationName();
+  }
+
+  component_loader->SetMetadataCacheFile(settings_path + "/componentCache.bin");
+
+  // 静态链接的组件（见 cmake/static_components.cmake）先于扫描到的共享库添加，同名时优先
+  component_loader->AddStaticComponents();
+
+#if !defined(DS_STATIC_COMPONENTS_ONLY)
   QStringList component_locations = QStringList() << "APPDIR" << "DS_COMPONENT_DIR";
 
   SPDLOG_INFO("Component locations: {}", component_locations.join(", ").toStdString());
 
+  // 收集所有组件目录，然后一次性并行扫描；目录顺序决定名称冲突时的优先级
+  QStringList component_folders;
+
   for (const auto& dir_name : component_locations) {
     if (QProcessEnvironment::systemEnvironment().contains(dir_name)) {
       auto dir_path = QProcessEnvironment::systemEnvironment().value(dir_name);
@@ -133,7 +219,7 @@ int main(int argc, char** argv) {
 
       SPDLOG_INFO("Found component path via {}: {}", dir_name.toStdString(), components_path.toStdString());
 
-      component_loader->AddComponents(components_path);
+      component_folders.append(components_path);
     }
   }
 
@@ -142,16 +228,13 @@ int main(int argc, char** argv) {
 
     SPDLOG_INFO("Found local component path: {}", components_path.toStdString());
 
-    component_loader->AddComponents(components_path);
+    component_folders.append(components_path);
   }
-  QString settings_path;
 
-  if (QDir(application_dir).exists("data")) {
-    settings_path = QDir::cleanPath(application_dir.absolutePath() + "/data");
-  } else {
-    settings_path = QStandardPaths::standardLocations(QStandardPaths::GenericDataLocation).at(0) + "/" +
-                    qApp->organizationName() + "/" + qApp->applicationName();
-  }
+  component_loader->AddComponents(component_folders);
+#else
+  SPDLOG_INFO("All components are linked statically, skipping component folder scan.");
+#endif
 
   QString app_settings_filename = settings_path + "/appSettings.json";
 
@@ -174,13 +257,24 @@ int main(int argc, char** argv) {
 
   SPDLOG_INFO("Starting component loading...");
 
+  if (sss::extsystem::StartupTrace::IsEnabled()) {
+    // 主窗口在组件初始化期间创建并显示，因此需要在加载组件之前开始观察
+    new FirstWindowShowTracer(&application_instance);
+  }
+
+  // 组件异步初始化期间事件循环保持运行，启动画面显示每个组件的进度
+  QObject::connect(component_loader, &sss::extsystem::ComponentLoader::InitialisationProgress, splash_screen,
+                   [splash_screen](sss::extsystem::Component* component, int initialised_count, int total_count) {
+                     splash_screen->ShowProgress(component->Name(), initialised_count, total_count);
+                   });
+
   // 生命周期管理：
   // 1. 阶段1 (核心初始化): CoreComponent (依赖根节点) 首先初始化，设置管理器。
   // 2. 阶段2 (插件初始化): 其他插件初始化，注册上下文/提供者。
   // 3. 阶段3 (完成): 所有初始化完成后，InitialisationFinishedEvent 按相反顺序运行。
   //    CoreComponent 最后运行，构建 UI 并显示窗口。
   component_loader->LoadComponents([disabled_components](sss::extsystem::Component* component) -> bool {
-    auto component_id = (component->Name() + "." + component->Vendor()).toLower();
+    const auto& component_id = component->Descriptor().Identifier();
     bool should_load = !disabled_components.contains(component_id);
 
     SPDLOG_INFO("Component {}: can_be_disabled={}, should_load={}", component_id.toStdString(),
@@ -194,6 +288,11 @@ int main(int argc, char** argv) {
 
   SPDLOG_INFO("Component loading completed.");
 
+#if !defined(DS_STATIC_COMPONENTS_ONLY)
+  // 运行时复制到组件目录中的新组件无需重新启动即可安装
+  component_loader->WatchComponentFolders(component_folders);
+#endif
+
   int exit_code;
   auto* main_window = (sss::extsystem::GetTObject<QMainWindow>());
 
@@ -220,8 +319,24 @@ int main(int argc, char** argv) {
     exit_code = 1;
   }
 
+  // 主窗口从未被暴露（例如在无显示环境中运行）时仍然写出已记录的跟踪
+  sss::extsystem::StartupTrace::Finish();
+
+  if (fast_shutdown) {
+    component_loader->SetShutdownPolicy(sss::extsystem::ComponentLoader::ShutdownPolicy::kFast);
+  }
+
   component_loader->UnloadComponents();
 
+  if (fast_shutdown) {
+    // 跳过组件、窗口和静态对象的析构以及库的卸载，需要写回数据的组件已在 FinaliseEvent 中完成
+    SPDLOG_INFO("Fast shutdown completed, exiting.");
+
+    spdlog::shutdown();
+    std::fflush(nullptr);
+    std::_Exit(exit_code);
+  }
+
   SPDLOG_DEBUG("Unloading components...");
 
   delete component_loader;
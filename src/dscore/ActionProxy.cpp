@@ -2,7 +2,25 @@
 
 #include <spdlog/spdlog.h>
 
-sss::dscore::ActionProxy::ActionProxy(QObject* parent) : QAction(parent), action_(nullptr) {}
+#include <QEvent>
+#include <QSignalBlocker>
+
+sss::dscore::ActionProxy::ActionProxy(QObject* parent) : QAction(parent), action_(nullptr) {
+  // 连接只建立一次，始终转发到当前的 action_，切换目标时不需要重新连接
+  connect(this, &QAction::triggered, this, [this](bool checked) {
+    if (action_ != nullptr) {
+      emit action_->triggered(checked);
+    }
+  });
+
+  connect(this, &QAction::toggled, this, [this](bool checked) {
+    if (action_ != nullptr) {
+      action_->setChecked(checked);
+    }
+  });
+
+  connect(this, &QAction::changed, this, &ActionProxy::syncToAction);
+}
 
 auto sss::dscore::ActionProxy::setEnabled(bool enabled) -> void {
   QAction::setEnabled(enabled);
@@ -20,6 +38,33 @@ auto sss::dscore::ActionProxy::setVisible(bool visible) -> void {
   }
 }
 
+auto sss::dscore::ActionProxy::SetState(QAction* action, bool visible, bool enabled) -> void {
+  // 不可见的 QAction 总是报告为禁用
+  auto state_changed = isVisible() != visible || isEnabled() != (visible && enabled);
+
+  if (state_changed) {
+    {
+      // 暂时阻止 changed()，避免每个属性都触发一次状态同步
+      const QSignalBlocker blocker(this);
+
+      QAction::setVisible(visible);
+      QAction::setEnabled(enabled);
+    }
+
+    // 同步到被代理的action，先同步启用状态，因为真实动作的 changed() 会把启用状态回写到代理
+    if (action_ != nullptr) {
+      if (action_->isEnabled() != enabled) action_->setEnabled(enabled);
+      if (action_->isVisible() != visible) action_->setVisible(visible);
+    }
+  }
+
+  SetActive(action);
+
+  if (state_changed) {
+    emit changed();
+  }
+}
+
 auto sss::dscore::ActionProxy::SetActive(QAction* action) -> void {
   if (action == action_) {
     return;
@@ -30,15 +75,9 @@ auto sss::dscore::ActionProxy::SetActive(QAction* action) -> void {
   action_ = action;
 
   if (action != nullptr) {
-    setMenuRole(action->menuRole());
-
     // 1. Sync Visual Properties: Real Action -> Proxy
     // 插件拥有真实的 action 并设置其图标/文本。代理必须反映这一点。
-    setIcon(action->icon());
-    setText(action->text());
-    setToolTip(action->toolTip());
-    setStatusTip(action->statusTip());
-    setCheckable(action->isCheckable());
+    syncFromAction();
 
     // 2. Sync State Properties: Proxy -> Real Action
     // ContextManager控制代理的状态。真实动作必须服从。
@@ -57,9 +96,7 @@ auto sss::dscore::ActionProxy::DisconnectAction() -> void {
     return;
   }
 
-  disconnect(this, &QAction::triggered, action_, &QAction::triggered);
-  disconnect(this, &QAction::toggled, action_, &QAction::setChecked);
-  // 断开状态同步的连接 - 不需要特定的断开，会在对象销毁时自动清理
+  action_->removeEventFilter(this);
 }
 
 auto sss::dscore::ActionProxy::ConnectAction() -> void {
@@ -67,27 +104,37 @@ auto sss::dscore::ActionProxy::ConnectAction() -> void {
     return;
   }
 
-  connect(this, &QAction::triggered, action_, &QAction::triggered);
-  connect(this, &QAction::toggled, action_, &QAction::setChecked);
+  // QAction 在发出 changed() 之前会向自身发送 QEvent::ActionChanged，事件过滤器随目标切换，不会累积连接
+  action_->installEventFilter(this);
+}
 
+auto sss::dscore::ActionProxy::eventFilter(QObject* watched, QEvent* event) -> bool {
   // 1. Real Action -> Proxy (Visuals)
-  connect(action_, &QAction::changed, [this]() {
-    if (icon().cacheKey() != action_->icon().cacheKey()) setIcon(action_->icon());
-    if (text() != action_->text()) setText(action_->text());
-    if (toolTip() != action_->toolTip()) setToolTip(action_->toolTip());
-    if (statusTip() != action_->statusTip()) setStatusTip(action_->statusTip());
-    if (isCheckable() != action_->isCheckable()) setCheckable(action_->isCheckable());
-  });
+  if (watched == action_ && event->type() == QEvent::ActionChanged) {
+    syncFromAction();
+  }
 
+  return QAction::eventFilter(watched, event);
+}
+
+auto sss::dscore::ActionProxy::syncFromAction() -> void {
+  if (menuRole() != action_->menuRole()) setMenuRole(action_->menuRole());
+  if (icon().cacheKey() != action_->icon().cacheKey()) setIcon(action_->icon());
+  if (text() != action_->text()) setText(action_->text());
+  if (toolTip() != action_->toolTip()) setToolTip(action_->toolTip());
+  if (statusTip() != action_->statusTip()) setStatusTip(action_->statusTip());
+  if (isCheckable() != action_->isCheckable()) setCheckable(action_->isCheckable());
+  if (shortcut() != action_->shortcut()) setShortcut(action_->shortcut());
+}
+
+auto sss::dscore::ActionProxy::syncToAction() -> void {
   // 2. Proxy -> Real Action (State)
   // 当代理状态改变时（通过SetContext），同步到真实动作
-  connect(this, &QAction::changed, [this]() {
-    if (action_ != nullptr) {
-      if (action_->isEnabled() != isEnabled()) action_->setEnabled(isEnabled());
-      if (action_->isVisible() != isVisible()) action_->setVisible(isVisible());
-      if (action_->isCheckable() && isCheckable() && action_->isChecked() != isChecked()) {
-        action_->setChecked(isChecked());
-      }
+  if (action_ != nullptr) {
+    if (action_->isEnabled() != isEnabled()) action_->setEnabled(isEnabled());
+    if (action_->isVisible() != isVisible()) action_->setVisible(isVisible());
+    if (action_->isCheckable() && isCheckable() && action_->isChecked() != isChecked()) {
+      action_->setChecked(isChecked());
     }
-  });
+  }
 }
@@ -9,6 +9,9 @@ namespace sss::dscore {
  *
  * @details     QAction 的代理类，允许动作通过代理，活动的 QAction 可以根据
  *              应用程序的当前上下文进行切换。
+ *
+ *              代理与信号的连接在构造时建立一次，始终转发到当前的 QAction；被代理动作的变化通过
+ *              安装在其上的事件过滤器观察。切换活动的 QAction 只移动事件过滤器，不创建新的连接。
  * @class       sss::dscore::ActionProxy ActionProxy.h <ActionProxy>
  */
 class ActionProxy : public QAction {
@@ -27,6 +30,25 @@ class ActionProxy : public QAction {
    */
   auto SetActive(QAction* action) -> void;
 
+  /**
+   * @brief       返回当前活动的 QAction。
+   *
+   * @returns     被代理的动作；没有活动动作时返回 nullptr。
+   */
+  [[nodiscard]] auto ActiveAction() const -> QAction* { return action_; }
+
+  /**
+   * @brief       一次性设置代理的可见性、启用状态和活动的 QAction。
+   *
+   * @details     与依次调用 setVisible()、setEnabled() 和 SetActive() 的结果相同，但状态只同步到
+   *              被代理的动作一次，changed() 信号也最多发出一次。
+   *
+   * @param[in]   action 要代理的动作。
+   * @param[in]   visible 是否可见。
+   * @param[in]   enabled 是否启用。
+   */
+  auto SetState(QAction* action, bool visible, bool enabled) -> void;
+
   /**
    * @brief       重写 setEnabled 以确保状态同步。
    */
@@ -48,9 +70,24 @@ class ActionProxy : public QAction {
    */
   auto DisconnectAction() -> void;
 
+  /**
+   * @brief       观察被代理动作的 QEvent::ActionChanged 事件。
+   */
+  auto eventFilter(QObject* watched, QEvent* event) -> bool override;
+
  private:
   //! @cond
 
+  /**
+   * @brief       把被代理动作的图标、文本、快捷键等外观属性同步到代理。
+   */
+  auto syncFromAction() -> void;
+
+  /**
+   * @brief       把代理的启用、可见和选中状态同步到被代理的动作。
+   */
+  auto syncToAction() -> void;
+
   QPointer<QAction> action_;
 
   //! @endcond
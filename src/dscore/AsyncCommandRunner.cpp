@@ -0,0 +1,248 @@
+#include "AsyncCommandRunner.h"
+
+#include <spdlog/spdlog.h>
+
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QProgressBar>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QToolButton>
+#include <exception>
+#include <utility>
+
+#include "dscore/CoreStrings.h"
+#include "dscore/IStatusbarManager.h"
+
+sss::dscore::CommandProgress::CommandProgress(std::shared_ptr<State> state) : state_(std::move(state)) {}
+
+auto sss::dscore::CommandProgress::SetProgress(int value, int maximum) -> void {
+  QMutexLocker locker(&state_->mutex);
+
+  state_->value = value;
+  state_->maximum = maximum;
+
+  scheduleUpdate();
+}
+
+auto sss::dscore::CommandProgress::SetMessage(const QString& message) -> void {
+  QMutexLocker locker(&state_->mutex);
+
+  state_->message = message;
+
+  scheduleUpdate();
+}
+
+auto sss::dscore::CommandProgress::IsCancelled() const -> bool { return state_->cancelled.load(); }
+
+auto sss::dscore::CommandProgress::scheduleUpdate() -> void {
+  // 已有尚未处理的更新时只修改状态，GUI 线程处理时读取最新的值
+  if (state_->update_pending || state_->runner == nullptr) {
+    return;
+  }
+
+  state_->update_pending = true;
+
+  auto* runner = state_->runner;
+
+  QMetaObject::invokeMethod(
+      runner, [runner, state = state_]() { runner->applyProgress(state); }, Qt::QueuedConnection);
+}
+
+sss::dscore::AsyncCommandRunner::AsyncCommandRunner(QString title, AsyncCommandHandler handler,
+                                                    ReentrancyPolicy policy, QThreadPool* thread_pool,
+                                                    QObject* parent)
+    : QObject(parent),
+      title_(std::move(title)),
+      handler_(std::move(handler)),
+      policy_(policy),
+      thread_pool_(thread_pool) {}
+
+sss::dscore::AsyncCommandRunner::~AsyncCommandRunner() {
+  if (state_ != nullptr) {
+    state_->cancelled.store(true);
+
+    QMutexLocker locker(&state_->mutex);
+
+    state_->runner = nullptr;
+  }
+
+  hideProgress();
+}
+
+auto sss::dscore::AsyncCommandRunner::Execute() -> void {
+  if (!IsRunning()) {
+    start();
+    return;
+  }
+
+  switch (policy_) {
+    case ReentrancyPolicy::kQueue:
+      run_again_ = true;
+      break;
+    case ReentrancyPolicy::kDrop:
+      SPDLOG_DEBUG("Command {} is already running, execution dropped", title_.toStdString());
+      break;
+    case ReentrancyPolicy::kRestart:
+      run_again_ = true;
+      state_->cancelled.store(true);
+      break;
+  }
+}
+
+auto sss::dscore::AsyncCommandRunner::Cancel() -> void {
+  run_again_ = false;
+
+  if (state_ != nullptr) {
+    state_->cancelled.store(true);
+  }
+}
+
+auto sss::dscore::AsyncCommandRunner::start() -> void {
+  auto state = std::make_shared<CommandProgress::State>();
+
+  state->runner = this;
+  state_ = state;
+
+  showProgress();
+
+  emit RunningChanged(true);
+
+  thread_pool_->start(QRunnable::create([state, handler = handler_, title = title_.toStdString()]() {
+    CommandProgress progress(state);
+
+    // 异常不能离开线程池的线程，失败的运行与正常结束一样通知 GUI 线程
+    try {
+      handler(progress);
+    } catch (const std::exception& exception) {
+      SPDLOG_ERROR("Command {} failed: {}", title, exception.what());
+    } catch (...) {
+      SPDLOG_ERROR("Command {} failed with an unknown exception", title);
+    }
+
+    QMutexLocker locker(&state->mutex);
+
+    if (state->runner != nullptr) {
+      auto* runner = state->runner;
+
+      QMetaObject::invokeMethod(runner, [runner]() { runner->finish(); }, Qt::QueuedConnection);
+    }
+  }));
+}
+
+auto sss::dscore::AsyncCommandRunner::finish() -> void {
+  auto cancelled = state_->cancelled.load();
+
+  {
+    QMutexLocker locker(&state_->mutex);
+
+    state_->runner = nullptr;
+  }
+
+  state_.reset();
+
+  emit Finished(cancelled);
+
+  // 排队或重新开始的运行紧接着开始，命令保持禁用
+  if (run_again_) {
+    run_again_ = false;
+    start();
+    return;
+  }
+
+  hideProgress();
+
+  emit RunningChanged(false);
+}
+
+auto sss::dscore::AsyncCommandRunner::applyProgress(const std::shared_ptr<CommandProgress::State>& state) -> void {
+  // 忽略已经结束的运行的更新
+  if (state != state_) {
+    return;
+  }
+
+  int value;
+  int maximum;
+  QString message;
+
+  {
+    QMutexLocker locker(&state->mutex);
+
+    value = state->value;
+    maximum = state->maximum;
+    message = state->message;
+    state->update_pending = false;
+  }
+
+  if (progress_widget_ != nullptr) {
+    progress_bar_->setRange(0, maximum);
+    progress_bar_->setValue(value);
+  }
+
+  auto* statusbar_manager = sss::dscore::IStatusbarManager::GetInstance();
+
+  if (statusbar_manager != nullptr && !message.isEmpty()) {
+    statusbar_manager->SetStatusMessage(message, 0);
+    message_shown_ = true;
+  }
+}
+
+auto sss::dscore::AsyncCommandRunner::showProgress() -> void {
+  auto* statusbar_manager = sss::dscore::IStatusbarManager::GetInstance();
+
+  if (statusbar_manager == nullptr) {
+    return;
+  }
+
+  if (progress_widget_ == nullptr) {
+    progress_widget_ = new QWidget;
+
+    auto* layout = new QHBoxLayout(progress_widget_);
+    auto* cancel_button = new QToolButton(progress_widget_);
+
+    title_label_ = new QLabel(progress_widget_);
+    progress_bar_ = new QProgressBar(progress_widget_);
+
+    layout->setContentsMargins(0, 0, 0, 0);
+    progress_bar_->setMaximumWidth(160);
+    progress_bar_->setTextVisible(false);
+    cancel_button->setText(sss::dscore::CoreStrings::Cancel());
+
+    connect(cancel_button, &QToolButton::clicked, this, &AsyncCommandRunner::Cancel);
+
+    layout->addWidget(title_label_);
+    layout->addWidget(progress_bar_);
+    layout->addWidget(cancel_button);
+
+    statusbar_manager->AddPermanentWidget(progress_widget_, 0);
+  }
+
+  title_label_->setText(title_);
+
+  // 处理函数报告进度之前显示为忙碌状态
+  progress_bar_->setRange(0, 0);
+  progress_widget_->show();
+}
+
+auto sss::dscore::AsyncCommandRunner::hideProgress() -> void {
+  auto* statusbar_manager = sss::dscore::IStatusbarManager::GetInstance();
+
+  if (progress_widget_ != nullptr) {
+    if (statusbar_manager != nullptr) {
+      statusbar_manager->RemovePermanentWidget(progress_widget_);
+    }
+
+    delete progress_widget_.data();
+  }
+
+  title_label_ = nullptr;
+  progress_bar_ = nullptr;
+
+  if (message_shown_) {
+    if (statusbar_manager != nullptr) {
+      statusbar_manager->ClearStatusMessage();
+    }
+
+    message_shown_ = false;
+  }
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <atomic>
+#include <memory>
+
+#include "dscore/CommandProgress.h"
+
+class QLabel;
+class QProgressBar;
+class QThreadPool;
+class QWidget;
+
+namespace sss::dscore {
+/**
+ * @brief       一次运行的共享状态，工作线程和 GUI 线程都持有。
+ */
+struct CommandProgress::State {
+  std::atomic<bool> cancelled{false};
+
+  // 以下成员由 mutex 保护
+  QMutex mutex;
+  int value = 0;
+  int maximum = 0;
+  QString message;
+  bool update_pending = false;
+  AsyncCommandRunner* runner = nullptr;  // 运行器销毁或运行结束后为 nullptr
+};
+
+/**
+ * @brief       AsyncCommandRunner 在线程池中运行异步命令的处理函数。
+ *
+ * @details     运行期间在状态栏中显示进度条和取消按钮，并按 ReentrancyPolicy 处理再次执行。
+ *              运行器属于 GUI 线程，所有公共函数只能在 GUI 线程中调用。
+ *
+ * @class       sss::dscore::AsyncCommandRunner AsyncCommandRunner.h <AsyncCommandRunner>
+ */
+class AsyncCommandRunner : public QObject {
+ private:
+  Q_OBJECT
+
+ public:
+  /**
+   * @brief       构造运行器。
+   *
+   * @param[in]   title 在状态栏中显示的命令名称。
+   * @param[in]   handler 处理函数。
+   * @param[in]   policy 运行时再次执行的处理方式。
+   * @param[in]   thread_pool 运行处理函数的线程池。
+   * @param[in]   parent 父对象。
+   */
+  AsyncCommandRunner(QString title, AsyncCommandHandler handler, ReentrancyPolicy policy, QThreadPool* thread_pool,
+                     QObject* parent = nullptr);
+
+  /**
+   * @brief       销毁运行器，请求取消正在进行的运行，不等待其结束。
+   */
+  ~AsyncCommandRunner() override;
+
+  /**
+   * @brief       执行命令；正在运行时按策略处理。
+   */
+  auto Execute() -> void;
+
+  /**
+   * @brief       请求取消当前运行，并丢弃排队的运行。
+   */
+  auto Cancel() -> void;
+
+  /**
+   * @brief       检查处理函数是否正在运行。
+   */
+  [[nodiscard]] auto IsRunning() const -> bool { return state_ != nullptr; }
+
+  /**
+   * @brief       设置在状态栏中显示的命令名称。
+   *
+   * @param[in]   title 命令名称。
+   */
+  auto SetTitle(const QString& title) -> void { title_ = title; }
+
+ signals:
+  /**
+   * @brief       运行开始或结束时发出。
+   *
+   * @param[in]   running 是否正在运行。
+   */
+  void RunningChanged(bool running);
+
+  /**
+   * @brief       一次运行结束时发出。
+   *
+   * @param[in]   cancelled 运行是否被取消。
+   */
+  void Finished(bool cancelled);
+
+ private:
+  //! @cond
+
+  auto start() -> void;
+  auto finish() -> void;
+  auto applyProgress(const std::shared_ptr<CommandProgress::State>& state) -> void;
+  auto showProgress() -> void;
+  auto hideProgress() -> void;
+
+  friend class CommandProgress;
+
+  QString title_;
+  AsyncCommandHandler handler_;
+  ReentrancyPolicy policy_;
+  QThreadPool* thread_pool_;
+
+  std::shared_ptr<CommandProgress::State> state_;
+  bool run_again_ = false;
+  bool message_shown_ = false;
+
+  QPointer<QWidget> progress_widget_;
+  QLabel* title_label_ = nullptr;
+  QProgressBar* progress_bar_ = nullptr;
+
+  //! @endcond
+};
+}  // namespace sss::dscore
@@ -2,70 +2,84 @@
 
 #include <spdlog/spdlog.h>
 
-#include <QSet>
-#include <algorithm>
 #include <utility>
 
 #include "ActionProxy.h"
-
-namespace {
-// 辅助函数：检查两个 ContextList 是否有任何共同元素
-bool HasIntersection(const sss::dscore::ContextList& list1, const sss::dscore::ContextList& list2) {
-  if (list1.isEmpty() || list2.isEmpty()) {
-    return false;
-  }
-  QSet<int> set1(list1.begin(), list1.end());
-  return std::any_of(list2.begin(), list2.end(), [&set1](int context_id) { return set1.contains(context_id); });
-}
-
-// 辅助函数：检查所有必需的上下文是否处于活动状态（用于启用状态）
-bool HasAllRequired(const sss::dscore::ContextList& required_contexts,
-                    const sss::dscore::ContextList& active_contexts) {
-  if (required_contexts.isEmpty()) {
-    return true;  // 如果没有要求，则启用（或由交集决定）
-  }
-  QSet<int> active_set(active_contexts.begin(), active_contexts.end());
-  return std::all_of(required_contexts.begin(), required_contexts.end(),
-                     [&active_set](int context_id) { return active_set.contains(context_id); });
-}
-}  // namespace
+#include "AsyncCommandRunner.h"
 
 namespace sss::dscore {
 
-Command::Command(QString id) : action_(new ActionProxy()), id_(std::move(id)) {}
+Command::Command(QString id)
+    : visibility_expression_(ContextExpression::Never()),
+      enabled_expression_(ContextExpression::Always()),
+      action_(new ActionProxy()),
+      id_(std::move(id)) {}
 
 Command::~Command() { delete action_; }
 
-auto Command::Action() -> QAction* { return action_; }
+auto Command::Action() -> QAction* {
+  FlushState();
+
+  return action_;
+}
 
 auto Command::RegisterAction(QAction* action, const sss::dscore::ContextList& visibility_contexts,
                              const sss::dscore::ContextList& enabled_contexts) -> void {
+  // 任一可见性上下文活动时可见，所有启用上下文都活动时启用
+  registerAction(action, visibility_contexts,
+                 sss::dscore::ContextExpression::AnyOf(sss::dscore::ContextSet(visibility_contexts)),
+                 sss::dscore::ContextExpression::AllOf(sss::dscore::ContextSet(enabled_contexts)));
+}
+
+auto Command::RegisterAction(QAction* action, const sss::dscore::ContextExpression& visibility_expression,
+                             const sss::dscore::ContextExpression& enabled_expression) -> void {
+  // 表达式引用的上下文决定要映射哪些 QActions，不引用任何上下文的表达式映射到全局上下文
+  auto action_contexts = visibility_expression.ReferencedContexts().ToList();
+
+  if (action_contexts.isEmpty()) {
+    action_contexts.append(kGlobalContext);
+  }
+
+  registerAction(action, action_contexts, visibility_expression, enabled_expression);
+}
+
+auto Command::registerAction(QAction* action, const sss::dscore::ContextList& action_contexts,
+                             const sss::dscore::ContextExpression& visibility_expression,
+                             const sss::dscore::ContextExpression& enabled_expression) -> void {
   action->setParent(this);
 
   // 注意：ActionProxy的启用/可见状态现在由Command::SetContext管理。
   // 原始 action 的状态可能被 ActionProxy 用来决定其活动状态。
   connect(action, &QAction::changed, [action, this] { action_->setEnabled(action->isEnabled()); });
 
-  // 存储此命令的可见性和启用上下文
-  visibility_contexts_ = visibility_contexts;
-  enabled_contexts_ = enabled_contexts;
+  // 存储此命令的可见性和启用条件
+  visibility_expression_ = visibility_expression;
+  enabled_expression_ = enabled_expression;
 
-  for (auto context_id : visibility_contexts) {  // 使用可见性上下文来确定要映射哪些 QActions
+  for (auto context_id : action_contexts) {
     actions_[context_id] = action;
   }
-  // 仅当此命令应该全局可见时才向 kGlobalContext 注册
-  if (visibility_contexts.contains(kGlobalContext)) {
-    actions_[kGlobalContext] = action;
+}
+
+auto Command::UnregisterAction(QAction* action) -> void {
+  for (auto action_iterator = actions_.begin(); action_iterator != actions_.end();) {
+    if (action_iterator.value() == action) {
+      action_iterator = actions_.erase(action_iterator);
+    } else {
+      ++action_iterator;
+    }
   }
 }
 
 auto Command::SetContext(const sss::dscore::ContextList& active_contexts) -> void {
-  // 基于当前活动上下文确定可见性和启用状态
-  const bool is_visible = HasIntersection(visibility_contexts_, active_contexts);
-  const bool is_enabled = HasAllRequired(enabled_contexts_, active_contexts);
+  SetContext(active_contexts, sss::dscore::ContextSet(active_contexts));
+}
 
-  action_->setVisible(is_visible);
-  action_->setEnabled(is_enabled);
+auto Command::SetContext(const sss::dscore::ContextList& active_contexts,
+                         const sss::dscore::ContextSet& active_context_set) -> void {
+  // 基于当前活动上下文确定可见性和启用状态
+  visible_ = visibility_expression_.Evaluate(active_context_set);
+  enabled_ = enabled_expression_.Evaluate(active_context_set);
 
   // 查找最具体的 QAction 设置为代理的活动状态
   QAction* specific_action = nullptr;
@@ -83,11 +97,90 @@ auto Command::SetContext(const sss::dscore::ContextList& active_contexts) -> voi
     specific_action = actions_[sss::dscore::kGlobalContext];
   }
 
-  action_->SetActive(specific_action);
+  active_action_ = specific_action;
+
+  // 不可见的 QAction 总是报告为禁用，只比较实际生效的状态
+  state_pending_ = action_->isVisible() != visible_ || action_->isEnabled() != (visible_ && effectiveEnabled()) ||
+                   action_->ActiveAction() != specific_action;
+}
+
+auto Command::FlushState() -> void {
+  if (!state_pending_) {
+    return;
+  }
+
+  state_pending_ = false;
+
+  action_->SetState(active_action_, visible_, effectiveEnabled());
+}
+
+auto Command::effectiveEnabled() const -> bool { return enabled_ && (runner_ == nullptr || !runner_->IsRunning()); }
+
+auto Command::SetAsyncHandler(sss::dscore::AsyncCommandHandler handler, sss::dscore::ReentrancyPolicy policy,
+                              QThreadPool* thread_pool) -> bool {
+  // 再次设置会创建第二个运行器和连接，同一次触发运行两个处理函数
+  if (runner_ != nullptr) {
+    SPDLOG_WARN("Command {} already has an asynchronous handler", id_.toStdString());
+    return false;
+  }
+
+  runner_ = new AsyncCommandRunner(action_->text(), std::move(handler), policy, thread_pool, this);
+
+  // 代理动作被触发时在工作线程中运行处理函数
+  connect(action_, &QAction::triggered, runner_, [this]() {
+    runner_->SetTitle(action_->text());
+    runner_->Execute();
+  });
+
+  // 运行期间禁用代理动作
+  connect(runner_, &AsyncCommandRunner::RunningChanged, this, [this]() {
+    state_pending_ = true;
+    FlushState();
+  });
+
+  connect(runner_, &AsyncCommandRunner::Finished, this, &Command::ExecutionFinished);
+
+  return true;
 }
 
-auto Command::SetActive(bool state) -> void { action_->setEnabled(state); }
+auto Command::Execute() -> void {
+  if (runner_ == nullptr) {
+    Action()->trigger();
+    return;
+  }
+
+  // 运行期间代理动作被禁用，直接交给运行器按再次执行策略处理
+  FlushState();
 
-auto Command::Active() -> bool { return action_->isEnabled(); }
+  if (!enabled_ || !visible_) {
+    return;
+  }
+
+  runner_->SetTitle(action_->text());
+  runner_->Execute();
+}
+
+auto Command::IsRunning() -> bool { return runner_ != nullptr && runner_->IsRunning(); }
+
+auto Command::Cancel() -> void {
+  if (runner_ != nullptr) {
+    runner_->Cancel();
+  }
+}
+
+auto Command::SetActive(bool state) -> void {
+  // 直接设置的状态优先于尚未应用的上下文状态
+  enabled_ = state;
+
+  FlushState();
+
+  action_->setEnabled(effectiveEnabled());
+}
+
+auto Command::Active() -> bool {
+  FlushState();
+
+  return action_->isEnabled();
+}
 
 }  // namespace sss::dscore
@@ -2,19 +2,28 @@
 
 #include <QMap>
 #include <QObject>
+#include <QPointer>
 #include <QString>
 
+#include "dscore/CommandProgress.h"
+#include "dscore/ContextExpression.h"
 #include "dscore/ICommand.h"
 #include "dscore/IContextManager.h"
 
+class QThreadPool;
+
 namespace sss::dscore {
 class ActionProxy;
+class AsyncCommandRunner;
 
 /**
  * @brief       ICommand 接口
  *
  * @details     ICommand 代表系统中一个可执行的命令，命令绑定到给定上下文的
  *              QAction，这使得命令的目标可以根据应用程序当前所在的上下文而改变。
+ *
+ *              SetContext() 只记录命令的新状态，状态在 FlushState() 时才应用到代理动作，这样一次
+ *              事件循环中的多次上下文变化只会更新一次菜单和工具栏。Action() 总是先应用待定的状态。
  */
 class Command : public sss::dscore::ICommand {
  private:
@@ -38,6 +47,8 @@ class Command : public sss::dscore::ICommand {
   /**
    * @brief       返回代理动作。
    *
+   * @details     返回前应用待定的状态。
+   *
    * @see         sss::dscore::ICommand::action
    *
    * @returns     代理动作
@@ -62,6 +73,27 @@ class Command : public sss::dscore::ICommand {
    */
   auto Active() -> bool override;
 
+  /**
+   * @brief       执行命令。
+   *
+   * @see         sss::dscore::ICommand::Execute
+   */
+  auto Execute() -> void override;
+
+  /**
+   * @brief       检查异步命令的处理函数是否正在运行。
+   *
+   * @see         sss::dscore::ICommand::IsRunning
+   */
+  auto IsRunning() -> bool override;
+
+  /**
+   * @brief       请求取消正在运行的异步命令。
+   *
+   * @see         sss::dscore::ICommand::Cancel
+   */
+  auto Cancel() -> void override;
+
  protected:
   /**
    * @brief       向给定上下文注册一个动作。
@@ -74,6 +106,41 @@ class Command : public sss::dscore::ICommand {
   auto RegisterAction(QAction* action, const sss::dscore::ContextList& visibility_contexts,
                       const sss::dscore::ContextList& enabled_contexts) -> void;
 
+  /**
+   * @brief       以上下文表达式向命令注册一个动作。
+   *
+   * @note        命令管理器成为该动作的所有者。
+   *
+   * @param[in]   action 动作。
+   * @param[in]   visibility_expression 命令可见的条件。
+   * @param[in]   enabled_expression 命令启用的条件。
+   */
+  auto RegisterAction(QAction* action, const sss::dscore::ContextExpression& visibility_expression,
+                      const sss::dscore::ContextExpression& enabled_expression) -> void;
+
+  /**
+   * @brief       返回命令可见的条件。
+   */
+  [[nodiscard]] auto VisibilityExpression() const -> const sss::dscore::ContextExpression& {
+    return visibility_expression_;
+  }
+
+  /**
+   * @brief       返回命令启用的条件。
+   */
+  [[nodiscard]] auto EnabledExpression() const -> const sss::dscore::ContextExpression& {
+    return enabled_expression_;
+  }
+
+  /**
+   * @brief       移除已注册的动作。
+   *
+   * @details     动作从所有上下文中移除，调用者负责删除该动作。
+   *
+   * @param[in]   action 要移除的动作。
+   */
+  auto UnregisterAction(QAction* action) -> void;
+
   /**
    * @brief       设置此命令的当前上下文。
    *
@@ -84,20 +151,91 @@ class Command : public sss::dscore::ICommand {
    */
   auto SetContext(const sss::dscore::ContextList& active_contexts) -> void;
 
+  /**
+   * @brief       设置此命令的当前上下文。
+   *
+   * @details     与 SetContext(const ContextList&) 相同，但使用调用方已经构造好的活动上下文集合，
+   *              供 CommandManager 在上下文变化时对所有命令共用同一个集合。
+   *
+   * @param[in]   active_contexts 当前活动上下文的列表，按激活顺序排列。
+   * @param[in]   active_context_set 当前活动上下文的集合。
+   */
+  auto SetContext(const sss::dscore::ContextList& active_contexts, const sss::dscore::ContextSet& active_context_set)
+      -> void;
+
+  /**
+   * @brief       检查 SetContext() 记录的状态是否与代理动作的当前状态不同。
+   *
+   * @returns     需要调用 FlushState() 时返回 true。
+   */
+  [[nodiscard]] auto HasPendingState() const -> bool { return state_pending_; }
+
+  /**
+   * @brief       把 SetContext() 记录的状态应用到代理动作。
+   *
+   * @details     没有待定的状态时不做任何事情。
+   */
+  auto FlushState() -> void;
+
+  /**
+   * @brief       使命令异步执行。
+   *
+   * @details     每个命令只能设置一次处理函数。
+   *
+   * @param[in]   handler 在工作线程中运行的处理函数。
+   * @param[in]   policy 运行时再次执行的处理方式。
+   * @param[in]   thread_pool 运行处理函数的线程池。
+   *
+   * @returns     设置成功返回 true；命令已经是异步命令时返回 false。
+   */
+  auto SetAsyncHandler(sss::dscore::AsyncCommandHandler handler, sss::dscore::ReentrancyPolicy policy,
+                       QThreadPool* thread_pool) -> bool;
+
+  /**
+   * @brief       检查命令是否是异步命令。
+   */
+  [[nodiscard]] auto IsAsync() const -> bool { return runner_ != nullptr; }
+
   friend class CommandManager;
   friend class RibbonBarManager;
 
  private:
+  /**
+   * @brief       注册动作并设置可见性和启用条件。
+   *
+   * @param[in]   action 动作。
+   * @param[in]   action_contexts 此动作作为最具体动作的上下文。
+   * @param[in]   visibility_expression 命令可见的条件。
+   * @param[in]   enabled_expression 命令启用的条件。
+   */
+  auto registerAction(QAction* action, const sss::dscore::ContextList& action_contexts,
+                      const sss::dscore::ContextExpression& visibility_expression,
+                      const sss::dscore::ContextExpression& enabled_expression) -> void;
+
+  /**
+   * @brief       返回代理动作应有的启用状态，异步命令运行期间为 false。
+   */
+  [[nodiscard]] auto effectiveEnabled() const -> bool;
+
   //! @cond
 
   QMap<int, QAction*> actions_;
 
-  sss::dscore::ContextList visibility_contexts_;
-  sss::dscore::ContextList enabled_contexts_;
+  sss::dscore::ContextExpression visibility_expression_;
+  sss::dscore::ContextExpression enabled_expression_;
 
   sss::dscore::ActionProxy* action_;
   QString id_;
 
+  // SetContext() 计算出的状态，由 FlushState() 应用到 action_
+  bool visible_{false};
+  bool enabled_{true};
+  QPointer<QAction> active_action_;
+  bool state_pending_{false};
+
+  // 异步命令的运行器，同步命令为 nullptr
+  sss::dscore::AsyncCommandRunner* runner_{nullptr};
+
   //! @endcond
 };
 }  // namespace sss::dscore
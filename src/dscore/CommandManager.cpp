@@ -2,9 +2,12 @@
 
 #include <spdlog/spdlog.h>
 
+#include <QCoreApplication>
+#include <QFileInfo>
 #include <QMenu>
 #include <QMenuBar>
 #include <QToolBar>
+#include <algorithm>
 
 #include "ActionContainer.h"
 #include "Command.h"
@@ -12,15 +15,45 @@
 #include "dscore/CoreConstants.h"
 #include "dscore/IContextManager.h"
 #include "dscore/ICore.h"
+#include "dscore/IThemeService.h"
+#include "extsystem/ComponentLoader.h"
+
+namespace {
+// 返回 contexts 中也在 other 中的上下文，保持原有顺序
+auto RetainedContexts(const sss::dscore::ContextList& contexts, const sss::dscore::ContextSet& other)
+    -> sss::dscore::ContextList {
+  sss::dscore::ContextList retained;
+
+  for (auto context_id : contexts) {
+    if (other.Contains(context_id)) {
+      retained.append(context_id);
+    }
+  }
+
+  return retained;
+}
+}  // namespace
 
 sss::dscore::CommandManager::CommandManager() {
   auto* context_manager = sss::dscore::IContextManager::GetInstance();
   if (context_manager != nullptr) {
     connect(context_manager, &sss::dscore::IContextManager::ContextChanged, this, &CommandManager::onContextChanged);
+
+    active_contexts_ = context_manager->GetActiveContexts();
+    active_context_set_ = context_manager->GetActiveContextSet();
+  }
+
+  if (QCoreApplication::instance() != nullptr) {
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this,
+            &CommandManager::cancelAsyncCommands);
   }
 }
 
 sss::dscore::CommandManager::~CommandManager() {
+  pending_commands_.clear();
+
+  cancelAsyncCommands();
+
   qDeleteAll(action_container_map_);
   qDeleteAll(command_map_);
 }
@@ -29,57 +62,367 @@ auto sss::dscore::CommandManager::RegisterAction(QAction* action, QString id,
                                                  const sss::dscore::ContextList& visibility_contexts,
                                                  const sss::dscore::ContextList& enabled_contexts)
     -> sss::dscore::ICommand* {
+  return registerCommand(action, id, [&](Command* command) {
+    command->RegisterAction(action, visibility_contexts, enabled_contexts);
+  });
+}
+
+auto sss::dscore::CommandManager::RegisterAction(QAction* action, QString id,
+                                                 const sss::dscore::ContextExpression& visibility_expression,
+                                                 const sss::dscore::ContextExpression& enabled_expression)
+    -> sss::dscore::ICommand* {
+  return registerCommand(action, id, [&](Command* command) {
+    command->RegisterAction(action, visibility_expression, enabled_expression);
+  });
+}
+
+auto sss::dscore::CommandManager::RegisterAction(QAction* action, sss::dscore::ICommand* command,
+                                                 const sss::dscore::ContextList& visibility_contexts,
+                                                 const sss::dscore::ContextList& enabled_contexts) -> bool {
+  auto* command_class = qobject_cast<sss::dscore::Command*>(command);
+
+  if (command_class != nullptr) {
+    command_class->RegisterAction(action, visibility_contexts, enabled_contexts);
+    indexCommand(command_class);
+    updateCommand(command_class);
+  }
+
+  return false;
+}
+
+auto sss::dscore::CommandManager::RegisterAction(QAction* action, sss::dscore::ICommand* command,
+                                                 const sss::dscore::ContextExpression& visibility_expression,
+                                                 const sss::dscore::ContextExpression& enabled_expression) -> bool {
+  auto* command_class = qobject_cast<sss::dscore::Command*>(command);
+
+  if (command_class != nullptr) {
+    command_class->RegisterAction(action, visibility_expression, enabled_expression);
+    indexCommand(command_class);
+    updateCommand(command_class);
+  }
+
+  return false;
+}
+
+auto sss::dscore::CommandManager::RegisterCommand(const sss::dscore::CommandDescriptor& descriptor) -> bool {
+  // 延迟组件可能以描述符注册其激活命令，此时命令只有占位动作
+  auto replaces_activation_stub = hasOnlyActivationStub(descriptor.id);
+
+  if (descriptor.id.isEmpty() || (command_map_.contains(descriptor.id) && !replaces_activation_stub) ||
+      command_descriptors_.contains(descriptor.id)) {
+    SPDLOG_WARN("Command descriptor {} is empty or already registered", descriptor.id.toStdString());
+    return false;
+  }
+
+  command_descriptors_.insert(descriptor.id, descriptor);
+
+  // 快捷键只有在动作存在时才生效；替换占位动作时立即创建真实动作，ComponentsActivated 才能移除占位动作
+  if (replaces_activation_stub || !descriptor.shortcut.isEmpty()) {
+    materialiseCommand(descriptor.id);
+  }
+
+  return true;
+}
+
+auto sss::dscore::CommandManager::SetAsyncHandler(sss::dscore::ICommand* command,
+                                                  sss::dscore::AsyncCommandHandler handler,
+                                                  sss::dscore::ReentrancyPolicy policy) -> bool {
+  auto* command_class = qobject_cast<sss::dscore::Command*>(command);
+
+  if (command_class == nullptr || !handler || command_map_.value(command_class->id_) != command_class) {
+    SPDLOG_WARN("Cannot make command asynchronous");
+    return false;
+  }
+
+  return command_class->SetAsyncHandler(std::move(handler), policy, &async_thread_pool_);
+}
+
+auto sss::dscore::CommandManager::ActionCount() const -> int {
+  auto count = 0;
+
+  // 注册到命令的动作是命令的子对象，代理动作由命令单独拥有
+  for (auto* command : command_map_) {
+    count += 1 + static_cast<int>(command->findChildren<QAction*>(Qt::FindDirectChildrenOnly).size());
+  }
+
+  return count;
+}
+
+auto sss::dscore::CommandManager::RegisterActivationStub(const QString& id) -> void {
+  if (command_map_.contains(id) || command_descriptors_.contains(id)) {
+    return;
+  }
+
+  auto* component_loader = sss::extsystem::GetTObject<sss::extsystem::ComponentLoader>();
+
+  if (component_loader != nullptr) {
+    connect(component_loader, &sss::extsystem::ComponentLoader::ComponentsActivated, this,
+            &CommandManager::onComponentsActivated, Qt::UniqueConnection);
+  }
+
+  auto* stub_action = new QAction(sss::dscore::constants::CommandText(id));
+
+  sss::dscore::ContextList global_context_list;
+  global_context_list << sss::dscore::kGlobalContext;
+
+  RegisterAction(stub_action, id, global_context_list, global_context_list);
+
+  activation_stubs_.insert(id, stub_action);
+
+  connect(stub_action, &QAction::triggered, this, [this, id]() { activateStub(id); });
+}
+
+void sss::dscore::CommandManager::onComponentsActivated() {
+  // 激活的组件可能注册了任何占位命令的真实动作，包括由其他触发器激活的组件
+  for (const auto& id : activation_stubs_.keys()) {
+    replaceActivationStub(id);
+  }
+}
+
+auto sss::dscore::CommandManager::activateStub(const QString& id) -> void {
+  auto* component_loader = sss::extsystem::GetTObject<sss::extsystem::ComponentLoader>();
+
+  pending_activations_.insert(id);
+
+  // 激活成功时 ComponentsActivated 已经替换了占位动作并重新触发命令
+  if (component_loader != nullptr &&
+      component_loader->ActivateTrigger(sss::extsystem::ComponentLoader::ActivationTrigger::kCommand, id)) {
+    return;
+  }
+
+  if (activation_stubs_.contains(id)) {
+    // 组件加载器正在等待时激活被推迟，完成后由 ComponentsActivated 重新触发；激活失败时保留占位动作，
+    // 下次触发时重试
+    SPDLOG_INFO("Activation for command {} is deferred or failed, keeping the activation stub", id.toStdString());
+  }
+}
+
+auto sss::dscore::CommandManager::replaceActivationStub(const QString& id) -> bool {
+  auto* stub_action = activation_stubs_.value(id);
+  auto* command = command_map_.value(id);
+
+  // 组件还没有注册真实动作时保留占位动作，否则移除后命令不再有任何动作
+  if (stub_action == nullptr || command == nullptr || hasOnlyActivationStub(id)) {
+    return false;
+  }
+
+  activation_stubs_.remove(id);
+
+  command->UnregisterAction(stub_action);
+  updateCommand(command);
+  stub_action->deleteLater();
+
+  SPDLOG_INFO("Activation stub for command {} replaced", id.toStdString());
+
+  // 代理现在指向组件注册的真实动作（如果在当前上下文中可用），重新触发以完成用户的操作
+  if (pending_activations_.remove(id)) {
+    command->Action()->trigger();
+  }
+
+  return true;
+}
+
+auto sss::dscore::CommandManager::hasOnlyActivationStub(const QString& id) const -> bool {
+  auto* stub_action = activation_stubs_.value(id);
+  auto* command = command_map_.value(id);
+
+  if (stub_action == nullptr || command == nullptr) {
+    return false;
+  }
+
+  return std::all_of(command->actions_.cbegin(), command->actions_.cend(),
+                     [stub_action](QAction* action) { return action == stub_action; });
+}
+
+auto sss::dscore::CommandManager::SetContext(int context_id) -> void {
+  Q_UNUSED(context_id)
+
+  updateCommands(true);
+}
+
+void sss::dscore::CommandManager::onContextChanged(int new_context, int previous_context) { updateCommands(false); }
+
+auto sss::dscore::CommandManager::registerCommand(QAction* action, const QString& id,
+                                                  const std::function<void(Command*)>& register_action)
+    -> sss::dscore::ICommand* {
+  // 向以描述符注册的命令添加动作时先创建命令
+  if (command_descriptors_.contains(id)) {
+    materialiseCommand(id);
+  }
+
   if (command_map_.contains(id)) {
     auto* command = command_map_[id];
 
-    command->RegisterAction(action, visibility_contexts, enabled_contexts);
-    command->SetContext(sss::dscore::IContextManager::GetInstance()->GetActiveContexts());
+    register_action(command);
+    indexCommand(command);
+    updateCommand(command);
 
     return command;
   }
 
   auto* command = new Command(id);
 
-  command->RegisterAction(action, visibility_contexts, enabled_contexts);
+  register_action(command);
+  indexCommand(command);
 
   command->Action()->setText(action->text());
 
-  command->SetContext(sss::dscore::IContextManager::GetInstance()->GetActiveContexts());
+  updateCommand(command);
 
   command_map_[id] = command;
 
   return command;
 }
 
-auto sss::dscore::CommandManager::RegisterAction(QAction* action, sss::dscore::ICommand* command,
-                                                 const sss::dscore::ContextList& visibility_contexts,
-                                                 const sss::dscore::ContextList& enabled_contexts) -> bool {
-  auto* command_class = qobject_cast<sss::dscore::Command*>(command);
+auto sss::dscore::CommandManager::materialiseCommand(const QString& id) -> sss::dscore::ICommand* {
+  auto iterator = command_descriptors_.find(id);
 
-  if (command_class != nullptr) {
-    command_class->RegisterAction(action, visibility_contexts, enabled_contexts);
-    command_class->SetContext(sss::dscore::IContextManager::GetInstance()->GetActiveContexts());
+  if (iterator == command_descriptors_.end()) {
+    return nullptr;
   }
 
-  return false;
+  const auto descriptor = iterator.value();
+
+  command_descriptors_.erase(iterator);
+
+  auto text = sss::dscore::constants::CommandText(id);
+
+  auto* action = new QAction(text != id ? text : descriptor.text);
+
+  if (!descriptor.icon.isEmpty()) {
+    auto* theme_service = sss::extsystem::GetTObject<sss::dscore::IThemeService>();
+    QFileInfo icon_file(descriptor.icon);
+
+    action->setIcon(theme_service != nullptr ? theme_service->GetIcon(icon_file.path(), icon_file.fileName())
+                                             : QIcon(descriptor.icon));
+  }
+
+  if (descriptor.handler && !descriptor.async_handler) {
+    connect(action, &QAction::triggered, action, [handler = descriptor.handler]() { handler(); });
+  }
+
+  auto* command = registerCommand(action, id, [&](Command* new_command) {
+    new_command->RegisterAction(action, descriptor.visibility_expression, descriptor.enabled_expression);
+  });
+
+  if (descriptor.async_handler) {
+    SetAsyncHandler(command, descriptor.async_handler, descriptor.reentrancy_policy);
+  }
+
+  if (!descriptor.shortcut.isEmpty()) {
+    action->setShortcut(descriptor.shortcut);
+
+    // 代理动作必须属于一个窗口，快捷键才能在命令不在任何菜单或工具栏中时生效
+    auto* main_window = sss::dscore::MainWindowInstance();
+
+    if (main_window != nullptr) {
+      main_window->addAction(command->Action());
+    }
+  }
+
+  return command;
 }
 
-auto sss::dscore::CommandManager::SetContext(int context_id) -> void { onContextChanged(context_id, -1); }
+auto sss::dscore::CommandManager::indexCommand(Command* command) -> void {
+  auto index_context = [this, command](int context_id) { context_commands_[context_id].insert(command); };
+
+  auto visibility_contexts = command->VisibilityExpression().ReferencedContexts();
 
-void sss::dscore::CommandManager::onContextChanged(int new_context, int previous_context) {
+  // 不引用任何上下文的可见性条件映射到全局上下文（见 Command::RegisterAction），全局上下文变化时同样需要更新
+  if (visibility_contexts.IsEmpty()) {
+    visibility_contexts.Insert(sss::dscore::kGlobalContext);
+  }
+
+  visibility_contexts.ForEach(index_context);
+  command->EnabledExpression().ReferencedContexts().ForEach(index_context);
+}
+
+auto sss::dscore::CommandManager::updateCommands(bool all_commands) -> void {
   auto* context_manager = sss::dscore::IContextManager::GetInstance();
   if (context_manager == nullptr) {
     return;
   }
 
   const sss::dscore::ContextList active_contexts = context_manager->GetActiveContexts();
+  const sss::dscore::ContextSet active_context_set = context_manager->GetActiveContextSet();
+
+  // 命令按活动上下文的顺序选择最具体的动作，仍然活动的上下文顺序改变时所有命令都可能受影响
+  if (!all_commands && RetainedContexts(active_contexts_, active_context_set) !=
+                           RetainedContexts(active_contexts, active_context_set_)) {
+    all_commands = true;
+  }
+
+  if (all_commands) {
+    for (auto* command : command_map_) {
+      updateCommand(command, active_contexts, active_context_set);
+    }
+  } else {
+    // 只有可见性或启用上下文包含新增或移除的上下文的命令状态会改变
+    QSet<Command*> affected_commands;
+
+    active_context_set.SymmetricDifference(active_context_set_).ForEach([&](int context_id) {
+      auto iterator = context_commands_.constFind(context_id);
+
+      if (iterator != context_commands_.constEnd()) {
+        affected_commands.unite(iterator.value());
+      }
+    });
+
+    for (auto* command : affected_commands) {
+      updateCommand(command, active_contexts, active_context_set);
+    }
+  }
+
+  active_contexts_ = active_contexts;
+  active_context_set_ = active_context_set;
+}
+
+auto sss::dscore::CommandManager::updateCommand(Command* command) -> void {
+  auto* context_manager = sss::dscore::IContextManager::GetInstance();
+
+  updateCommand(command, context_manager->GetActiveContexts(), context_manager->GetActiveContextSet());
+}
 
-  auto command_iterator = QMapIterator<QString, Command*>(command_map_);
+auto sss::dscore::CommandManager::updateCommand(Command* command, const sss::dscore::ContextList& active_contexts,
+                                                const sss::dscore::ContextSet& active_context_set) -> void {
+  command->SetContext(active_contexts, active_context_set);
 
-  while (command_iterator.hasNext()) {
-    command_iterator.next();
-    command_iterator.value()->SetContext(active_contexts);
+  if (!command->HasPendingState()) {
+    return;
   }
+
+  pending_commands_.insert(command);
+
+  if (flush_scheduled_) {
+    return;
+  }
+
+  flush_scheduled_ = true;
+
+  // 在当前事件处理完成后刷新，同一轮事件循环中的所有上下文变化合并为一次更新
+  QMetaObject::invokeMethod(this, [this]() { flushCommands(); }, Qt::QueuedConnection);
+}
+
+auto sss::dscore::CommandManager::flushCommands() -> void {
+  flush_scheduled_ = false;
+
+  // 刷新时的信号可能再次改变上下文，新的待定命令在下一轮刷新
+  QSet<Command*> pending_commands;
+
+  pending_commands.swap(pending_commands_);
+
+  for (auto* command : pending_commands) {
+    command->FlushState();
+  }
+}
+
+auto sss::dscore::CommandManager::cancelAsyncCommands() -> void {
+  // 处理函数不能在此时等待 GUI 线程
+  for (auto* command : command_map_) {
+    command->Cancel();
+  }
+
+  async_thread_pool_.waitForDone();
 }
 
 auto sss::dscore::CommandManager::CreateActionContainer(const QString& identifier, sss::dscore::ContainerType type,
@@ -218,7 +561,7 @@ auto sss::dscore::CommandManager::FindCommand(const QString& identifier) -> sss:
     return command_map_[identifier];
   }
 
-  return nullptr;
+  return materialiseCommand(identifier);
 }
 
 auto sss::dscore::CommandManager::RetranslateUi() -> void {
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <QHash>
 #include <QMap>
 #include <QObject>
+#include <QSet>
 #include <QString>
+#include <QThreadPool>
+#include <functional>
 
 #include "ActionContainer.h"
 #include "dscore/ICommandManager.h"
@@ -14,6 +18,15 @@ class Command;
  * @brief       CommandManager 类负责创建命令并在应用程序上下文更改时更新它们。
  *
  * @details     它提供了创建菜单和定位命令的方法。
+ *
+ *              CommandManager 维护从上下文到命令的倒排索引：上下文变化时只重新计算可见性或启用上下文
+ *              包含新增或移除的上下文的命令。
+ *
+ *              命令的新状态不会立即应用到 QAction，而是记录下来，在下一次事件循环时对状态确实改变的命令
+ *              统一刷新一次，避免一次模式切换中菜单和工具栏被反复更新。
+ *
+ *              以 CommandDescriptor 注册的命令只保存描述符，直到第一次被查找、放入容器或绑定快捷键时
+ *              才创建 Command、QAction 和 ActionProxy。
  * @class       sss::dscore::CommandManager CommandManager.h <CommandManager>
  */
 class CommandManager : public sss::dscore::ICommandManager {
@@ -36,10 +49,41 @@ class CommandManager : public sss::dscore::ICommandManager {
   auto RegisterAction(QAction* action, QString id, const sss::dscore::ContextList& visibility_contexts,
                       const sss::dscore::ContextList& enabled_contexts) -> sss::dscore::ICommand* override;
 
+  auto RegisterAction(QAction* action, QString id, const sss::dscore::ContextExpression& visibility_expression,
+                      const sss::dscore::ContextExpression& enabled_expression) -> sss::dscore::ICommand* override;
+
   auto RegisterAction(QAction* action, sss::dscore::ICommand* command,
                       const sss::dscore::ContextList& visibility_contexts,
                       const sss::dscore::ContextList& enabled_contexts) -> bool override;
 
+  auto RegisterAction(QAction* action, sss::dscore::ICommand* command,
+                      const sss::dscore::ContextExpression& visibility_expression,
+                      const sss::dscore::ContextExpression& enabled_expression) -> bool override;
+
+  auto RegisterCommand(const sss::dscore::CommandDescriptor& descriptor) -> bool override;
+
+  auto SetAsyncHandler(sss::dscore::ICommand* command, sss::dscore::AsyncCommandHandler handler,
+                       sss::dscore::ReentrancyPolicy policy) -> bool override;
+
+  /**
+   * @brief       返回已创建的命令数量，不包括尚未创建的描述符。
+   *
+   * @returns     已创建的命令数量。
+   */
+  [[nodiscard]] auto MaterialisedCommandCount() const -> int { return command_map_.size(); }
+
+  /**
+   * @brief       返回已创建的命令拥有的 QAction 数量，包括每个命令的代理动作。
+   *
+   * @returns     QAction 数量。
+   */
+  [[nodiscard]] auto ActionCount() const -> int;
+
+  /**
+   * @brief       按当前活动上下文重新计算所有命令。
+   *
+   * @param[in]   context_id 未使用，活动上下文始终从 IContextManager 读取。
+   */
   auto SetContext(int context_id) -> void override;
 
   auto CreateActionContainer(const QString& identifier, sss::dscore::ContainerType type,
@@ -51,20 +95,152 @@ class CommandManager : public sss::dscore::ICommandManager {
 
   auto RetranslateUi() -> void override;
 
+  /**
+   * @brief       为延迟组件声明的命令注册占位命令。
+   *
+   * @details     占位命令使菜单和工具栏可以在组件加载之前引用该命令。占位动作被触发时激活
+   *              声明该命令的组件；组件注册真实动作（或描述符）后，在 ComponentsActivated 时移除占位动作
+   *              并重新触发命令。激活被推迟或失败时保留占位动作，推迟的激活完成后同样重新触发，失败时
+   *              下次触发重试。如果命令已存在则不做任何事情。
+   *
+   * @param[in]   id 命令标识符。
+   */
+  auto RegisterActivationStub(const QString& id) -> void;
+
  private slots:
   void onContextChanged(int new_context, int previous_context);
 
+  /**
+   * @brief       延迟组件激活后替换已有真实动作的占位命令。
+   */
+  void onComponentsActivated();
+
  private:  // NOLINT
   auto createMenu(const QString& identifier, IActionContainer* parent_container, int order)
       -> sss::dscore::IActionContainer*;
   auto createToolBar(const QString& identifier, int order) -> sss::dscore::IActionContainer*;
 
+  /**
+   * @brief       查找或创建命令并向其注册动作。
+   *
+   * @param[in]   action 动作。
+   * @param[in]   id 命令标识符。
+   * @param[in]   register_action 向命令注册动作的函数。
+   *
+   * @returns     命令。
+   */
+  auto registerCommand(QAction* action, const QString& id, const std::function<void(Command*)>& register_action)
+      -> sss::dscore::ICommand*;
+
+  /**
+   * @brief       从描述符创建命令。
+   *
+   * @details     创建动作并注册到命令，然后移除描述符。
+   *
+   * @param[in]   id 命令标识符。
+   *
+   * @returns     命令；没有该描述符时返回 nullptr。
+   */
+  auto materialiseCommand(const QString& id) -> sss::dscore::ICommand*;
+
+  /**
+   * @brief       激活声明了占位命令的组件。
+   *
+   * @param[in]   id 命令标识符。
+   */
+  auto activateStub(const QString& id) -> void;
+
+  /**
+   * @brief       命令已有真实动作时移除其占位动作。
+   *
+   * @details     如果用户触发过占位动作，移除后重新触发命令。
+   *
+   * @param[in]   id 命令标识符。
+   *
+   * @returns     占位动作被移除返回 true；否则返回 false。
+   */
+  auto replaceActivationStub(const QString& id) -> bool;
+
+  /**
+   * @brief       检查命令是否只有占位动作。
+   *
+   * @param[in]   id 命令标识符。
+   *
+   * @returns     命令有占位动作且没有其他动作时返回 true；否则返回 false。
+   */
+  auto hasOnlyActivationStub(const QString& id) const -> bool;
+
+  /**
+   * @brief       把命令加入其可见性和启用条件所引用的上下文的倒排索引。
+   *
+   * @param[in]   command 命令。
+   */
+  auto indexCommand(Command* command) -> void;
+
+  /**
+   * @brief       按当前活动上下文更新命令。
+   *
+   * @param[in]   all_commands 为 true 时重新计算所有命令；否则只重新计算受上次更新以来新增或移除的
+   *              上下文影响的命令。
+   */
+  auto updateCommands(bool all_commands) -> void;
+
+  /**
+   * @brief       按 IContextManager 当前的活动上下文计算命令的状态，状态改变时安排刷新。
+   *
+   * @param[in]   command 命令。
+   */
+  auto updateCommand(Command* command) -> void;
+
+  /**
+   * @brief       按活动上下文计算命令的状态，状态改变时安排刷新。
+   *
+   * @param[in]   command 命令。
+   * @param[in]   active_contexts 当前活动上下文的列表，按激活顺序排列。
+   * @param[in]   active_context_set 当前活动上下文的集合。
+   */
+  auto updateCommand(Command* command, const sss::dscore::ContextList& active_contexts,
+                     const sss::dscore::ContextSet& active_context_set) -> void;
+
+  /**
+   * @brief       把所有待定的命令状态应用到 QAction。
+   */
+  auto flushCommands() -> void;
+
+  /**
+   * @brief       请求取消所有异步命令并等待处理函数返回。
+   *
+   * @details     应用程序退出事件循环时调用，快速关闭直接结束进程前处理函数已经返回。
+   */
+  auto cancelAsyncCommands() -> void;
+
  private:  // NOLINT
   //! @cond
 
   QMap<QString, Command*> command_map_;
+
+  // 尚未创建命令的描述符
+  QHash<QString, sss::dscore::CommandDescriptor> command_descriptors_;
+
+  // 延迟组件声明的命令的占位动作，以及被触发后尚未完成激活的命令
+  QHash<QString, QAction*> activation_stubs_;
+  QSet<QString> pending_activations_;
+
+  // 运行异步命令处理函数的线程池
+  QThreadPool async_thread_pool_;
   QMap<QString, sss::dscore::ActionContainer*> action_container_map_;
 
+  // 上下文到引用它的命令的倒排索引
+  QHash<int, QSet<Command*>> context_commands_;
+
+  // 上次更新命令时的活动上下文
+  sss::dscore::ContextList active_contexts_;
+  sss::dscore::ContextSet active_context_set_;
+
+  // 状态尚未应用到 QAction 的命令
+  QSet<Command*> pending_commands_;
+  bool flush_scheduled_ = false;
+
   //! @endcond
 };
 }  // namespace sss::dscore
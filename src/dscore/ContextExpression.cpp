@@ -0,0 +1,310 @@
+#include "dscore/ContextExpression.h"
+
+#include <spdlog/spdlog.h>
+
+#include "dscore/IContextManager.h"
+
+namespace sss::dscore {
+/**
+ * @brief       ContextExpressionCompiler 用递归下降把表达式文本编译为后缀字节码。
+ */
+class ContextExpressionCompiler {
+ public:
+  ContextExpressionCompiler(const QString& expression, IContextManager* context_manager)
+      : expression_(expression), context_manager_(context_manager) {}
+
+  auto Compile(ContextExpression& result, QString& error) -> bool {
+    result_ = &result;
+
+    skipSpaces();
+
+    if (position_ == expression_.size()) {
+      error = "empty expression";
+      return false;
+    }
+
+    if (!parseOr(error)) {
+      return false;
+    }
+
+    skipSpaces();
+
+    if (position_ != expression_.size()) {
+      error = QString("unexpected '%1' at position %2").arg(expression_.at(position_)).arg(position_);
+      return false;
+    }
+
+    if (maximum_depth_ > ContextExpression::kMaximumDepth) {
+      error = QString("expression is nested deeper than %1 levels").arg(ContextExpression::kMaximumDepth);
+      return false;
+    }
+
+    return true;
+  }
+
+ private:
+  static auto isNameCharacter(QChar character) -> bool {
+    return character.isLetterOrNumber() || character == '_' || character == '.' || character == '-' ||
+           character == ':';
+  }
+
+  auto skipSpaces() -> void {
+    while (position_ < expression_.size() && expression_.at(position_).isSpace()) {
+      position_++;
+    }
+  }
+
+  auto accept(const QString& token) -> bool {
+    skipSpaces();
+
+    if (expression_.midRef(position_, token.size()) == token) {
+      position_ += token.size();
+      return true;
+    }
+
+    return false;
+  }
+
+  auto write(ContextExpression::OpCode op_code, int context_id = 0) -> void {
+    result_->bytecode_.append({op_code, context_id});
+
+    if (op_code == ContextExpression::OpCode::kContext) {
+      depth_++;
+      maximum_depth_ = qMax(maximum_depth_, depth_);
+    } else if (op_code != ContextExpression::OpCode::kNot) {
+      depth_--;
+    }
+  }
+
+  // or := and ('||' and)*
+  auto parseOr(QString& error) -> bool {
+    if (!parseAnd(error)) {
+      return false;
+    }
+
+    while (accept("||")) {
+      if (!parseAnd(error)) {
+        return false;
+      }
+
+      write(ContextExpression::OpCode::kOr);
+    }
+
+    return true;
+  }
+
+  // and := unary ('&&' unary)*
+  auto parseAnd(QString& error) -> bool {
+    if (!parseUnary(error)) {
+      return false;
+    }
+
+    while (accept("&&")) {
+      if (!parseUnary(error)) {
+        return false;
+      }
+
+      write(ContextExpression::OpCode::kAnd);
+    }
+
+    return true;
+  }
+
+  // unary := '!' unary | '(' or ')' | name，嵌套层数超过 kMaximumDepth 时在递归中途失败
+  auto parseUnary(QString& error) -> bool {
+    if (nesting_ == ContextExpression::kMaximumDepth) {
+      error = QString("expression is nested deeper than %1 levels").arg(ContextExpression::kMaximumDepth);
+      return false;
+    }
+
+    nesting_++;
+
+    auto parsed = parseOperand(error);
+
+    nesting_--;
+
+    return parsed;
+  }
+
+  auto parseOperand(QString& error) -> bool {
+    if (accept("!")) {
+      if (!parseUnary(error)) {
+        return false;
+      }
+
+      write(ContextExpression::OpCode::kNot);
+
+      return true;
+    }
+
+    if (accept("(")) {
+      if (!parseOr(error)) {
+        return false;
+      }
+
+      if (!accept(")")) {
+        error = QString("expected ')' at position %1").arg(position_);
+        return false;
+      }
+
+      return true;
+    }
+
+    auto start = position_;
+
+    while (position_ < expression_.size() && isNameCharacter(expression_.at(position_))) {
+      position_++;
+    }
+
+    if (position_ == start) {
+      error = position_ < expression_.size()
+                  ? QString("unexpected '%1' at position %2").arg(expression_.at(position_)).arg(position_)
+                  : QString("expected a context name at the end of the expression");
+      return false;
+    }
+
+    auto name = expression_.mid(start, position_ - start);
+    auto context_id = context_manager_->Context(name);
+
+    if (context_id == kGlobalContext) {
+      // 上下文可能由尚未加载的延迟组件注册，先注册名称使表达式在组件加载后生效
+      SPDLOG_WARN("Context expression \"{}\" refers to unregistered context \"{}\"", expression_.toStdString(),
+                  name.toStdString());
+
+      context_id = context_manager_->RegisterContext(name);
+    }
+
+    result_->referenced_contexts_.Insert(context_id);
+
+    write(ContextExpression::OpCode::kContext, context_id);
+
+    return true;
+  }
+
+  const QString& expression_;
+  IContextManager* context_manager_;
+  ContextExpression* result_ = nullptr;
+  int position_ = 0;
+  int depth_ = 0;
+  int maximum_depth_ = 0;
+  int nesting_ = 0;
+};
+}  // namespace sss::dscore
+
+sss::dscore::ContextExpression::ContextExpression(Kind kind, bool constant) : kind_(kind), constant_(constant) {}
+
+auto sss::dscore::ContextExpression::Compile(const QString& expression, IContextManager* context_manager,
+                                             QString* error) -> ContextExpression {
+  ContextExpression result(Kind::kBytecode, false);
+  QString compile_error;
+
+  if (context_manager == nullptr) {
+    compile_error = "no context manager to resolve context names";
+  } else {
+    ContextExpressionCompiler compiler(expression, context_manager);
+
+    compiler.Compile(result, compile_error);
+  }
+
+  if (error != nullptr) {
+    *error = compile_error;
+  }
+
+  if (!compile_error.isEmpty()) {
+    SPDLOG_WARN("Invalid context expression \"{}\": {}", expression.toStdString(), compile_error.toStdString());
+
+    result = Never();
+    result.valid_ = false;
+
+    return result;
+  }
+
+  // 只由 || 或只由 && 连接的上下文可以用一次位运算求值
+
+  auto has_not = false;
+  auto has_and = false;
+  auto has_or = false;
+
+  for (const auto& instruction : result.bytecode_) {
+    has_not |= instruction.op_code == OpCode::kNot;
+    has_and |= instruction.op_code == OpCode::kAnd;
+    has_or |= instruction.op_code == OpCode::kOr;
+  }
+
+  if (!has_not && !has_and) {
+    result.kind_ = Kind::kAnyOf;
+    result.bytecode_.clear();
+  } else if (!has_not && !has_or) {
+    result.kind_ = Kind::kAllOf;
+    result.bytecode_.clear();
+  } else {
+    result.bytecode_.squeeze();
+  }
+
+  return result;
+}
+
+auto sss::dscore::ContextExpression::Compile(const QString& expression) -> ContextExpression {
+  return Compile(expression, IContextManager::GetInstance());
+}
+
+auto sss::dscore::ContextExpression::Always() -> ContextExpression { return {Kind::kConstant, true}; }
+
+auto sss::dscore::ContextExpression::Never() -> ContextExpression { return {Kind::kConstant, false}; }
+
+auto sss::dscore::ContextExpression::AnyOf(const ContextSet& contexts) -> ContextExpression {
+  ContextExpression result(Kind::kAnyOf, false);
+
+  result.referenced_contexts_ = contexts;
+
+  return result;
+}
+
+auto sss::dscore::ContextExpression::AllOf(const ContextSet& contexts) -> ContextExpression {
+  ContextExpression result(Kind::kAllOf, false);
+
+  result.referenced_contexts_ = contexts;
+
+  return result;
+}
+
+auto sss::dscore::ContextExpression::Evaluate(const ContextSet& active_contexts) const -> bool {
+  switch (kind_) {
+    case Kind::kConstant:
+      return constant_;
+    case Kind::kAnyOf:
+      return referenced_contexts_.Intersects(active_contexts);
+    case Kind::kAllOf:
+      return referenced_contexts_.IsSubsetOf(active_contexts);
+    case Kind::kBytecode:
+      break;
+  }
+
+  // 栈顶是最低位
+  quint64 stack = 0;
+
+  for (const auto& instruction : bytecode_) {
+    switch (instruction.op_code) {
+      case OpCode::kContext:
+        stack = (stack << 1) | (active_contexts.Contains(instruction.context_id) ? 1 : 0);
+        break;
+      case OpCode::kNot:
+        stack ^= 1;
+        break;
+      case OpCode::kAnd: {
+        auto top = stack & 1;
+        stack >>= 1;
+        stack &= ~quint64(1) | top;
+        break;
+      }
+      case OpCode::kOr: {
+        auto top = stack & 1;
+        stack >>= 1;
+        stack |= top;
+        break;
+      }
+    }
+  }
+
+  return (stack & 1) != 0;
+}
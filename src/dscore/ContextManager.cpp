@@ -2,18 +2,28 @@
 
 #include <spdlog/spdlog.h>
 
-sss::dscore::ContextManager::ContextManager() : next_context_id_(1) { active_contexts_.append(kGlobalContext); }
+#include "extsystem/ComponentLoader.h"
+
+sss::dscore::ContextManager::ContextManager() : next_context_id_(1) {
+  qRegisterMetaType<sss::dscore::ContextSet>();
+
+  active_contexts_.append(kGlobalContext);
+  active_context_set_.Insert(kGlobalContext);
+  published_contexts_ = active_contexts_;
+  published_context_set_ = active_context_set_;
+}
 
 auto sss::dscore::ContextManager::RegisterContext(QString context_identifier) -> int {
   if (context_ids_.contains(context_identifier)) {
     return context_ids_[context_identifier];
   }
   context_ids_[context_identifier] = next_context_id_;
+  context_names_[next_context_id_] = context_identifier;
   return next_context_id_++;
 }
 
 auto sss::dscore::ContextManager::SetContext(int context_identifier) -> int {
-  int old_primary_context = Context();
+  activateContextTrigger(context_identifier);
 
   // SetContext 意味着对当前模式进行硬重置
   current_mode_context_id_ = context_identifier;
@@ -21,10 +31,13 @@ auto sss::dscore::ContextManager::SetContext(int context_identifier) -> int {
 
   active_contexts_.clear();
   active_contexts_.append(kGlobalContext);
+  active_context_set_.Clear();
+  active_context_set_.Insert(kGlobalContext);
   if (context_identifier != kGlobalContext) {
     active_contexts_.append(context_identifier);
+    active_context_set_.Insert(context_identifier);
   }
-  Q_EMIT ContextChanged(context_identifier, old_primary_context);
+  publishChange();
   return 0;
 }
 
@@ -33,12 +46,15 @@ auto sss::dscore::ContextManager::AddActiveContext(int context_id) -> void {
     SPDLOG_DEBUG("AddActiveContext: ignoring kGlobalContext");
     return;
   }
-  if (active_contexts_.contains(context_id)) {
+  if (active_context_set_.Contains(context_id)) {
     SPDLOG_DEBUG("AddActiveContext: context {} already active", context_id);
     return;
   }
-  int old_primary_context = Context();
+
+  activateContextTrigger(context_id);
+
   active_contexts_.append(context_id);
+  active_context_set_.Insert(context_id);
 
   // 与存储同步：如果我们在某个模式下，跟踪此子上下文
   if (current_mode_context_id_ != kGlobalContext && context_id != current_mode_context_id_) {
@@ -47,7 +63,7 @@ auto sss::dscore::ContextManager::AddActiveContext(int context_id) -> void {
 
   SPDLOG_DEBUG("AddActiveContext: added context {}, new primary: {}, active_contexts size: {}", context_id, Context(),
               active_contexts_.size());
-  Q_EMIT ContextChanged(Context(), old_primary_context);
+  publishChange();
 }
 
 auto sss::dscore::ContextManager::RemoveActiveContext(int context_id) -> void {
@@ -55,12 +71,12 @@ auto sss::dscore::ContextManager::RemoveActiveContext(int context_id) -> void {
     SPDLOG_DEBUG("RemoveActiveContext: ignoring kGlobalContext");
     return;
   }
-  if (!active_contexts_.contains(context_id)) {
+  if (!active_context_set_.Contains(context_id)) {
     SPDLOG_DEBUG("RemoveActiveContext: context {} not active", context_id);
     return;
   }
-  int old_primary_context = Context();
   active_contexts_.removeAll(context_id);
+  active_context_set_.Remove(context_id);
 
   // 与存储同步
   if (current_mode_context_id_ != kGlobalContext) {
@@ -69,7 +85,7 @@ auto sss::dscore::ContextManager::RemoveActiveContext(int context_id) -> void {
 
   SPDLOG_DEBUG("RemoveActiveContext: removed context {}, new primary: {}, active_contexts size: {}", context_id,
               Context(), active_contexts_.size());
-  Q_EMIT ContextChanged(Context(), old_primary_context);
+  publishChange();
 }
 
 auto sss::dscore::ContextManager::ActivateMode(int mode_context_id) -> void {
@@ -77,6 +93,8 @@ auto sss::dscore::ContextManager::ActivateMode(int mode_context_id) -> void {
     return;
   }
 
+  activateContextTrigger(mode_context_id);
+
   // 1. 为旧模式保存当前子上下文
   // 我们过滤掉全局上下文和旧的模式上下文本身
   QSet<int> current_subs;
@@ -87,29 +105,31 @@ auto sss::dscore::ContextManager::ActivateMode(int mode_context_id) -> void {
   }
   mode_sub_contexts_storage_[current_mode_context_id_] = current_subs;
 
-  int old_primary_context = Context();
-
   // 2. 切换模式
   current_mode_context_id_ = mode_context_id;
 
   // 3. 恢复新模式上下文
   active_contexts_.clear();
   active_contexts_.append(kGlobalContext);
+  active_context_set_.Clear();
+  active_context_set_.Insert(kGlobalContext);
   if (mode_context_id != kGlobalContext) {
     active_contexts_.append(mode_context_id);
+    active_context_set_.Insert(mode_context_id);
   }
 
   // 如果子上下文存在，则恢复它们
   if (mode_sub_contexts_storage_.contains(mode_context_id)) {
     for (int sub_ctx : mode_sub_contexts_storage_[mode_context_id]) {
-      if (!active_contexts_.contains(sub_ctx)) {
+      if (!active_context_set_.Contains(sub_ctx)) {
         active_contexts_.append(sub_ctx);
+        active_context_set_.Insert(sub_ctx);
       }
     }
   }
 
   SPDLOG_DEBUG("ActivateMode: switched to context {}, active count: {}", mode_context_id, active_contexts_.size());
-  Q_EMIT ContextChanged(Context(), old_primary_context);
+  publishChange();
 }
 
 auto sss::dscore::ContextManager::Context() -> int {
@@ -122,9 +142,66 @@ auto sss::dscore::ContextManager::Context() -> int {
 
 auto sss::dscore::ContextManager::GetActiveContexts() const -> sss::dscore::ContextList { return active_contexts_; }
 
+auto sss::dscore::ContextManager::GetActiveContextSet() const -> sss::dscore::ContextSet {
+  return active_context_set_;
+}
+
 auto sss::dscore::ContextManager::Context(QString context_name) -> int {
   if (context_ids_.contains(context_name)) {
     return context_ids_[context_name];
   }
   return 0;
 }
+
+auto sss::dscore::ContextManager::BeginTransaction() -> void { transaction_depth_++; }
+
+auto sss::dscore::ContextManager::CommitTransaction() -> void {
+  if (transaction_depth_ == 0) {
+    SPDLOG_WARN("CommitTransaction: no transaction in progress");
+    return;
+  }
+
+  if (--transaction_depth_ > 0 || !transaction_changed_) {
+    return;
+  }
+
+  transaction_changed_ = false;
+
+  // 事务中的变化相互抵消时不发布；只改变了顺序时仍然发布，命令按活动上下文的顺序选择动作
+  if (active_contexts_ == published_contexts_) {
+    return;
+  }
+
+  publishChange();
+}
+
+auto sss::dscore::ContextManager::publishChange() -> void {
+  if (transaction_depth_ > 0) {
+    transaction_changed_ = true;
+    return;
+  }
+
+  auto added_contexts = active_context_set_.Difference(published_context_set_);
+  auto removed_contexts = published_context_set_.Difference(active_context_set_);
+  auto previous_primary_context = published_primary_context_;
+
+  published_contexts_ = active_contexts_;
+  published_context_set_ = active_context_set_;
+  published_primary_context_ = Context();
+
+  Q_EMIT ContextChanged(published_primary_context_, previous_primary_context);
+  Q_EMIT ActiveContextsChanged(added_contexts, removed_contexts);
+}
+
+auto sss::dscore::ContextManager::activateContextTrigger(int context_id) -> void {
+  if (context_id == kGlobalContext || !context_names_.contains(context_id)) {
+    return;
+  }
+
+  auto* component_loader = sss::extsystem::GetTObject<sss::extsystem::ComponentLoader>();
+
+  if (component_loader != nullptr) {
+    component_loader->ActivateTrigger(sss::extsystem::ComponentLoader::ActivationTrigger::kContext,
+                                      context_names_[context_id]);
+  }
+}
@@ -53,6 +53,16 @@ class ContextManager : public sss::dscore::IContextManager {
    */
   auto ActivateMode(int mode_context_id) -> void override;
 
+  /**
+   * @copydoc IContextManager::BeginTransaction
+   */
+  auto BeginTransaction() -> void override;
+
+  /**
+   * @copydoc IContextManager::CommitTransaction
+   */
+  auto CommitTransaction() -> void override;
+
   /**
    * @copydoc IContextManager::Context
    */
@@ -63,22 +73,54 @@ class ContextManager : public sss::dscore::IContextManager {
    */
   [[nodiscard]] auto GetActiveContexts() const -> ContextList override;
 
+  /**
+   * @copydoc IContextManager::GetActiveContextSet
+   */
+  [[nodiscard]] auto GetActiveContextSet() const -> ContextSet override;
+
   /**
    * @copydoc IContextManager::Context(QString)
    */
   auto Context(QString context_name) -> int override;
 
  private:
+  /**
+   * @brief       激活以给定上下文为触发器的延迟组件。
+   *
+   * @details     在上下文变为活动状态之前调用，使延迟组件有机会在 ContextChanged 信号发出前
+   *              注册其命令和上下文。
+   *
+   * @param[in]   context_id 即将变为活动状态的上下文。
+   */
+  auto activateContextTrigger(int context_id) -> void;
+
+  /**
+   * @brief       发布活动上下文的变化。
+   *
+   * @details     在事务中只记录有变化，由最外层的 CommitTransaction() 发布；否则发出 ContextChanged 和
+   *              ActiveContextsChanged，携带自上次发布以来的主上下文和增减的上下文。
+   */
+  auto publishChange() -> void;
+
   //! @cond
 
   QList<int> active_contexts_;
+  ContextSet active_context_set_;
   int next_context_id_;
   QMap<QString, int> context_ids_;
+  QMap<int, QString> context_names_;
 
   // 层次管理
   int current_mode_context_id_{0};
   QMap<int, QSet<int>> mode_sub_contexts_storage_;
 
+  // 事务
+  int transaction_depth_{0};
+  bool transaction_changed_{false};
+  QList<int> published_contexts_;
+  ContextSet published_context_set_;
+  int published_primary_context_{kGlobalContext};
+
   //! @endcond
 };
 }  // namespace sss::dscore
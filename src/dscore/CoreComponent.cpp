@@ -16,6 +16,7 @@
 #include "dscore/IModeManager.h"
 #include "dscore/IStatusbarManager.h"
 #include "dscore/IStatusbarProvider.h"
+#include "extsystem/ComponentLoader.h"
 
 CoreComponent::CoreComponent() = default;
 
@@ -90,6 +91,13 @@ auto CoreComponent::InitialisationFinishedEvent() -> void {
     menu_and_toolbar_manager_ = std::make_unique<sss::dscore::MenuAndToolbarManager>();
     menu_and_toolbar_manager_->Build();
 
+    // 延迟组件激活后增量构建其贡献的命令、菜单和工具栏
+    auto* component_loader = sss::extsystem::GetTObject<sss::extsystem::ComponentLoader>();
+    if (component_loader != nullptr) {
+      QObject::connect(component_loader, &sss::extsystem::ComponentLoader::ComponentsActivated,
+                       menu_and_toolbar_manager_.get(), [this]() { menu_and_toolbar_manager_->Build(); });
+    }
+
     // 处理状态栏服务提供者（第三阶段）
     auto* statusbar_manager = sss::extsystem::GetTObject<sss::dscore::IStatusbarManager>();
     if (statusbar_manager != nullptr) {
@@ -15,14 +15,13 @@
 
 namespace sss::dscore {
 
-CoreUIProvider::CoreUIProvider(QObject* parent) : QObject(parent) {}
+CoreUIProvider::CoreUIProvider(QObject* parent)
+    : QObject(parent),
+      theme_service_([this](sss::dscore::IThemeService* theme_service) { themeServiceAdded(theme_service); }) {}
 
 CoreUIProvider::~CoreUIProvider() = default;
 
 void CoreUIProvider::RegisterCommands(sss::dscore::ICommandManager* command_manager) {
-  auto* lang_service = sss::extsystem::GetTObject<sss::dscore::ILanguageService>();
-  auto* theme_service = sss::extsystem::GetTObject<sss::dscore::IThemeService>();
-
   // --- 关于 ---
   auto* about_action = new QAction(sss::dscore::constants::CommandText(sss::dscore::constants::commands::kAbout));
   about_action->setMenuRole(QAction::ApplicationSpecificRole);
@@ -38,59 +37,59 @@ void CoreUIProvider::RegisterCommands(sss::dscore::ICommandManager* command_mana
 
   // --- 语言：英文 ---
   auto* act_en = new QAction(sss::dscore::constants::CommandText(sss::dscore::constants::commands::kLangEnglish));
-  connect(act_en, &QAction::triggered, [lang_service]() {
-    if (lang_service) lang_service->SwitchLanguage(QLocale("en_US"));
+  connect(act_en, &QAction::triggered, this, [this]() {
+    if (language_service_) language_service_->SwitchLanguage(QLocale("en_US"));
   });
   command_manager->RegisterAction(act_en, sss::dscore::constants::commands::kLangEnglish, sss::dscore::kGlobalContext);
 
   // --- 语言：中文 ---
   auto* act_zh = new QAction(sss::dscore::constants::CommandText(sss::dscore::constants::commands::kLangChinese));
-  connect(act_zh, &QAction::triggered, [lang_service]() {
-    if (lang_service) lang_service->SwitchLanguage(QLocale("zh_CN"));
+  connect(act_zh, &QAction::triggered, this, [this]() {
+    if (language_service_) language_service_->SwitchLanguage(QLocale("zh_CN"));
   });
   command_manager->RegisterAction(act_zh, sss::dscore::constants::commands::kLangChinese, sss::dscore::kGlobalContext);
 
   // --- 主题：深色 ---
   auto* act_dark = new QAction(sss::dscore::constants::CommandText(sss::dscore::constants::commands::kThemeDark));
-  connect(act_dark, &QAction::triggered, [theme_service]() {
-    if (theme_service) theme_service->LoadTheme("dark");
+  connect(act_dark, &QAction::triggered, this, [this]() {
+    if (theme_service_) theme_service_->LoadTheme("dark");
   });
   command_manager->RegisterAction(act_dark, sss::dscore::constants::commands::kThemeDark, sss::dscore::kGlobalContext);
 
   // --- 主题：浅色 ---
   auto* act_light = new QAction(sss::dscore::constants::CommandText(sss::dscore::constants::commands::kThemeLight));
-  connect(act_light, &QAction::triggered, [theme_service]() {
-    if (theme_service) theme_service->LoadTheme("light");
+  connect(act_light, &QAction::triggered, this, [this]() {
+    if (theme_service_) theme_service_->LoadTheme("light");
   });
   command_manager->RegisterAction(act_light, sss::dscore::constants::commands::kThemeLight,
                                   sss::dscore::kGlobalContext);
 
   // --- 图标更新 ---
-  auto update_icons = [command_manager, theme_service](const QString& /*theme_id*/) {
-    if (!command_manager || !theme_service) return;
-
-    const QString base_path = ":/dscore/resources/icons";
-    auto set_icon = [&](const QString& cmd_id, const QString& filename) {
-      auto* cmd = command_manager->FindCommand(cmd_id);
-      if (cmd && cmd->Action()) {
-        cmd->Action()->setIcon(theme_service->GetIcon(base_path, filename));
-      }
-    };
-
-    set_icon(sss::dscore::constants::commands::kOpen, "file_open.svg");
-    set_icon(sss::dscore::constants::commands::kSave, "file_save.svg");
-    set_icon(sss::dscore::constants::commands::kAbout, "help_about.svg");
-  };
+  command_manager_ = command_manager;
+
+  updateIcons();
+}
+
+auto CoreUIProvider::themeServiceAdded(sss::dscore::IThemeService* theme_service) -> void {
+  connect(theme_service, &sss::dscore::IThemeService::ThemeChanged, this, [this]() { updateIcons(); });
 
-  if (theme_service != nullptr) {
-    connect(theme_service, &sss::dscore::IThemeService::ThemeChanged, update_icons);
-    // 初始更新
-    if (theme_service->Theme() != nullptr) {
-      update_icons(theme_service->Theme()->Id());
-    } else {
-      update_icons("light");
+  updateIcons();
+}
+
+auto CoreUIProvider::updateIcons() -> void {
+  if (!command_manager_ || !theme_service_) return;
+
+  const QString base_path = ":/dscore/resources/icons";
+  auto set_icon = [&](const QString& cmd_id, const QString& filename) {
+    auto* cmd = command_manager_->FindCommand(cmd_id);
+    if (cmd && cmd->Action()) {
+      cmd->Action()->setIcon(theme_service_->GetIcon(base_path, filename));
     }
-  }
+  };
+
+  set_icon(sss::dscore::constants::commands::kOpen, "file_open.svg");
+  set_icon(sss::dscore::constants::commands::kSave, "file_save.svg");
+  set_icon(sss::dscore::constants::commands::kAbout, "help_about.svg");
 }
 
 void CoreUIProvider::ContributeToMenu(sss::dscore::ICommandManager* command_manager) {
@@ -4,9 +4,12 @@
 
 #include "dscore/CoreSpec.h"
 #include "dscore/ICommandProvider.h"
+#include "dscore/ILanguageService.h"
 #include "dscore/IMenuProvider.h"
 #include "dscore/IStatusbarProvider.h"
+#include "dscore/IThemeService.h"
 #include "dscore/IToolbarProvider.h"
+#include "extsystem/ServiceTracker.h"
 
 namespace sss::dscore {
 
@@ -43,6 +46,27 @@ class DS_CORE_DLLSPEC CoreUIProvider : public QObject,
 
   // IStatusbarProvider
   void ContributeToStatusbar(sss::dscore::IStatusbarManager* statusbar_manager) override;
+
+ private:
+  /**
+   * @brief       主题服务可用时（包括在 RegisterCommands 之后才注册）连接其 ThemeChanged 信号并更新图标。
+   *
+   * @param[in]   theme_service 主题服务。
+   */
+  auto themeServiceAdded(sss::dscore::IThemeService* theme_service) -> void;
+
+  /**
+   * @brief       按当前主题更新命令图标，命令尚未注册或没有主题服务时不做任何事情。
+   */
+  auto updateIcons() -> void;
+
+  //! @cond
+
+  sss::dscore::ICommandManager* command_manager_ = nullptr;
+  sss::extsystem::ServiceTracker<sss::dscore::ILanguageService> language_service_;
+  sss::extsystem::ServiceTracker<sss::dscore::IThemeService> theme_service_;
+
+  //! @endcond
 };
 
 }  // namespace sss::dscore
@@ -2,13 +2,16 @@
 
 #include <spdlog/spdlog.h>
 
+#include "CommandManager.h"
 #include "dscore/CoreConstants.h"
 #include "dscore/IActionContainer.h"
 #include "dscore/ICommandManager.h"
 #include "dscore/ICommandProvider.h"
 #include "dscore/IMenuProvider.h"
 #include "dscore/IToolbarProvider.h"
+#include "extsystem/ComponentLoader.h"
 #include "extsystem/IComponentManager.h"
+#include "extsystem/StartupTrace.h"
 
 namespace sss::dscore {
 
@@ -17,6 +20,8 @@ MenuAndToolbarManager::MenuAndToolbarManager(QObject* parent) : QObject(parent)
 void MenuAndToolbarManager::Build() {  // NOLINT
   SPDLOG_INFO("[MenuAndToolbarManager] Starting UI Build Phase...");
 
+  sss::extsystem::StartupTrace::Span trace_span("MenuAndToolbarManager::Build", "ui");
+
   auto* command_manager = sss::dscore::ICommandManager::GetInstance();
 
   if (command_manager == nullptr) {
@@ -30,7 +35,8 @@ void MenuAndToolbarManager::Build() {  // NOLINT
   auto command_providers = sss::extsystem::GetTObjects<sss::dscore::ICommandProvider>();
   SPDLOG_DEBUG("[MenuAndToolbarManager] Found {} Command Providers.", command_providers.size());
   for (auto* provider : command_providers) {
-    if (provider != nullptr) {
+    if (provider != nullptr && !built_command_providers_.contains(provider)) {
+      built_command_providers_.insert(provider);
       auto* qobj = dynamic_cast<QObject*>(provider);
       SPDLOG_DEBUG("[MenuAndToolbarManager] Invoking Command Provider: {}",
                    qobj ? qobj->metaObject()->className() : "Unknown");
@@ -38,6 +44,19 @@ void MenuAndToolbarManager::Build() {  // NOLINT
     }
   }
 
+  // 为延迟组件声明的命令注册占位命令，使菜单和工具栏可以在组件加载之前引用它们
+  auto* component_loader = sss::extsystem::GetTObject<sss::extsystem::ComponentLoader>();
+  auto* concrete_command_manager = qobject_cast<sss::dscore::CommandManager*>(command_manager);
+
+  if (component_loader != nullptr && concrete_command_manager != nullptr) {
+    auto pending_commands =
+        component_loader->PendingTriggers(sss::extsystem::ComponentLoader::ActivationTrigger::kCommand);
+
+    for (const auto& command_id : pending_commands.keys()) {
+      concrete_command_manager->RegisterActivationStub(command_id);
+    }
+  }
+
   // 1. 创建基础菜单结构（文件、视图、帮助等）
   // 这确保主菜单栏存在。
   auto* app_menu = command_manager->FindContainer(sss::dscore::constants::menubars::kMainMenubar);
@@ -52,7 +71,8 @@ void MenuAndToolbarManager::Build() {  // NOLINT
   auto menu_providers = sss::extsystem::GetTObjects<sss::dscore::IMenuProvider>();
   SPDLOG_DEBUG("[MenuAndToolbarManager] Found {} Menu Providers.", menu_providers.size());
   for (auto* provider : menu_providers) {
-    if (provider != nullptr) {
+    if (provider != nullptr && !built_menu_providers_.contains(provider)) {
+      built_menu_providers_.insert(provider);
       auto* qobj = dynamic_cast<QObject*>(provider);
       SPDLOG_DEBUG("[MenuAndToolbarManager] Invoking Menu Provider: {}",
                    qobj ? qobj->metaObject()->className() : "Unknown");
@@ -65,7 +85,8 @@ void MenuAndToolbarManager::Build() {  // NOLINT
   auto toolbar_providers = sss::extsystem::GetTObjects<sss::dscore::IToolbarProvider>();
   SPDLOG_DEBUG("[MenuAndToolbarManager] Found {} Toolbar Providers.", toolbar_providers.size());
   for (auto* provider : toolbar_providers) {
-    if (provider != nullptr) {
+    if (provider != nullptr && !built_toolbar_providers_.contains(provider)) {
+      built_toolbar_providers_.insert(provider);
       auto* qobj = dynamic_cast<QObject*>(provider);
       SPDLOG_DEBUG("[MenuAndToolbarManager] Invoking Toolbar Provider: {}",
                    qobj ? qobj->metaObject()->className() : "Unknown");
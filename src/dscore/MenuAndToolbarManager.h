@@ -1,8 +1,12 @@
 #pragma once
 
 #include <QObject>
+#include <QSet>
 
 namespace sss::dscore {
+class ICommandProvider;
+class IMenuProvider;
+class IToolbarProvider;
 
 /**
  * @brief       通过协调提供者来管理菜单和工具栏的构建。
@@ -20,9 +24,21 @@ class MenuAndToolbarManager : public QObject {
 
   /**
    * @brief       收集贡献并构建UI。
-   *              应在 CoreComponent::InitialisationFinishedEvent 期间调用一次。
+   *              在 CoreComponent::InitialisationFinishedEvent 期间首次调用。
+   *
+   * @details     构建是增量的：只调用尚未调用过的提供者，因此延迟组件激活后
+   *              可以再次调用以加入新组件的命令、菜单和工具栏。
    */
   void Build();
+
+ private:
+  //! @cond
+
+  QSet<sss::dscore::ICommandProvider*> built_command_providers_;
+  QSet<sss::dscore::IMenuProvider*> built_menu_providers_;
+  QSet<sss::dscore::IToolbarProvider*> built_toolbar_providers_;
+
+  //! @endcond
 };
 
 }  // namespace sss::dscore
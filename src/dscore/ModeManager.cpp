@@ -5,6 +5,9 @@
 #include "dscore/IContextManager.h"
 #include "dscore/IMode.h"
 #include "dscore/IWorkbench.h"
+#include "extsystem/Component.h"
+#include "extsystem/ComponentLoader.h"
+#include "extsystem/IComponentManager.h"
 
 namespace sss::dscore {
 
@@ -30,6 +33,15 @@ void ModeManager::AddMode(IMode* mode) {
 }
 
 void ModeManager::ActivateMode(const QString& id) {
+  if (!modes_.contains(id)) {
+    // 模式可能由尚未加载的延迟组件提供，激活后组件会在初始化期间注册该模式
+    auto* component_loader = sss::extsystem::GetTObject<sss::extsystem::ComponentLoader>();
+
+    if (component_loader != nullptr) {
+      component_loader->ActivateTrigger(sss::extsystem::ComponentLoader::ActivationTrigger::kMode, id);
+    }
+  }
+
   if (!modes_.contains(id)) {
     SPDLOG_WARN("Attempted to activate unknown mode: {}", id.toStdString());
     return;
@@ -44,27 +56,32 @@ void ModeManager::ActivateMode(const QString& id) {
               old_mode ? old_mode->Title().toStdString() : "None",
               new_mode->Title().toStdString());
 
-  // 1. 停用旧模式
-  if (old_mode != nullptr) {
-    old_mode->Deactivate();
-  }
-
-  // 2. Update Active Mode Pointer
-  active_mode_ = new_mode;
+  {
+    // 旧模式停用、模式上下文切换和新模式激活中的上下文变化作为一次变化发布
+    ContextTransaction transaction(IContextManager::GetInstance());
 
-  // 3. 激活新模式
-  if (active_mode_ != nullptr) {
-    // Set Context (Switch Mode)
-    auto* cm = IContextManager::GetInstance();
-    if (cm != nullptr) {
-      cm->ActivateMode(active_mode_->ContextId());
+    // 1. 停用旧模式
+    if (old_mode != nullptr) {
+      old_mode->Deactivate();
     }
 
-    // 设置工作台内容
-    if (workbench_ != nullptr) {
-      workbench_->Clear();
-      workbench_->SetActiveModeButton(active_mode_->Id());
-      active_mode_->Activate();
+    // 2. Update Active Mode Pointer
+    active_mode_ = new_mode;
+
+    // 3. 激活新模式
+    if (active_mode_ != nullptr) {
+      // Set Context (Switch Mode)
+      auto* cm = IContextManager::GetInstance();
+      if (cm != nullptr) {
+        cm->ActivateMode(active_mode_->ContextId());
+      }
+
+      // 设置工作台内容
+      if (workbench_ != nullptr) {
+        workbench_->Clear();
+        workbench_->SetActiveModeButton(active_mode_->Id());
+        active_mode_->Activate();
+      }
     }
   }
 
@@ -84,6 +101,20 @@ void ModeManager::SetGlobalWorkbench(IWorkbench* workbench) {
       workbench_->AddModeButton(mode->Id(), mode->Title(), mode->Icon());
     }
 
+    // 为延迟组件提供的模式添加占位按钮，组件注册模式时按钮会被更新
+    auto* component_loader = sss::extsystem::GetTObject<sss::extsystem::ComponentLoader>();
+
+    if (component_loader != nullptr) {
+      auto pending_modes = component_loader->PendingTriggers(sss::extsystem::ComponentLoader::ActivationTrigger::kMode);
+
+      for (auto pending_iterator = pending_modes.constBegin(); pending_iterator != pending_modes.constEnd();
+           ++pending_iterator) {
+        if (!modes_.contains(pending_iterator.key())) {
+          workbench_->AddModeButton(pending_iterator.key(), pending_iterator.value()->Name(), QIcon());
+        }
+      }
+    }
+
     if (active_mode_ != nullptr) {
       workbench_->SetActiveModeButton(active_mode_->Id());
     }
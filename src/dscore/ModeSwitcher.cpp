@@ -102,6 +102,16 @@ ModeSwitcher::ModeSwitcher(QWidget* parent) : QWidget(parent) {
 ModeSwitcher::~ModeSwitcher() = default;
 
 void ModeSwitcher::AddModeButton(const QString& id, const QString& title, const QIcon& icon) {
+  // 已有按钮（例如延迟加载模式的占位按钮）时只更新其外观
+  for (auto* existing_btn : button_group_->buttons()) {
+    if (existing_btn->property("mode_id").toString() == id) {
+      existing_btn->setText(title);
+      existing_btn->setIcon(icon);
+      existing_btn->setToolTip(title);
+      return;
+    }
+  }
+
   auto* btn = new RotatedTabButton(this);
 
   btn->setText(title);  // 标准文本，绘制处理旋转
@@ -140,8 +140,25 @@ void OverlayCanvas::SetBackgroundWidget(QWidget* widget) {
   update();  // 触发重新布局
 }
 
+namespace {
+// 上下文列表的含义：空列表表示全局/始终活动，否则任一上下文活动时活动
+auto ListExpression(const QList<int>& contexts) -> sss::dscore::ContextExpression {
+  if (contexts.isEmpty()) {
+    return sss::dscore::ContextExpression::Always();
+  }
+
+  return sss::dscore::ContextExpression::AnyOf(sss::dscore::ContextSet(contexts));
+}
+}  // namespace
+
 void OverlayCanvas::AddSqueezeWidget(SqueezeSide side, QWidget* widget, int priority,
                                      const QList<int>& visible_contexts, const QList<int>& enable_contexts) {
+  AddSqueezeWidget(side, widget, priority, ListExpression(visible_contexts), ListExpression(enable_contexts));
+}
+
+void OverlayCanvas::AddSqueezeWidget(SqueezeSide side, QWidget* widget, int priority,
+                                     const ContextExpression& visible_expression,
+                                     const ContextExpression& enable_expression) {
   if (widget == nullptr) {
     return;
   }
@@ -149,7 +166,7 @@ void OverlayCanvas::AddSqueezeWidget(SqueezeSide side, QWidget* widget, int prio
   widget->setParent(this);
   // 可见性将由 updateContextState 设置
 
-  squeeze_widgets_.append({widget, side, priority, visible_contexts, enable_contexts});
+  squeeze_widgets_.append({widget, side, priority, visible_expression, enable_expression});
 
   // 按优先级排序压缩部件（降序）
   // 更高优先级 = 首先处理 = 最外层位置
@@ -161,42 +178,35 @@ void OverlayCanvas::AddSqueezeWidget(SqueezeSide side, QWidget* widget, int prio
 
 void OverlayCanvas::AddOverlayWidget(OverlayZone zone, QWidget* widget, int priority,
                                      const QList<int>& visible_contexts, const QList<int>& enable_contexts) {
+  AddOverlayWidget(zone, widget, priority, ListExpression(visible_contexts), ListExpression(enable_contexts));
+}
+
+void OverlayCanvas::AddOverlayWidget(OverlayZone zone, QWidget* widget, int priority,
+                                     const ContextExpression& visible_expression,
+                                     const ContextExpression& enable_expression) {
   if (widget == nullptr) {
     return;
   }
 
-  overlay_items_.append({widget, zone, priority, visible_contexts, enable_contexts});
+  overlay_items_.append({widget, zone, priority, visible_expression, enable_expression});
 
   refreshOverlayContainer(zone);
   UpdateContextState();
 }
 
 void OverlayCanvas::UpdateContextState() {
-  QList<int> active_contexts;
+  ContextSet active_contexts;
   auto* cm = sss::dscore::IContextManager::GetInstance();
   if (cm != nullptr) {
-    active_contexts = cm->GetActiveContexts();
-  }
-  // 确保全局上下文（0）始终被视为活动状态以进行匹配
-  if (!active_contexts.contains(0)) {
-    active_contexts.append(0);
+    active_contexts = cm->GetActiveContextSet();
   }
-
-  // 辅助函数：检查 active_contexts 是否与 required_contexts 中的任何 ID 匹配（交集）。
-  // 空的 required_contexts 表示全局/始终活动。
-  auto is_active = [&](const QList<int>& required_contexts) -> bool {
-    if (required_contexts.isEmpty()) return true;
-    // 如果包含 0，则始终活动
-    if (required_contexts.contains(0)) return true;
-
-    return std::any_of(std::begin(required_contexts), std::end(required_contexts),
-                       [&](int id) { return active_contexts.contains(id); });
-  };
+  // 确保全局上下文（0）始终被视为活动状态以进行匹配，因此包含 0 的上下文列表始终活动
+  active_contexts.Insert(kGlobalContext);
 
   // 更新压缩部件
   for (const auto& item : squeeze_widgets_) {
-    bool visible = is_active(item.visible_contexts);
-    bool enabled = is_active(item.enable_contexts);
+    bool visible = item.visible_expression.Evaluate(active_contexts);
+    bool enabled = item.enable_expression.Evaluate(active_contexts);
 
     item.widget->setVisible(visible);
     // 仅在可见时更改启用状态（优化）
@@ -207,8 +217,8 @@ void OverlayCanvas::UpdateContextState() {
 
   // 更新覆盖部件
   for (const auto& item : overlay_items_) {
-    bool visible = is_active(item.visible_contexts);
-    bool enabled = is_active(item.enable_contexts);
+    bool visible = item.visible_expression.Evaluate(active_contexts);
+    bool enabled = item.enable_expression.Evaluate(active_contexts);
 
     item.widget->setVisible(visible);
     if (visible) {
@@ -5,6 +5,7 @@
 #include <QVector>
 #include <QWidget>
 
+#include "dscore/ContextExpression.h"
 #include "dscore/IWorkbench.h"
 
 QT_BEGIN_NAMESPACE
@@ -45,6 +46,18 @@ class OverlayCanvas : public QWidget {
   void AddOverlayWidget(OverlayZone zone, QWidget* widget, int priority = 0, const QList<int>& visible_contexts = {},
                         const QList<int>& enable_contexts = {});
 
+  /**
+   * @brief 以上下文表达式添加一个"挤压"背景区域的小部件。
+   */
+  void AddSqueezeWidget(SqueezeSide side, QWidget* widget, int priority, const ContextExpression& visible_expression,
+                        const ContextExpression& enable_expression);
+
+  /**
+   * @brief 以上下文表达式添加一个浮动在所有内容上方的小部件。
+   */
+  void AddOverlayWidget(OverlayZone zone, QWidget* widget, int priority, const ContextExpression& visible_expression,
+                        const ContextExpression& enable_expression);
+
   /**
    * @brief 显示一个临时通知消息。
    */
@@ -77,16 +90,16 @@ class OverlayCanvas : public QWidget {
     QWidget* widget;
     SqueezeSide side;
     int priority;
-    QList<int> visible_contexts;
-    QList<int> enable_contexts;
+    ContextExpression visible_expression;
+    ContextExpression enable_expression;
   };
 
   struct OverlayItem {
     QWidget* widget;
     OverlayZone zone;
     int priority;
-    QList<int> visible_contexts;
-    QList<int> enable_contexts;
+    ContextExpression visible_expression;
+    ContextExpression enable_expression;
   };
 
   // 背景
@@ -16,6 +16,8 @@
 #include <chrono>
 #include <utility>
 
+#include "extsystem/StartupTrace.h"
+
 namespace sss::dscore {
 
 // 辅助函数：将字符串映射到QPalette::ColorRole
@@ -136,6 +138,7 @@ ThemeService::ThemeService() {
 }
 
 auto ThemeService::LoadTheme(const QString& theme_id) -> void {
+  sss::extsystem::StartupTrace::Span trace_span([&]() { return "LoadTheme " + theme_id; }, "theme");
   auto start_time = std::chrono::high_resolution_clock::now();
   SPDLOG_INFO("Starting to load theme: {}", theme_id.toStdString());
   QString config_path = QString(":/dscore/resources/themes/%1.ini").arg(theme_id);
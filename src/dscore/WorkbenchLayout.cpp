@@ -99,6 +99,20 @@ void WorkbenchLayout::AddOverlayWidget(OverlayZone zone, QWidget* widget, int pr
     overlay_canvas_->AddOverlayWidget(zone, widget, priority, visible_contexts, enable_contexts);
 }
 
+void WorkbenchLayout::AddSqueezeWidget(SqueezeSide side, QWidget* widget, int priority,
+                                       const ContextExpression& visible_expression,
+                                       const ContextExpression& enable_expression) {
+  if (overlay_canvas_ != nullptr)
+    overlay_canvas_->AddSqueezeWidget(side, widget, priority, visible_expression, enable_expression);
+}
+
+void WorkbenchLayout::AddOverlayWidget(OverlayZone zone, QWidget* widget, int priority,
+                                       const ContextExpression& visible_expression,
+                                       const ContextExpression& enable_expression) {
+  if (overlay_canvas_ != nullptr)
+    overlay_canvas_->AddOverlayWidget(zone, widget, priority, visible_expression, enable_expression);
+}
+
 void WorkbenchLayout::ShowNotification(const QString& message, int duration_ms) {
   if (overlay_canvas_ != nullptr) overlay_canvas_->ShowNotification(message, duration_ms);
 }
@@ -37,6 +37,10 @@ class DS_CORE_DLLSPEC WorkbenchLayout : public QWidget, public IWorkbench {
                         const QList<int>& enable_contexts) override;
   void AddOverlayWidget(OverlayZone zone, QWidget* widget, int priority, const QList<int>& visible_contexts,
                         const QList<int>& enable_contexts) override;
+  void AddSqueezeWidget(SqueezeSide side, QWidget* widget, int priority, const ContextExpression& visible_expression,
+                        const ContextExpression& enable_expression) override;
+  void AddOverlayWidget(OverlayZone zone, QWidget* widget, int priority, const ContextExpression& visible_expression,
+                        const ContextExpression& enable_expression) override;
   void ShowNotification(const QString& message, int duration_ms) override;
 
   /**
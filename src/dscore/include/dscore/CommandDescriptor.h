@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QKeySequence>
+#include <QString>
+#include <functional>
+
+#include "dscore/CommandProgress.h"
+#include "dscore/ContextExpression.h"
+
+namespace sss::dscore {
+/**
+ * @brief       CommandDescriptor 以普通数据描述一个命令。
+ *
+ * @details     通过 ICommandManager::RegisterCommand 注册的描述符不创建任何 QObject，只有当命令被放入
+ *              动作容器、通过 ICommandManager::FindCommand 查找或绑定了快捷键时，命令管理器才创建命令的
+ *              QAction 和代理动作。适合包含大量很少显示的命令的工具目录。
+ *
+ * @code
+ *              sss::dscore::CommandDescriptor descriptor;
+ *
+ *              descriptor.id = "ws1.tools.measure";
+ *              descriptor.text = QObject::tr("Measure");
+ *              descriptor.icon = ":/ws1/resources/icons/measure.svg";
+ *              descriptor.visibility_expression = sss::dscore::ContextExpression::Compile("ws1.context");
+ *              descriptor.handler = [] { ... };
+ *
+ *              command_manager->RegisterCommand(descriptor);
+ * @endcode
+ *
+ * @class       sss::dscore::CommandDescriptor CommandDescriptor.h <CommandDescriptor>
+ */
+struct CommandDescriptor {
+  //! 命令的标识符。
+  QString id;
+
+  //! 动作的文本；如果核心字符串集合中有该标识符的翻译，则使用翻译。
+  QString text;
+
+  //! 图标的资源路径，例如 ":/ws1/resources/icons/sample.svg"；通过 IThemeService 解析为当前主题的图标。
+  QString icon;
+
+  //! 快捷键；不为空时命令在注册时立即创建，以便快捷键生效。
+  QKeySequence shortcut;
+
+  //! 命令可见的条件。
+  ContextExpression visibility_expression = ContextExpression::Always();
+
+  //! 命令启用的条件。
+  ContextExpression enabled_expression = ContextExpression::Always();
+
+  //! 命令被触发时在 GUI 线程中调用的函数；设置了 async_handler 时被忽略。
+  std::function<void()> handler;
+
+  //! 不为空时命令异步执行，见 ICommandManager::SetAsyncHandler。
+  AsyncCommandHandler async_handler;
+
+  //! 异步命令运行时再次执行的处理方式。
+  ReentrancyPolicy reentrancy_policy = ReentrancyPolicy::kDrop;
+};
+}  // namespace sss::dscore
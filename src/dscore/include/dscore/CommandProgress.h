@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QString>
+#include <functional>
+#include <memory>
+
+#include "dscore/CoreSpec.h"
+
+namespace sss::dscore {
+class AsyncCommandRunner;
+
+/**
+ * @brief       异步命令正在运行时再次执行命令的处理方式。
+ */
+enum class ReentrancyPolicy : uint8_t {
+  kQueue,   //!< 当前运行结束后再运行一次，多次执行合并为一次。
+  kDrop,    //!< 忽略再次执行。
+  kRestart  //!< 请求取消当前运行，结束后立即重新运行。
+};
+
+/**
+ * @brief       CommandProgress 是异步命令的处理函数报告进度和检查取消请求的接口。
+ *
+ * @details     所有函数都可以在工作线程中调用。进度和消息以合并后的排队调用发送到 GUI 线程，
+ *              在状态栏中显示，因此频繁报告不会阻塞工作线程或使事件队列膨胀。
+ *
+ *              处理函数应定期调用 IsCancelled()，在返回 true 时尽快返回。
+ *
+ * @class       sss::dscore::CommandProgress CommandProgress.h <CommandProgress>
+ */
+class DS_CORE_DLLSPEC CommandProgress {
+ public:
+  /**
+   * @brief       报告进度。
+   *
+   * @param[in]   value 当前进度。
+   * @param[in]   maximum 最大进度；为 0 时显示为忙碌状态。
+   */
+  auto SetProgress(int value, int maximum = 100) -> void;
+
+  /**
+   * @brief       设置在状态栏中显示的消息。
+   *
+   * @param[in]   message 消息。
+   */
+  auto SetMessage(const QString& message) -> void;
+
+  /**
+   * @brief       检查是否请求了取消。
+   *
+   * @returns     请求了取消则返回 true。
+   */
+  [[nodiscard]] auto IsCancelled() const -> bool;
+
+ private:
+  //! @cond
+
+  struct State;
+
+  explicit CommandProgress(std::shared_ptr<State> state);
+
+  // 调用者持有 state_->mutex
+  auto scheduleUpdate() -> void;
+
+  friend class AsyncCommandRunner;
+
+  std::shared_ptr<State> state_;
+
+  //! @endcond
+};
+
+/**
+ * @brief       异步命令的处理函数，在工作线程中运行。
+ */
+using AsyncCommandHandler = std::function<void(CommandProgress& progress)>;
+}  // namespace sss::dscore
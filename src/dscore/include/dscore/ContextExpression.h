@@ -0,0 +1,127 @@
+#pragma once
+
+#include <QList>
+#include <QString>
+#include <QVector>
+
+#include "dscore/ContextSet.h"
+#include "dscore/CoreSpec.h"
+
+namespace sss::dscore {
+class IContextManager;
+
+/**
+ * @brief       ContextExpression 是编译后的上下文条件表达式。
+ *
+ * @details     表达式由上下文名称、&&、||、! 和括号组成，优先级从高到低为 !、&&、||，例如：
+ *
+ * @code
+ *              ws1.context && !ws1.sub_context.enabled
+ *              (ws1.context || ws2.context) && editor.selection
+ * @endcode
+ *
+ *              表达式在注册时编译一次：上下文名称通过 IContextManager::RegisterContext 解析为上下文ID，
+ *              只由 || 或只由 && 连接的表达式编译为一个位掩码，其他表达式编译为后缀字节码。求值时只做
+ *              位运算，不分配内存。
+ *
+ *              ContextExpression 没有默认构造函数，通过 Compile() 或 Always()、AnyOf()、AllOf() 等工厂函数
+ *              创建，因此 ICommandManager 和 IWorkbench 中接受上下文列表和接受表达式的重载不会产生歧义。
+ *
+ * @class       sss::dscore::ContextExpression ContextExpression.h <ContextExpression>
+ */
+class DS_CORE_DLLSPEC ContextExpression {
+ public:
+  /**
+   * @brief       编译表达式。
+   *
+   * @details     语法错误或嵌套超过求值栈深度时记录警告，返回的表达式无效且始终为 false。
+   *
+   * @param[in]   expression 表达式文本。
+   * @param[in]   context_manager 用于解析上下文名称的上下文管理器，未注册的名称记录警告后被注册。
+   * @param[out]  error 如果不为 nullptr，语法错误时设置为错误描述，否则清空。
+   *
+   * @returns     编译后的表达式。
+   */
+  static auto Compile(const QString& expression, IContextManager* context_manager, QString* error = nullptr)
+      -> ContextExpression;
+
+  /**
+   * @brief       使用 IContextManager::GetInstance() 解析上下文名称编译表达式。
+   *
+   * @see         Compile(const QString&, IContextManager*, QString*)
+   */
+  static auto Compile(const QString& expression) -> ContextExpression;
+
+  /**
+   * @brief       返回始终为 true 的表达式。
+   */
+  static auto Always() -> ContextExpression;
+
+  /**
+   * @brief       返回始终为 false 的表达式。
+   */
+  static auto Never() -> ContextExpression;
+
+  /**
+   * @brief       返回任一上下文活动时为 true 的表达式；contexts 为空时始终为 false。
+   *
+   * @param[in]   contexts 上下文。
+   */
+  static auto AnyOf(const ContextSet& contexts) -> ContextExpression;
+
+  /**
+   * @brief       返回所有上下文都活动时为 true 的表达式；contexts 为空时始终为 true。
+   *
+   * @param[in]   contexts 上下文。
+   */
+  static auto AllOf(const ContextSet& contexts) -> ContextExpression;
+
+  /**
+   * @brief       对活动上下文求值。
+   *
+   * @param[in]   active_contexts 活动上下文。
+   *
+   * @returns     表达式的值；无效的表达式返回 false。
+   */
+  [[nodiscard]] auto Evaluate(const ContextSet& active_contexts) const -> bool;
+
+  /**
+   * @brief       检查表达式是否编译成功。
+   */
+  [[nodiscard]] auto IsValid() const -> bool { return valid_; }
+
+  /**
+   * @brief       返回表达式引用的所有上下文，包括被 ! 取反的上下文。
+   *
+   * @details     只有这些上下文的变化会改变表达式的值。
+   */
+  [[nodiscard]] auto ReferencedContexts() const -> const ContextSet& { return referenced_contexts_; }
+
+ private:
+  //! @cond
+
+  enum class Kind { kConstant, kAnyOf, kAllOf, kBytecode };
+
+  enum class OpCode : quint8 { kContext, kNot, kAnd, kOr };
+
+  struct Instruction {
+    OpCode op_code;
+    int context_id;
+  };
+
+  // 求值栈是一个 64 位的位栈
+  static constexpr int kMaximumDepth = 64;
+
+  ContextExpression(Kind kind, bool constant);
+
+  friend class ContextExpressionCompiler;
+
+  Kind kind_;
+  bool constant_;
+  bool valid_{true};
+  ContextSet referenced_contexts_;
+  QVector<Instruction> bytecode_;
+
+  //! @endcond
+};
+}  // namespace sss::dscore
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <QList>
+#include <QMetaType>
+#include <QVarLengthArray>
+#include <QtAlgorithms>
+#include <QtGlobal>
+#include <algorithm>
+#include <initializer_list>
+
+namespace sss::dscore {
+/**
+ * @brief       ContextSet 是以上下文ID为位下标的位集合。
+ *
+ * @details     上下文ID由 IContextManager::RegisterContext 从 0 开始连续分配，因此可以直接作为位下标。
+ *              前 128 个上下文保存在对象内部的缓冲区中，复制和比较都不会分配内存；交集和子集测试
+ *              只需要按字进行几次位运算。负的上下文ID被忽略。
+ *
+ * @class       sss::dscore::ContextSet ContextSet.h <ContextSet>
+ */
+class ContextSet {
+ public:
+  /**
+   * @brief       构造空集合。
+   */
+  ContextSet() = default;
+
+  /**
+   * @brief       构造包含给定上下文的集合。
+   *
+   * @param[in]   context_ids 上下文ID。
+   */
+  ContextSet(std::initializer_list<int> context_ids) {
+    for (auto context_id : context_ids) {
+      Insert(context_id);
+    }
+  }
+
+  /**
+   * @brief       构造包含列表中所有上下文的集合。
+   *
+   * @param[in]   context_ids 上下文ID列表。
+   */
+  explicit ContextSet(const QList<int>& context_ids) {
+    for (auto context_id : context_ids) {
+      Insert(context_id);
+    }
+  }
+
+  /**
+   * @brief       添加上下文。
+   *
+   * @param[in]   context_id 上下文ID。
+   */
+  auto Insert(int context_id) -> void {
+    if (context_id < 0) {
+      return;
+    }
+
+    auto word = wordIndex(context_id);
+
+    if (word >= words_.size()) {
+      auto size = words_.size();
+
+      // QVarLengthArray::resize 不初始化新元素
+      words_.resize(word + 1);
+      std::fill(words_.begin() + size, words_.end(), Word(0));
+    }
+
+    words_[word] |= bitMask(context_id);
+  }
+
+  /**
+   * @brief       移除上下文。
+   *
+   * @param[in]   context_id 上下文ID。
+   */
+  auto Remove(int context_id) -> void {
+    if (Contains(context_id)) {
+      words_[wordIndex(context_id)] &= ~bitMask(context_id);
+    }
+  }
+
+  /**
+   * @brief       清空集合，保留已分配的缓冲区。
+   */
+  auto Clear() -> void { words_.clear(); }
+
+  /**
+   * @brief       检查集合是否包含上下文。
+   *
+   * @param[in]   context_id 上下文ID。
+   *
+   * @returns     包含则返回 true。
+   */
+  [[nodiscard]] auto Contains(int context_id) const -> bool {
+    if (context_id < 0 || wordIndex(context_id) >= words_.size()) {
+      return false;
+    }
+
+    return (words_[wordIndex(context_id)] & bitMask(context_id)) != 0;
+  }
+
+  /**
+   * @brief       检查集合是否为空。
+   *
+   * @returns     为空则返回 true。
+   */
+  [[nodiscard]] auto IsEmpty() const -> bool {
+    for (auto word : words_) {
+      if (word != 0) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief       检查两个集合是否有共同的上下文。
+   *
+   * @param[in]   other 另一个集合。
+   *
+   * @returns     有共同的上下文则返回 true；任一集合为空时返回 false。
+   */
+  [[nodiscard]] auto Intersects(const ContextSet& other) const -> bool {
+    auto size = qMin(words_.size(), other.words_.size());
+
+    for (auto index = 0; index < size; index++) {
+      if ((words_[index] & other.words_[index]) != 0) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  /**
+   * @brief       检查此集合的所有上下文是否都包含在另一个集合中。
+   *
+   * @param[in]   other 另一个集合。
+   *
+   * @returns     是子集则返回 true；空集是任何集合的子集。
+   */
+  [[nodiscard]] auto IsSubsetOf(const ContextSet& other) const -> bool {
+    for (auto index = 0; index < words_.size(); index++) {
+      auto other_word = index < other.words_.size() ? other.words_[index] : Word(0);
+
+      if ((words_[index] & ~other_word) != 0) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief       返回在此集合中但不在另一个集合中的上下文。
+   *
+   * @param[in]   other 另一个集合。
+   *
+   * @returns     差集。
+   */
+  [[nodiscard]] auto Difference(const ContextSet& other) const -> ContextSet {
+    ContextSet difference = *this;
+
+    for (auto index = 0; index < qMin(words_.size(), other.words_.size()); index++) {
+      difference.words_[index] &= ~other.words_[index];
+    }
+
+    return difference;
+  }
+
+  /**
+   * @brief       返回只在其中一个集合中的上下文。
+   *
+   * @param[in]   other 另一个集合。
+   *
+   * @returns     对称差集。
+   */
+  [[nodiscard]] auto SymmetricDifference(const ContextSet& other) const -> ContextSet {
+    ContextSet difference;
+    auto size = qMax(words_.size(), other.words_.size());
+
+    difference.words_.resize(size);
+
+    for (auto index = 0; index < size; index++) {
+      auto word = index < words_.size() ? words_[index] : Word(0);
+      auto other_word = index < other.words_.size() ? other.words_[index] : Word(0);
+
+      difference.words_[index] = word ^ other_word;
+    }
+
+    return difference;
+  }
+
+  /**
+   * @brief       按升序对集合中的每个上下文调用函数。
+   *
+   * @details     只访问置位的位，不分配内存。
+   *
+   * @param[in]   function 以上下文ID为参数的函数。
+   */
+  template <typename Function>
+  auto ForEach(Function&& function) const -> void {
+    for (auto index = 0; index < words_.size(); index++) {
+      for (auto word = words_[index]; word != 0; word &= word - 1) {
+        function(index * kWordBits + static_cast<int>(qCountTrailingZeroBits(word)));
+      }
+    }
+  }
+
+  /**
+   * @brief       按升序返回集合中的上下文。
+   *
+   * @returns     上下文ID列表。
+   */
+  [[nodiscard]] auto ToList() const -> QList<int> {
+    QList<int> context_ids;
+
+    ForEach([&context_ids](int context_id) { context_ids.append(context_id); });
+
+    return context_ids;
+  }
+
+  /**
+   * @brief       比较两个集合是否包含相同的上下文。
+   */
+  friend auto operator==(const ContextSet& lhs, const ContextSet& rhs) -> bool {
+    return lhs.IsSubsetOf(rhs) && rhs.IsSubsetOf(lhs);
+  }
+
+  /**
+   * @brief       比较两个集合是否包含不同的上下文。
+   */
+  friend auto operator!=(const ContextSet& lhs, const ContextSet& rhs) -> bool { return !(lhs == rhs); }
+
+ private:
+  //! @cond
+
+  using Word = quint64;
+
+  static constexpr int kWordBits = 64;
+
+  static auto wordIndex(int context_id) -> int { return context_id / kWordBits; }
+
+  static auto bitMask(int context_id) -> Word { return Word(1) << (context_id % kWordBits); }
+
+  QVarLengthArray<Word, 2> words_;
+
+  //! @endcond
+};
+}  // namespace sss::dscore
+
+Q_DECLARE_METATYPE(sss::dscore::ContextSet)
@@ -41,6 +41,28 @@ class DS_CORE_DLLSPEC ICommand : public QObject {
    */
   virtual auto Active() -> bool = 0;
 
+  /**
+   * @brief       执行命令。
+   *
+   * @details     同步命令触发代理动作；异步命令在工作线程中运行处理函数，正在运行时按注册时的
+   *              ReentrancyPolicy 处理。
+   *
+   * @see         sss::dscore::ICommandManager::SetAsyncHandler
+   */
+  virtual auto Execute() -> void { Action()->trigger(); }
+
+  /**
+   * @brief       检查异步命令的处理函数是否正在运行。
+   *
+   * @returns     正在运行则返回 true；同步命令总是返回 false。
+   */
+  virtual auto IsRunning() -> bool { return false; }
+
+  /**
+   * @brief       请求取消正在运行的异步命令，并丢弃排队的执行。
+   */
+  virtual auto Cancel() -> void {}
+
   /**
    * @brief       将命令附加到抽象按钮
    *
@@ -56,6 +78,14 @@ class DS_CORE_DLLSPEC ICommand : public QObject {
 
   // 具有虚函数的类不应有公共的虚析构函数：
   ~ICommand() override = default;
+
+ signals:
+  /**
+   * @brief       异步命令的一次运行结束时发出。
+   *
+   * @param[in]   cancelled 运行是否被取消。
+   */
+  void ExecutionFinished(bool cancelled);
 };
 }  // namespace sss::dscore
 
@@ -5,6 +5,9 @@
 #include <QObject>
 #include <utility>
 
+#include "dscore/CommandDescriptor.h"
+#include "dscore/CommandProgress.h"
+#include "dscore/ContextExpression.h"
 #include "dscore/IActionContainer.h"
 #include "dscore/ICommand.h"
 #include "dscore/IContextManager.h"
@@ -46,6 +49,23 @@ class DS_CORE_DLLSPEC ICommandManager : public QObject {
   virtual auto RegisterAction(QAction* action, QString id, const sss::dscore::ContextList& visibility_contexts,
                               const sss::dscore::ContextList& enabled_contexts) -> sss::dscore::ICommand* = 0;
 
+  /**
+   * @brief       以上下文表达式向命令注册 QAction。
+   *
+   * @details     与接受上下文列表的重载相同，但可见性和启用状态由编译后的上下文表达式决定，例如
+   *              ContextExpression::Compile("ws1.context && !ws1.sub_context.enabled")。
+   *
+   * @param[in]   action 动作。
+   * @param[in]   id 命令的标识符。
+   * @param[in]   visibility_expression 命令可见的条件。
+   * @param[in]   enabled_expression 命令启用的条件。
+   *
+   * @returns     指向 ICommand 的指针
+   */
+  virtual auto RegisterAction(QAction* action, QString id,
+                              const sss::dscore::ContextExpression& visibility_expression,
+                              const sss::dscore::ContextExpression& enabled_expression) -> sss::dscore::ICommand* = 0;
+
   virtual auto RegisterAction(QAction* action, QString id, int context_id) -> sss::dscore::ICommand* {
     sss::dscore::ContextList single_context_list;
     single_context_list << context_id;
@@ -56,12 +76,44 @@ class DS_CORE_DLLSPEC ICommandManager : public QObject {
                               const sss::dscore::ContextList& visibility_contexts,
                               const sss::dscore::ContextList& enabled_contexts) -> bool = 0;
 
+  virtual auto RegisterAction(QAction* action, sss::dscore::ICommand* command,
+                              const sss::dscore::ContextExpression& visibility_expression,
+                              const sss::dscore::ContextExpression& enabled_expression) -> bool = 0;
+
   virtual auto RegisterAction(QAction* action, sss::dscore::ICommand* command, int context_id) -> bool {
     sss::dscore::ContextList single_context_list;
     single_context_list << context_id;
     return RegisterAction(action, command, single_context_list, single_context_list);
   }
 
+  /**
+   * @brief       以描述符注册命令。
+   *
+   * @details     只保存描述符，命令的 QAction 在第一次通过 FindCommand 查找、被放入动作容器或描述符
+   *              带有快捷键时才创建。
+   *
+   * @param[in]   descriptor 命令描述符。
+   *
+   * @returns     注册成功返回 true；标识符为空或已被注册时返回 false。
+   */
+  virtual auto RegisterCommand(const sss::dscore::CommandDescriptor& descriptor) -> bool = 0;
+
+  /**
+   * @brief       使命令异步执行。
+   *
+   * @details     命令被触发时在命令管理器的线程池中运行处理函数，运行期间命令的代理动作被禁用，
+   *              状态栏中显示进度和取消按钮。处理函数通过 CommandProgress 报告进度和检查取消请求。
+   *              通过 ICommand::Execute 在运行期间再次执行时按 policy 处理。
+   *
+   * @param[in]   command 命令。
+   * @param[in]   handler 在工作线程中运行的处理函数。
+   * @param[in]   policy 运行时再次执行的处理方式。
+   *
+   * @returns     设置成功返回 true；命令不属于此管理器或已经是异步命令时返回 false。
+   */
+  virtual auto SetAsyncHandler(sss::dscore::ICommand* command, sss::dscore::AsyncCommandHandler handler,
+                               sss::dscore::ReentrancyPolicy policy) -> bool = 0;
+
   /**
    * @brief       设置当前活动上下文。
    *
@@ -99,7 +151,7 @@ class DS_CORE_DLLSPEC ICommandManager : public QObject {
   /**
    * @brief       查找命令。
    *
-   * @details     通过给定标识符查找已注册的命令。
+   * @details     通过给定标识符查找已注册的命令。以描述符注册且尚未创建的命令在此时创建。
    *
    * @param[in]   identifier 命令的标识符。
    *
@@ -118,4 +170,4 @@ class DS_CORE_DLLSPEC ICommandManager : public QObject {
 };
 }  // namespace sss::dscore
 
-Q_DECLARE_INTERFACE(sss::dscore::ICommandManager, "sss.dscore.ICommandManager/1.0.0")
+Q_DECLARE_INTERFACE(sss::dscore::ICommandManager, "sss.dscore.ICommandManager/2.0.0")
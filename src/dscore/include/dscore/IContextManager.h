@@ -2,6 +2,7 @@
 
 #include <QObject>
 
+#include "dscore/ContextSet.h"
 #include "dscore/CoreSpec.h"
 #include "extsystem/IComponentManager.h"
 
@@ -84,6 +85,16 @@ class DS_CORE_DLLSPEC IContextManager : public QObject {
    */
   [[nodiscard]] virtual auto GetActiveContexts() const -> ContextList = 0;
 
+  /**
+   * @brief       获取活动上下文的集合。
+   *
+   * @details     与 GetActiveContexts() 包含相同的上下文，但不保留激活顺序，用于可见性和启用状态的
+   *              交集与子集测试。
+   *
+   * @returns     活动上下文集合。
+   */
+  [[nodiscard]] virtual auto GetActiveContextSet() const -> ContextSet { return ContextSet(GetActiveContexts()); }
+
   /**
    * @brief       按名称获取上下文ID。
    *
@@ -105,6 +116,23 @@ class DS_CORE_DLLSPEC IContextManager : public QObject {
    */
   virtual auto ActivateMode(int mode_context_id) -> void = 0;
 
+  /**
+   * @brief       开始上下文事务。
+   *
+   * @details     事务中的上下文变化被累积，直到最外层的 CommitTransaction() 才作为一次变化发布：
+   *              ContextChanged 和 ActiveContextsChanged 各发出一次。事务可以嵌套。通常使用
+   *              ContextTransaction 而不是直接调用此函数。
+   */
+  virtual auto BeginTransaction() -> void = 0;
+
+  /**
+   * @brief       提交上下文事务。
+   *
+   * @details     提交最外层事务时，如果活动上下文列表（包括顺序）与上次发布时不同，则发布一次合并后的变化；
+   *              变化相互抵消时不发布。
+   */
+  virtual auto CommitTransaction() -> void = 0;
+
   /**
    * @brief       信号表明上下文已更改。
    *
@@ -115,9 +143,71 @@ class DS_CORE_DLLSPEC IContextManager : public QObject {
    */
   Q_SIGNAL void ContextChanged(int new_context, int previous_context);
 
+  /**
+   * @brief       信号表明活动上下文集合已更改。
+   *
+   * @details     与 ContextChanged 同时发出，携带自上次发布以来新增和移除的上下文。事务中的多次变化
+   *              合并为一次，因此同一个上下文在事务中先添加后移除时不会出现在任何一个集合中。
+   *
+   * @param[in]   added_contexts 新增的活动上下文。
+   * @param[in]   removed_contexts 移除的活动上下文。
+   */
+  Q_SIGNAL void ActiveContextsChanged(const sss::dscore::ContextSet& added_contexts,
+                                      const sss::dscore::ContextSet& removed_contexts);
+
   // 具有虚函数的类不应有公共的虚析构函数：
   ~IContextManager() override = default;
 };
+
+/**
+ * @brief       ContextTransaction 在其生命周期内把上下文变化合并为一次发布。
+ *
+ * @details     构造时开始事务，析构时提交：
+ *
+ * @code
+ *              {
+ *                sss::dscore::ContextTransaction transaction;
+ *
+ *                context_manager->AddActiveContext(first_context);
+ *                context_manager->AddActiveContext(second_context);
+ *              }  // 只发出一次 ContextChanged
+ * @endcode
+ *
+ * @class       sss::dscore::ContextTransaction IContextManager.h <IContextManager>
+ */
+class ContextTransaction {
+ public:
+  /**
+   * @brief       在给定的上下文管理器上开始事务。
+   *
+   * @param[in]   context_manager 上下文管理器；为 nullptr 时不做任何事情。
+   */
+  explicit ContextTransaction(IContextManager* context_manager = IContextManager::GetInstance())
+      : context_manager_(context_manager) {
+    if (context_manager_ != nullptr) {
+      context_manager_->BeginTransaction();
+    }
+  }
+
+  /**
+   * @brief       提交事务。
+   */
+  ~ContextTransaction() {
+    if (context_manager_ != nullptr) {
+      context_manager_->CommitTransaction();
+    }
+  }
+
+  ContextTransaction(const ContextTransaction&) = delete;
+  auto operator=(const ContextTransaction&) -> ContextTransaction& = delete;
+
+ private:
+  //! @cond
+
+  IContextManager* context_manager_;
+
+  //! @endcond
+};
 }  // namespace sss::dscore
 
 Q_DECLARE_INTERFACE(sss::dscore::IContextManager, "sss.dscore.IContextManager/1.0.0")
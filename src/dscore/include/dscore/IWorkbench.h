@@ -3,6 +3,8 @@
 #include <QIcon>
 #include <QObject>
 
+#include "dscore/ContextExpression.h"
+
 QT_BEGIN_NAMESPACE
 class QWidget;
 class QString;
@@ -66,6 +68,18 @@ class IWorkbench {
   virtual void AddSqueezeWidget(SqueezeSide side, QWidget* widget, int priority, const QList<int>& visible_contexts,
                                 const QList<int>& enable_contexts) = 0;
 
+  /**
+   * @brief       以上下文表达式添加挤压背景区域的小部件。
+   * @param[in]   side 要停靠小部件的边。
+   * @param[in]   widget 要添加的小部件。
+   * @param[in]   priority 排序优先级（数值越高越靠近边缘/最外层）。
+   * @param[in]   visible_expression 此小部件可见的条件。
+   * @param[in]   enable_expression 此小部件启用的条件。
+   */
+  virtual void AddSqueezeWidget(SqueezeSide side, QWidget* widget, int priority,
+                                const ContextExpression& visible_expression,
+                                const ContextExpression& enable_expression) = 0;
+
   /**
    * @brief       添加浮动覆盖小部件。
    * @param[in]   zone 要锚定小部件的区域。
@@ -77,6 +91,18 @@ class IWorkbench {
   virtual void AddOverlayWidget(OverlayZone zone, QWidget* widget, int priority, const QList<int>& visible_contexts,
                                 const QList<int>& enable_contexts) = 0;
 
+  /**
+   * @brief       以上下文表达式添加浮动覆盖小部件。
+   * @param[in]   zone 要锚定小部件的区域。
+   * @param[in]   widget 要添加的小部件。
+   * @param[in]   priority 排序优先级（数值越高在堆栈或Z顺序中越高）。
+   * @param[in]   visible_expression 此小部件可见的条件。
+   * @param[in]   enable_expression 此小部件启用的条件。
+   */
+  virtual void AddOverlayWidget(OverlayZone zone, QWidget* widget, int priority,
+                                const ContextExpression& visible_expression,
+                                const ContextExpression& enable_expression) = 0;
+
   /**
    * @brief       在顶部中心区域显示瞬时通知消息。
    * @param[in]   message 要显示的文本。
@@ -111,4 +137,4 @@ class IWorkbench {
 
 }  // namespace sss::dscore
 
-Q_DECLARE_INTERFACE(sss::dscore::IWorkbench, "sss.dscore.IWorkbench")
+Q_DECLARE_INTERFACE(sss::dscore::IWorkbench, "sss.dscore.IWorkbench/2.0")
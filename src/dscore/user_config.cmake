@@ -26,3 +26,17 @@ target_include_directories(${PROJECT_NAME} PRIVATE ${CMAKE_CURRENT_BINARY_DIR})
 # Set the output directory for the plugin library
 set_target_properties(${PROJECT_NAME} PROPERTIES LIBRARY_OUTPUT_DIRECTORY "${CMAKE_BINARY_DIR}/$<CONFIG>/components"
                                                  RUNTIME_OUTPUT_DIRECTORY "${CMAKE_BINARY_DIR}/$<CONFIG>/components")
+
+# 作为 Qt 静态插件链接进 app（见根目录 cmake/static_components.cmake）
+if(NOT DSCORE_BUILD_SHARED_LIBS)
+  list(APPEND PROJECT_COMPILE_DEFINITIONS QT_STATICPLUGIN)
+  target_compile_definitions(${PROJECT_NAME} PUBLIC DS_COMPONENT_CORE_STATIC)
+  target_sources(${PROJECT_NAME} PRIVATE ${PROJECT_QRCFILES_GLOBBED} ${QMFILES_RES})
+  set_target_properties(${PROJECT_NAME} PROPERTIES DS_COMPONENT_PLUGIN_CLASS CoreComponent
+                                                   DS_COMPONENT_RESOURCES "dscore;dscore_translations")
+endif()
+
+# 构建时校验 metadata.json 并嵌入二进制组件描述符（见根目录 cmake/component_descriptor.cmake）
+if(COMMAND add_component_descriptor)
+  add_component_descriptor(${PROJECT_NAME} "${CMAKE_CURRENT_SOURCE_DIR}/metadata.json")
+endif()
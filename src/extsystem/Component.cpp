@@ -1,14 +1,20 @@
 #include "extsystem/Component.h"
 
-#include <QJsonArray>
-
 sss::extsystem::Component::Component() : is_loaded_(false), load_flags_(ComponentLoader::kUnloaded) {}
 
 sss::extsystem::Component::Component(const QString& name, const QString& filename,  // NOLINT
                                      const QJsonObject& metadata)                   // NOLINT
-    : name_(name),
+    : name_(sss::extsystem::ComponentDescriptor::Intern(name)),
       filename_(filename),
       metadata_(metadata),
+      descriptor_(sss::extsystem::ComponentDescriptor::FromMetadata(metadata["MetaData"].toObject(), name)),
+      is_loaded_(false),
+      load_flags_(ComponentLoader::kUnloaded) {}
+
+sss::extsystem::Component::Component(const QString& filename, sss::extsystem::ComponentDescriptor descriptor)
+    : name_(descriptor.Name()),
+      filename_(filename),
+      descriptor_(std::move(descriptor)),
       is_loaded_(false),
       load_flags_(ComponentLoader::kUnloaded) {}
 
@@ -29,111 +35,70 @@ auto sss::extsystem::Component::LoadStatus() -> int { return load_flags_; }
 
 auto sss::extsystem::Component::MissingDependencies() -> QStringList { return missing_dependencies_; }
 
-auto sss::extsystem::Component::Version() -> QVersionNumber {
-  auto component_metadata = metadata_["MetaData"].toObject();
-  auto component_version = component_metadata["Version"].toString();
+auto sss::extsystem::Component::Descriptor() const -> const sss::extsystem::ComponentDescriptor& { return descriptor_; }
 
-  return QVersionNumber::fromString(component_version);
-}
+auto sss::extsystem::Component::Version() const -> QVersionNumber { return descriptor_.Version(); }
 
-auto sss::extsystem::Component::VersionString() -> QString {
-  auto component_metadata = metadata_["MetaData"].toObject();
-  auto component_version = component_metadata["Version"].toString();
-  auto component_branch = component_metadata["Branch"].toString();
-  auto component_revision = component_metadata["Revision"].toString();
+auto sss::extsystem::Component::VersionString() const -> QString { return descriptor_.VersionString(); }
 
-  return QString("%1-%2 (%3)").arg(component_version).arg(component_branch).arg(component_revision);
-}
+auto sss::extsystem::Component::Identifier() const -> QString { return descriptor_.Identifier(); }
 
-auto sss::extsystem::Component::Identifier() -> QString {
-  auto component_metadata = metadata_["MetaData"].toObject();
+auto sss::extsystem::Component::Category() const -> QString { return descriptor_.Category(); }
 
-  return (component_metadata["Name"].toString() + "." + component_metadata["Vendor"].toString()).toLower();
-}
+auto sss::extsystem::Component::Vendor() const -> QString { return descriptor_.Vendor(); }
 
-auto sss::extsystem::Component::Category() -> QString {
-  auto component_metadata = metadata_["MetaData"].toObject();
+auto sss::extsystem::Component::License() const -> QString { return descriptor_.License(); }
 
-  return component_metadata["Category"].toString();
-}
-
-auto sss::extsystem::Component::Vendor() -> QString {
-  auto component_metadata = metadata_["MetaData"].toObject();
+auto sss::extsystem::Component::Copyright() const -> QString { return descriptor_.Copyright(); }
 
-  return component_metadata["Vendor"].toString();
-}
+auto sss::extsystem::Component::Description() const -> QString { return descriptor_.Description(); }
 
-auto sss::extsystem::Component::License() -> QString {
-  QString license_text;
-  auto component_metadata = metadata_["MetaData"].toObject();
+auto sss::extsystem::Component::Url() const -> QString { return descriptor_.Url(); }
 
-  auto license_content = component_metadata["License"].toArray();
+auto sss::extsystem::Component::Dependencies() const -> QString {
+  QString dependency_text;
 
-  for (auto object : license_content) {
-    license_text += object.toString();
+  for (const auto& dependency : descriptor_.Dependencies()) {
+    dependency_text += QString("%1 (%2)\r\n").arg(dependency.name).arg(dependency.version.toString());
   }
 
-  return license_text;
-}
-
-auto sss::extsystem::Component::Copyright() -> QString {
-  auto component_metadata = metadata_["MetaData"].toObject();
-
-  return component_metadata["Copyright"].toString();
+  return dependency_text;
 }
 
-auto sss::extsystem::Component::Description() -> QString {
-  QString description_text;
-  auto component_metadata = metadata_["MetaData"].toObject();
-
-  auto license_content = component_metadata["Description"].toArray();
-
-  for (auto object : license_content) {
-    description_text += object.toString() + "\r\n";
-  }
-
-  return description_text;
+auto sss::extsystem::Component::CanBeDisabled() const -> bool {
+  return descriptor_.Options().testFlag(sss::extsystem::ComponentDescriptor::kCanBeDisabled);
 }
 
-auto sss::extsystem::Component::Url() -> QString {
-  auto component_metadata = metadata_["MetaData"].toObject();
-
-  return component_metadata["Url"].toString();
+auto sss::extsystem::Component::InitialisesConcurrently() const -> bool {
+  return descriptor_.Options().testFlag(sss::extsystem::ComponentDescriptor::kConcurrentInitialise);
 }
 
-auto sss::extsystem::Component::Dependencies() -> QString {
-  QString dependency_text;
-  auto component_metadata = metadata_["MetaData"].toObject();
-
-  auto license_content = component_metadata["Dependencies"].toArray();
-
-  for (auto object : license_content) {
-    auto dependency = object.toObject();
-
-    dependency_text += QString("%1 (%2)\r\n").arg(dependency["Name"].toString()).arg(dependency["Version"].toString());
+auto sss::extsystem::Component::ActivationTriggers(sss::extsystem::ComponentLoader::ActivationTrigger trigger) const
+    -> QStringList {
+  switch (trigger) {
+    case ComponentLoader::ActivationTrigger::kMode:
+      return descriptor_.ActivationModes();
+    case ComponentLoader::ActivationTrigger::kContext:
+      return descriptor_.ActivationContexts();
+    case ComponentLoader::ActivationTrigger::kCommand:
+      return descriptor_.ActivationCommands();
   }
 
-  return dependency_text;
+  return {};
 }
 
-auto sss::extsystem::Component::CanBeDisabled() -> bool {
-  auto component_metadata = metadata_["MetaData"].toObject();
-
-  if (component_metadata.contains("CanBeDisabled")) {
-    return component_metadata["CanBeDisabled"].toBool();
-  }
+auto sss::extsystem::Component::FinalisesOnExit() const -> bool {
+  return descriptor_.Options().testFlag(sss::extsystem::ComponentDescriptor::kFinaliseOnExit);
+}
 
-  return true;
+auto sss::extsystem::Component::IsLazy() const -> bool {
+  return descriptor_.Options().testFlag(sss::extsystem::ComponentDescriptor::kLazy);
 }
 
 auto sss::extsystem::Component::ValidateDependencies() -> void {
   for (auto* dependency : dependencies_) {
     if (!dependency->IsLoaded()) {
       load_flags_ |= sss::extsystem::ComponentLoader::kMissingDependency;
-    } else {
-      if (dependency->Version() < dependency_versions_[dependency]) {
-        load_flags_ |= sss::extsystem::ComponentLoader::kIncompatibleVersion;
-      }
     }
   }
 }
@@ -0,0 +1,394 @@
+#include "extsystem/ComponentDescriptor.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <cstring>
+
+#include "extsystem/EmbeddedDescriptor.h"
+
+#if defined(Q_OF_ELF)
+#include <elf.h>
+#endif
+
+namespace {
+auto JoinedStrings(const QJsonArray& array, const QString& separator) -> QString {
+  QString text;
+
+  for (auto object : array) {
+    text += object.toString() + separator;
+  }
+
+  return text;
+}
+
+auto InternedStrings(const QJsonArray& array) -> QStringList {
+  QStringList strings;
+
+  for (auto object : array) {
+    strings.append(sss::extsystem::ComponentDescriptor::Intern(object.toString()));
+  }
+
+  return strings;
+}
+
+// 嵌入式描述符中列表元素和依赖项的分隔符
+constexpr char kUnitSeparator = '\x1f';
+constexpr char kRecordSeparator = '\x1e';
+
+auto InternedStrings(const QString& field) -> QStringList {
+  QStringList strings;
+
+  if (field.isEmpty()) {
+    return strings;
+  }
+
+  for (const auto& string : field.split(kUnitSeparator)) {
+    strings.append(sss::extsystem::ComponentDescriptor::Intern(string));
+  }
+
+  return strings;
+}
+
+// 搜索标记并校验其后的头部，孤立的标记被跳过
+auto FindEmbedded(const char* data, qint64 size, sss::extsystem::ComponentDescriptor& descriptor,
+                  quint32& qt_version, bool& debug_build) -> bool {
+  auto contents = QByteArray::fromRawData(data, static_cast<int>(size));
+  auto magic = QByteArray::fromRawData(DS_EMBEDDED_DESCRIPTOR_MAGIC, sizeof(DS_EMBEDDED_DESCRIPTOR_MAGIC));
+
+  for (auto position = contents.indexOf(magic); position >= 0; position = contents.indexOf(magic, position + 1)) {
+    if (sss::extsystem::ComponentDescriptor::FromEmbedded(data + position, size - position, descriptor, qt_version,
+                                                          debug_build)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+#if defined(Q_OF_ELF)
+// 按节头表读取 ELF 文件中的一个节，只读取文件头、节头表、节名字符串表和该节本身
+template <typename FileHeader, typename SectionHeader>
+auto ReadElfSection(QFile& file, const char* section_name) -> QByteArray {
+  FileHeader file_header{};
+  auto file_header_size = static_cast<qint64>(sizeof(file_header));
+
+  if (!file.seek(0) || file.read(reinterpret_cast<char*>(&file_header), file_header_size) != file_header_size) {
+    return {};
+  }
+
+  // 节数量超过 SHN_LORESERVE 的扩展编号不用于插件，这里不处理
+
+  if (file_header.e_shentsize != sizeof(SectionHeader) || file_header.e_shnum == 0 ||
+      file_header.e_shstrndx >= file_header.e_shnum) {
+    return {};
+  }
+
+  QByteArray section_headers(static_cast<int>(file_header.e_shnum * sizeof(SectionHeader)), Qt::Uninitialized);
+
+  if (!file.seek(static_cast<qint64>(file_header.e_shoff)) ||
+      file.read(section_headers.data(), section_headers.size()) != section_headers.size()) {
+    return {};
+  }
+
+  auto section_header = [&section_headers](int index) {
+    SectionHeader header{};
+
+    std::memcpy(&header, section_headers.constData() + index * sizeof(SectionHeader), sizeof(SectionHeader));
+
+    return header;
+  };
+
+  auto read_section = [&file](const SectionHeader& header) -> QByteArray {
+    if (header.sh_type == SHT_NOBITS || static_cast<qint64>(header.sh_size) > file.size() ||
+        !file.seek(static_cast<qint64>(header.sh_offset))) {
+      return {};
+    }
+
+    return file.read(static_cast<qint64>(header.sh_size));
+  };
+
+  auto section_names = read_section(section_header(file_header.e_shstrndx));
+  auto name_size = static_cast<qint64>(std::strlen(section_name)) + 1;
+
+  for (int index = 0; index < file_header.e_shnum; index++) {
+    auto header = section_header(index);
+
+    if (static_cast<qint64>(header.sh_name) + name_size <= section_names.size() &&
+        std::memcmp(section_names.constData() + header.sh_name, section_name, static_cast<size_t>(name_size)) == 0) {
+      return read_section(header);
+    }
+  }
+
+  return {};
+}
+#endif
+
+auto ReadInterned(QDataStream& stream, QString& string) -> void {
+  stream >> string;
+  string = sss::extsystem::ComponentDescriptor::Intern(string);
+}
+
+auto ReadInterned(QDataStream& stream, QStringList& strings) -> void {
+  stream >> strings;
+
+  for (auto& string : strings) {
+    string = sss::extsystem::ComponentDescriptor::Intern(string);
+  }
+}
+}  // namespace
+
+auto sss::extsystem::ComponentDescriptor::FromMetadata(const QJsonObject& metadata, const QString& name)
+    -> ComponentDescriptor {
+  ComponentDescriptor descriptor;
+
+  auto version = metadata["Version"].toString();
+
+  descriptor.name_ = Intern(name.isEmpty() ? metadata["Name"].toString() : name);
+  descriptor.version_ = QVersionNumber::fromString(version);
+  descriptor.version_string_ =
+      QString("%1-%2 (%3)").arg(version).arg(metadata["Branch"].toString()).arg(metadata["Revision"].toString());
+  descriptor.identifier_ = Intern((descriptor.name_ + "." + metadata["Vendor"].toString()).toLower());
+  descriptor.category_ = Intern(metadata["Category"].toString());
+  descriptor.vendor_ = Intern(metadata["Vendor"].toString());
+  descriptor.license_ = JoinedStrings(metadata["License"].toArray(), QString());
+  descriptor.copyright_ = metadata["Copyright"].toString();
+  descriptor.description_ = JoinedStrings(metadata["Description"].toArray(), "\r\n");
+  descriptor.url_ = metadata["Url"].toString();
+
+  for (auto object : metadata["Dependencies"].toArray()) {
+    auto dependency = object.toObject();
+
+    descriptor.dependencies_.append(Dependency{Intern(dependency["Name"].toString()),
+                                               QVersionNumber::fromString(dependency["Version"].toString())});
+  }
+
+  auto activation = metadata["Activation"].toObject();
+
+  descriptor.activation_modes_ = InternedStrings(activation["Modes"].toArray());
+  descriptor.activation_contexts_ = InternedStrings(activation["Contexts"].toArray());
+  descriptor.activation_commands_ = InternedStrings(activation["Commands"].toArray());
+
+  descriptor.flags_.setFlag(kCanBeDisabled, metadata["CanBeDisabled"].toBool(true));
+  descriptor.flags_.setFlag(kConcurrentInitialise, metadata["ConcurrentInitialise"].toBool(false));
+  descriptor.flags_.setFlag(kFinaliseOnExit, metadata["FinaliseOnExit"].toBool(false));
+  descriptor.flags_.setFlag(kLazy, !descriptor.activation_modes_.isEmpty() ||
+                                       !descriptor.activation_contexts_.isEmpty() ||
+                                       !descriptor.activation_commands_.isEmpty());
+
+  return descriptor;
+}
+
+auto sss::extsystem::ComponentDescriptor::FromEmbedded(const char* data, qint64 size, ComponentDescriptor& descriptor,
+                                                       quint32& qt_version, bool& debug_build) -> bool {
+  using Field = sss::extsystem::EmbeddedDescriptorField;
+
+  sss::extsystem::EmbeddedDescriptorHeader header{};
+
+  if (size < static_cast<qint64>(sizeof(header))) {
+    return false;
+  }
+
+  std::memcpy(&header, data, sizeof(header));
+
+  if (std::memcmp(header.magic, DS_EMBEDDED_DESCRIPTOR_MAGIC, sizeof(header.magic)) != 0 ||
+      header.format != sss::extsystem::kEmbeddedDescriptorFormat ||
+      static_cast<qint64>(header.fields_size) > size - static_cast<qint64>(sizeof(header))) {
+    return false;
+  }
+
+  // 字段区以 '\0' 分隔，末尾是字符串字面量的结束符
+
+  auto fields = QByteArray::fromRawData(data + sizeof(header), static_cast<int>(header.fields_size)).split('\0');
+
+  if (fields.size() < static_cast<int>(Field::kCount)) {
+    return false;
+  }
+
+  auto field = [&fields](Field index) { return QString::fromUtf8(fields.at(static_cast<int>(index))); };
+
+  descriptor = ComponentDescriptor();
+
+  auto version = field(Field::kVersion);
+
+  descriptor.name_ = Intern(field(Field::kName));
+  descriptor.version_ = QVersionNumber::fromString(version);
+  descriptor.version_string_ =
+      QString("%1-%2 (%3)").arg(version).arg(field(Field::kBranch)).arg(field(Field::kRevision));
+  descriptor.identifier_ = Intern((descriptor.name_ + "." + field(Field::kVendor)).toLower());
+  descriptor.category_ = Intern(field(Field::kCategory));
+  descriptor.vendor_ = Intern(field(Field::kVendor));
+  descriptor.license_ = field(Field::kLicense).remove(kUnitSeparator);
+  descriptor.copyright_ = field(Field::kCopyright);
+  descriptor.url_ = field(Field::kUrl);
+
+  auto description = field(Field::kDescription);
+
+  if (!description.isEmpty()) {
+    for (const auto& line : description.split(kUnitSeparator)) {
+      descriptor.description_ += line + "\r\n";
+    }
+  }
+
+  auto dependencies = field(Field::kDependencies);
+
+  if (!dependencies.isEmpty()) {
+    for (const auto& record : dependencies.split(kRecordSeparator)) {
+      auto parts = record.split(kUnitSeparator);
+
+      descriptor.dependencies_.append(
+          Dependency{Intern(parts.value(0)), QVersionNumber::fromString(parts.value(1))});
+    }
+  }
+
+  descriptor.activation_modes_ = InternedStrings(field(Field::kActivationModes));
+  descriptor.activation_contexts_ = InternedStrings(field(Field::kActivationContexts));
+  descriptor.activation_commands_ = InternedStrings(field(Field::kActivationCommands));
+
+  descriptor.flags_ = Flags(QFlag(field(Field::kOptions).toInt()));
+  descriptor.flags_.setFlag(kLazy, !descriptor.activation_modes_.isEmpty() ||
+                                       !descriptor.activation_contexts_.isEmpty() ||
+                                       !descriptor.activation_commands_.isEmpty());
+
+  qt_version = header.qt_version;
+  debug_build = header.debug_build != 0;
+
+  return !descriptor.name_.isEmpty();
+}
+
+auto sss::extsystem::ComponentDescriptor::FromLibrary(const QString& library_filename, ComponentDescriptor& descriptor,
+                                                      quint32& qt_version, bool& debug_build) -> bool {
+  QFile library_file(library_filename);
+
+  if (!library_file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+#if defined(Q_OF_ELF)
+  // ELF 库只读取 .dsdescriptor 节，不需要映射和搜索整个文件
+
+  unsigned char identification[EI_NIDENT] = {};
+
+  if (library_file.read(reinterpret_cast<char*>(identification), EI_NIDENT) == EI_NIDENT &&
+      std::memcmp(identification, ELFMAG, SELFMAG) == 0) {
+    auto native_data = Q_BYTE_ORDER == Q_LITTLE_ENDIAN ? ELFDATA2LSB : ELFDATA2MSB;
+
+    if (identification[EI_DATA] != native_data) {
+      return false;
+    }
+
+    QByteArray section;
+
+    if (identification[EI_CLASS] == ELFCLASS64) {
+      section = ReadElfSection<Elf64_Ehdr, Elf64_Shdr>(library_file, ".dsdescriptor");
+    } else if (identification[EI_CLASS] == ELFCLASS32) {
+      section = ReadElfSection<Elf32_Ehdr, Elf32_Shdr>(library_file, ".dsdescriptor");
+    }
+
+    return FindEmbedded(section.constData(), section.size(), descriptor, qt_version, debug_build);
+  }
+#endif
+
+  // 与 Qt 在非 ELF 平台上查找插件元数据的方式相同，映射文件并搜索标记
+
+  auto size = library_file.size();
+  const auto* data = reinterpret_cast<const char*>(library_file.map(0, size));
+
+  if (data == nullptr) {
+    return false;
+  }
+
+  return FindEmbedded(data, size, descriptor, qt_version, debug_build);
+}
+
+auto sss::extsystem::ComponentDescriptor::Intern(const QString& string) -> QString {
+  static QMutex intern_mutex;
+  static QSet<QString> interned_strings;
+
+  if (string.isEmpty()) {
+    return {};
+  }
+
+  QMutexLocker locker(&intern_mutex);
+
+  auto string_iterator = interned_strings.constFind(string);
+
+  if (string_iterator != interned_strings.constEnd()) {
+    return *string_iterator;
+  }
+
+  interned_strings.insert(string);
+
+  return string;
+}
+
+auto sss::extsystem::ComponentDescriptor::operator==(const ComponentDescriptor& other) const -> bool {
+  auto same_dependencies = dependencies_.size() == other.dependencies_.size();
+
+  for (int index = 0; same_dependencies && index < dependencies_.size(); index++) {
+    same_dependencies = dependencies_.at(index).name == other.dependencies_.at(index).name &&
+                        dependencies_.at(index).version == other.dependencies_.at(index).version;
+  }
+
+  return same_dependencies && name_ == other.name_ && version_ == other.version_ &&
+         version_string_ == other.version_string_ && identifier_ == other.identifier_ &&
+         category_ == other.category_ && vendor_ == other.vendor_ && license_ == other.license_ &&
+         copyright_ == other.copyright_ && description_ == other.description_ && url_ == other.url_ &&
+         activation_modes_ == other.activation_modes_ && activation_contexts_ == other.activation_contexts_ &&
+         activation_commands_ == other.activation_commands_ && flags_ == other.flags_;
+}
+
+auto sss::extsystem::operator<<(QDataStream& stream, const ComponentDescriptor& descriptor) -> QDataStream& {
+  stream << descriptor.name_ << descriptor.version_ << descriptor.version_string_ << descriptor.identifier_
+         << descriptor.category_ << descriptor.vendor_ << descriptor.license_ << descriptor.copyright_
+         << descriptor.description_ << descriptor.url_;
+
+  stream << static_cast<qint32>(descriptor.dependencies_.size());
+
+  for (const auto& dependency : descriptor.dependencies_) {
+    stream << dependency.name << dependency.version;
+  }
+
+  stream << descriptor.activation_modes_ << descriptor.activation_contexts_ << descriptor.activation_commands_
+         << static_cast<quint32>(descriptor.flags_);
+
+  return stream;
+}
+
+auto sss::extsystem::operator>>(QDataStream& stream, ComponentDescriptor& descriptor) -> QDataStream& {
+  descriptor = ComponentDescriptor();
+
+  ReadInterned(stream, descriptor.name_);
+  stream >> descriptor.version_ >> descriptor.version_string_;
+  ReadInterned(stream, descriptor.identifier_);
+  ReadInterned(stream, descriptor.category_);
+  ReadInterned(stream, descriptor.vendor_);
+  stream >> descriptor.license_ >> descriptor.copyright_ >> descriptor.description_ >> descriptor.url_;
+
+  qint32 dependency_count = 0;
+
+  stream >> dependency_count;
+
+  for (qint32 index = 0; index < dependency_count && stream.status() == QDataStream::Ok; index++) {
+    Dependency dependency;
+
+    ReadInterned(stream, dependency.name);
+    stream >> dependency.version;
+
+    descriptor.dependencies_.append(dependency);
+  }
+
+  ReadInterned(stream, descriptor.activation_modes_);
+  ReadInterned(stream, descriptor.activation_contexts_);
+  ReadInterned(stream, descriptor.activation_commands_);
+
+  quint32 flags = 0;
+
+  stream >> flags;
+
+  descriptor.flags_ = Flags(QFlag(static_cast<int>(flags)));
+
+  return stream;
+}
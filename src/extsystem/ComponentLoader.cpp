@@ -2,7 +2,14 @@
 
 #include <spdlog/spdlog.h>
 
+#include <QCoreApplication>
 #include <QDirIterator>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QFutureWatcher>
+#include <QHash>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QLibrary>
@@ -10,10 +17,25 @@
 #include <QMap>
 #include <QMetaEnum>
 #include <QPluginLoader>
+#include <QRunnable>
+#include <QSet>
+#include <QThread>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVector>
 #include <QtGlobal>
-
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "ComponentMetadataCache.h"
+#include "DependencyResolver.h"
+#include "LibraryPrefetcher.h"
 #include "extsystem/Component.h"
 #include "extsystem/IComponent.h"
+#include "extsystem/StartupTrace.h"
 
 constexpr unsigned int kQtMajorBitMask = 0xFFFF0000;
 constexpr unsigned int kQtMajorBitShift = 16;
@@ -22,16 +44,215 @@ constexpr unsigned int kQtMinorBitShift = 8;
 constexpr unsigned int kQtPatchBitMask = 0x000000FF;
 constexpr unsigned int kQtPatchBitShift = 0;
 
+// 组件文件夹最后一次变化后等待多长时间再安装新组件（毫秒）
+constexpr int kInstallSettleTime = 1000;
+
+namespace {
+// 返回识别库文件变化的大小和修改时间
+auto LibraryStamp(const QString& filename) -> QPair<qint64, qint64> {
+  auto stamp = sss::extsystem::ComponentMetadataCache::Stamp(filename);
+
+  return {stamp.size, stamp.modified};
+}
+}  // namespace
+
 sss::extsystem::ComponentLoader::ComponentLoader(QObject* parent) : QObject(parent) {}
 
 sss::extsystem::ComponentLoader::~ComponentLoader() { UnloadComponents(); }
 
 auto sss::extsystem::ComponentLoader::AddComponents(const QString& component_folder) -> void {
-  auto application_debug_build = QLibraryInfo::isDebugBuild();
+  auto application_debug_build = false;
+  auto application_qt_version = QVersionNumber();
+
+  applicationBuild(application_debug_build, application_qt_version);
+
+  SPDLOG_INFO("Searching for components in folder: {}", component_folder.toStdString());
+
+  // 查找兼容的组件，并创建要考虑加载的组件列表
+
+  auto candidates = candidateLibraries(component_folder);
+  auto library_metadata = readAllMetadata(candidates, false);
+
+  for (int index = 0; index < candidates.size(); index++) {
+    addComponent(candidates.at(index), library_metadata[static_cast<size_t>(index)], application_debug_build,
+                 application_qt_version);
+  }
+}
+
+auto sss::extsystem::ComponentLoader::AddComponents(const QStringList& component_folders) -> void {
+  auto application_debug_build = false;
+  auto application_qt_version = QVersionNumber();
+
+  applicationBuild(application_debug_build, application_qt_version);
+
+  // 1. 按文件夹顺序枚举候选库文件，枚举顺序即合并顺序，保证名称冲突检测的结果与串行扫描一致
+
+  QStringList candidates;
+
+  for (const auto& component_folder : component_folders) {
+    SPDLOG_INFO("Searching for components in folder: {}", component_folder.toStdString());
+
+    candidates.append(candidateLibraries(component_folder));
+  }
+
+  // 2. 在线程池中并行读取嵌入式描述符，没有描述符的库再读取插件元数据
+
+  auto library_metadata = readAllMetadata(candidates, true);
+
+  // 3. 在调用线程上按枚举顺序合并结果
+
+  for (int index = 0; index < candidates.size(); index++) {
+    addComponent(candidates.at(index), library_metadata[static_cast<size_t>(index)], application_debug_build,
+                 application_qt_version);
+  }
+}
+
+auto sss::extsystem::ComponentLoader::AddStaticComponents() -> void {
+  auto application_debug_build = false;
+  auto application_qt_version = QVersionNumber();
+
+  applicationBuild(application_debug_build, application_qt_version);
+
+  for (const auto& static_plugin : QPluginLoader::staticPlugins()) {
+    auto meta_data_object = static_plugin.metaData();
+
+    if (meta_data_object.value("IID").toString() != SSSComponentInterfaceIID) {
+      continue;
+    }
+
+    auto component_filename = "static:" + meta_data_object.value("className").toString();
+
+    SPDLOG_INFO("Found static component: {}", component_filename.toStdString());
+
+    auto* component =
+        addComponent(component_filename, meta_data_object, application_debug_build, application_qt_version);
+
+    if (component != nullptr) {
+      static_instances_.insert(component, static_plugin.instance);
+    }
+  }
+}
+
+auto sss::extsystem::ComponentLoader::SetMetadataCacheFile(const QString& cache_filename) -> void {
+  if (cache_filename.isEmpty()) {
+    metadata_cache_.reset();
+    return;
+  }
+
+  metadata_cache_ = std::make_unique<sss::extsystem::ComponentMetadataCache>(cache_filename);
+  metadata_cache_->Load();
+}
+
+auto sss::extsystem::ComponentLoader::readAllMetadata(const QStringList& candidates, bool parallel)
+    -> std::vector<LibraryMetadata> {
+  std::vector<LibraryMetadata> library_metadata(static_cast<size_t>(candidates.size()));
+  QVector<sss::extsystem::ComponentMetadataCache::FileStamp> stamps(candidates.size());
+  QList<int> pending;
+
+  // 每个任务只写入自己的槽位，parallel 为 false 或任务只有一个时在调用线程上执行
+  auto run_tasks = [parallel](const QList<int>& indices, const std::function<void(int)>& task) {
+    if (parallel && indices.size() > 1) {
+      QThreadPool scan_pool;
+
+      scan_pool.setMaxThreadCount(qMin(QThread::idealThreadCount(), static_cast<int>(indices.size())));
+
+      for (auto index : indices) {
+        scan_pool.start(QRunnable::create([&task, index]() { task(index); }));
+      }
+
+      scan_pool.waitForDone();
+    } else {
+      for (auto index : indices) {
+        task(index);
+      }
+    }
+  };
+
+  QElapsedTimer scan_timer;
+
+  scan_timer.start();
+
+  // 1. 先按文件的身份标识查找缓存，只有变化过的文件才需要打开
+
+  auto* metadata_slots = library_metadata.data();
+
+  for (int index = 0; index < candidates.size(); index++) {
+    sss::extsystem::ComponentMetadataCache::Record record;
+
+    if (!metadata_cache_ || !metadata_cache_->Lookup(candidates.at(index), stamps[index], record)) {
+      pending.append(index);
+      continue;
+    }
+
+    auto& slot = metadata_slots[index];
+
+    slot.metadata = record.metadata;
+    slot.descriptor = record.descriptor;
+    slot.qt_version = record.qt_version;
+    slot.debug_build = record.debug_build;
+    slot.has_descriptor = record.has_descriptor;
+  }
+
+  // 2. 读取构建时嵌入的组件描述符，不需要解析 JSON；没有描述符的库（第三方插件）再读取插件元数据
+
+  run_tasks(pending, [&candidates, metadata_slots](int index) {
+    auto& slot = metadata_slots[index];
+
+    {
+      sss::extsystem::StartupTrace::Span trace_span(
+          [&](QJsonObject& args) {
+            args.insert("library", candidates.at(index));
+            return "Read descriptor " + QFileInfo(candidates.at(index)).fileName();
+          },
+          "scan");
+
+      slot.has_descriptor = sss::extsystem::ComponentDescriptor::FromLibrary(candidates.at(index), slot.descriptor,
+                                                                             slot.qt_version, slot.debug_build);
+    }
+
+    if (!slot.has_descriptor) {
+      slot.metadata = readMetadata(candidates.at(index));
+    }
+  });
+
+  auto descriptor_count = 0;
+
+  for (auto index : pending) {
+    if (library_metadata[static_cast<size_t>(index)].has_descriptor) {
+      descriptor_count++;
+    }
+  }
+
+  SPDLOG_INFO("Read {} embedded descriptors and the metadata of {} libraries in {}ms", descriptor_count,
+              pending.size() - descriptor_count, scan_timer.elapsed());
+
+  if (metadata_cache_) {
+    for (auto index : pending) {
+      const auto& slot = library_metadata[static_cast<size_t>(index)];
+
+      sss::extsystem::ComponentMetadataCache::Record record{slot.metadata, slot.descriptor, slot.qt_version,
+                                                            slot.debug_build, slot.has_descriptor};
+
+      metadata_cache_->Insert(candidates.at(index), stamps.at(index), record);
+    }
+
+    metadata_cache_->Save();
+
+    SPDLOG_INFO("Component metadata cache: {} hits, {} misses (total {} hits, {} misses)",
+                candidates.size() - pending.size(), pending.size(), metadata_cache_->Hits(),
+                metadata_cache_->Misses());
+  }
+
+  return library_metadata;
+}
+
+auto sss::extsystem::ComponentLoader::applicationBuild(bool& application_debug_build,
+                                                       QVersionNumber& application_qt_version) -> void {
+  application_debug_build = QLibraryInfo::isDebugBuild();
 #if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
-  auto application_qt_version = QLibraryInfo::version();
+  application_qt_version = QLibraryInfo::version();
 #else
-  auto application_qt_version = QVersionNumber::fromString(qVersion());
+  application_qt_version = QVersionNumber::fromString(qVersion());
 #endif
 
 #if defined(Q_OS_UNIX) || ((defined(Q_OS_WIN) && defined(__MINGW32__)))
@@ -53,143 +274,228 @@ auto sss::extsystem::ComponentLoader::AddComponents(const QString& component_fol
   }
 #endif
 #endif
-  // SPDLOG_INFO(QString("Searching folder for components %1").arg(component_folder).toStdString());
+}
 
-  SPDLOG_INFO("Searching for components in folder: {}", component_folder.toStdString());
+auto sss::extsystem::ComponentLoader::candidateLibraries(const QString& component_folder) -> QStringList {
+  QStringList candidates;
 
   QDirIterator dir(component_folder);
 
-  // 查找兼容的组件，并创建要考虑加载的组件列表
-
   while (dir.hasNext()) {
     dir.next();
 
-    auto component_filename = dir.fileInfo().absoluteFilePath();
-
     if (dir.fileInfo().isDir()) {
       continue;
     }
 
-    bool is_lib = QLibrary::isLibrary(component_filename);
-    if (!is_lib) {
+    auto component_filename = dir.fileInfo().absoluteFilePath();
+
+    if (!QLibrary::isLibrary(component_filename)) {
       continue;
     }
 
-    auto* plugin_loader = new QPluginLoader(component_filename);
+    candidates.append(component_filename);
+  }
+
+  return candidates;
+}
 
-    SPDLOG_DEBUG("Processing library: {}", component_filename.toStdString());
+auto sss::extsystem::ComponentLoader::readMetadata(const QString& component_filename) -> QJsonObject {
+  SPDLOG_DEBUG("Processing library: {}", component_filename.toStdString());
 
-    auto meta_data_object = plugin_loader->metaData();
+  sss::extsystem::StartupTrace::Span trace_span(
+      [&](QJsonObject& args) {
+        args.insert("library", component_filename);
+        return "Read metadata " + QFileInfo(component_filename).fileName();
+      },
+      "scan");
 
-    if (meta_data_object.isEmpty()) {
-      SPDLOG_DEBUG("Library {} has empty metadata", component_filename.toStdString());
-      delete plugin_loader;
-      continue;
-    }
+  QPluginLoader plugin_loader(component_filename);
 
-    auto debug_build = meta_data_object.value("debug");
-    auto qt_version = meta_data_object.value("version");
+  return plugin_loader.metaData();
+}
 
-    SPDLOG_DEBUG("Library {} metadata keys: {}", component_filename.toStdString(),
-                QStringList(meta_data_object.keys()).join(",").toStdString());
+auto sss::extsystem::ComponentLoader::addComponent(const QString& component_filename,
+                                                   const QJsonObject& meta_data_object, bool application_debug_build,
+                                                   const QVersionNumber& application_qt_version)
+    -> sss::extsystem::Component* {
+  if (meta_data_object.isEmpty()) {
+    SPDLOG_DEBUG("Library {} has empty metadata", component_filename.toStdString());
+    return nullptr;
+  }
 
-    // 尝试从 "MetaData" 和直接在根目录中获取组件元数据
-    auto component_metadata = meta_data_object.value("MetaData");
+  // 按旧版 IComponent 头文件构建的组件的虚函数表布局不同，不能加载
 
-    // 如果 MetaData 不存在，使用根元数据对象
-    if (component_metadata.isNull() || component_metadata.isUndefined()) {
-      component_metadata = QJsonValue(meta_data_object);
-    }
+  auto interface_id = meta_data_object.value("IID").toString();
 
-    if (debug_build.isNull() || qt_version.isNull() || (component_metadata.type() != QJsonValue::Object)) {
-      SPDLOG_DEBUG("Library {} missing required metadata fields", component_filename.toStdString());
-      delete plugin_loader;
-      continue;
-    }
+  if (interface_id.startsWith("sss.IComponent/") && interface_id != SSSComponentInterfaceIID) {
+    SPDLOG_WARN("Library {} was built against interface {}, {} is required", component_filename.toStdString(),
+                interface_id.toStdString(), SSSComponentInterfaceIID);
+    return nullptr;
+  }
 
-    // 出于调试目的，即使存在调试/发布不匹配也允许加载组件
-    // if (debug_build != application_debug_build) {
-    //   SPDLOG_INFO(QString("Library %1 debug flag mismatch").arg(component_filename).toStdString());
-    //   delete plugin_loader;
-    //   continue;
-    // }
+  auto debug_build = meta_data_object.value("debug");
+  auto qt_version = meta_data_object.value("version");
 
-    // 仍然记录关于不匹配的警告
-    if (debug_build != application_debug_build) {
-      SPDLOG_WARN("Component {} debug/release mode mismatch with application. This may cause instability.", component_filename.toStdString());
-    }
+  SPDLOG_DEBUG("Library {} metadata keys: {}", component_filename.toStdString(),
+               QStringList(meta_data_object.keys()).join(",").toStdString());
 
-    // 检查 "Name" 和 "name"，因为大小写敏感可能是个问题
-    auto component_metadata_obj = component_metadata.toObject();
-    auto component_name = component_metadata_obj.value("Name");
+  // 尝试从 "MetaData" 和直接在根目录中获取组件元数据
+  auto component_metadata = meta_data_object.value("MetaData");
 
-    // 如果 "Name" 不存在或为空，尝试小写的 "name"
-    if (component_name.isNull() || component_name.toString().isEmpty()) {
-      component_name = component_metadata_obj.value("name");
-    }
+  // 如果 MetaData 不存在，使用根元数据对象
+  if (component_metadata.isNull() || component_metadata.isUndefined()) {
+    component_metadata = QJsonValue(meta_data_object);
+  }
 
-    // 如果仍然没有名称，使用插件元数据中的 className
-    if (component_name.isNull() || component_name.toString().isEmpty()) {
-      component_name = component_metadata_obj.value("className");
-      SPDLOG_INFO("Library {} using className as component name: {}", component_filename.toStdString(),
-                  component_name.isNull() ? "NULL" : component_name.toString().toStdString());
-    }
+  if (debug_build.isNull() || qt_version.isNull() || (component_metadata.type() != QJsonValue::Object)) {
+    SPDLOG_DEBUG("Library {} missing required metadata fields", component_filename.toStdString());
+    return nullptr;
+  }
 
-    SPDLOG_INFO("Library {} component name: {}", component_filename.toStdString(),
+  // 出于调试目的，即使存在调试/发布不匹配也允许加载组件
+  // if (debug_build != application_debug_build) {
+  //   SPDLOG_INFO(QString("Library %1 debug flag mismatch").arg(component_filename).toStdString());
+  //   return;
+  // }
+
+  // 仍然记录关于不匹配的警告
+  if (debug_build != application_debug_build) {
+    SPDLOG_WARN("Component {} debug/release mode mismatch with application. This may cause instability.",
+                component_filename.toStdString());
+  }
+
+  // 检查 "Name" 和 "name"，因为大小写敏感可能是个问题
+  auto component_metadata_obj = component_metadata.toObject();
+  auto component_name = component_metadata_obj.value("Name");
+
+  // 如果 "Name" 不存在或为空，尝试小写的 "name"
+  if (component_name.isNull() || component_name.toString().isEmpty()) {
+    component_name = component_metadata_obj.value("name");
+  }
+
+  // 如果仍然没有名称，使用插件元数据中的 className
+  if (component_name.isNull() || component_name.toString().isEmpty()) {
+    component_name = meta_data_object.value("className");
+    SPDLOG_INFO("Library {} using className as component name: {}", component_filename.toStdString(),
                 component_name.isNull() ? "NULL" : component_name.toString().toStdString());
-    SPDLOG_INFO("Library {} all metadata: {}", component_filename.toStdString(),
-                QString(QJsonDocument(component_metadata_obj).toJson()).toStdString());
+  }
 
-    if (component_name.isNull() || component_name.toString().isEmpty()) {
-      SPDLOG_INFO("Library {} missing name", component_filename.toStdString());
-      delete plugin_loader;
-      continue;
-    }
+  SPDLOG_INFO("Library {} component name: {}", component_filename.toStdString(),
+              component_name.isNull() ? "NULL" : component_name.toString().toStdString());
+  SPDLOG_INFO("Library {} all metadata: {}", component_filename.toStdString(),
+              QString(QJsonDocument(component_metadata_obj).toJson()).toStdString());
 
-    auto component_qt_major = static_cast<int>((qt_version.toVariant().toUInt() & kQtMajorBitMask) >> kQtMajorBitShift);
-    auto component_qt_minor = static_cast<int>((qt_version.toVariant().toUInt() & kQtMinorBitMask) >> kQtMinorBitShift);
-    auto component_qt_patch = static_cast<int>((qt_version.toVariant().toUInt() & kQtPatchBitMask) >> kQtPatchBitShift);
+  if (component_name.isNull() || component_name.toString().isEmpty()) {
+    SPDLOG_INFO("Library {} missing name", component_filename.toStdString());
+    return nullptr;
+  }
 
-    auto component_qt_version = QVersionNumber(component_qt_major, component_qt_minor, component_qt_patch);
+  if (isStaticallyLinked(component_filename, component_name.toString())) {
+    return nullptr;
+  }
 
-    auto application_qt_version_str = QString("%1.%2.%3")
-                                          .arg(application_qt_version.majorVersion())
-                                          .arg(application_qt_version.minorVersion())
-                                          .arg(application_qt_version.microVersion());
-    auto component_qt_version_str = QString("%1.%2.%3")
-                                        .arg(component_qt_version.majorVersion())
-                                        .arg(component_qt_version.minorVersion())
-                                        .arg(component_qt_version.microVersion());
-    SPDLOG_INFO("Library {} application Qt version: {}, component Qt version: {}", component_filename.toStdString(),
-                application_qt_version_str.toStdString(), component_qt_version_str.toStdString());
+  auto* component = new sss::extsystem::Component(component_name.toString(), component_filename, meta_data_object);
 
-    auto* component = new sss::extsystem::Component(component_name.toString(), component_filename, meta_data_object);
+  return registerComponent(component, qt_version.toVariant().toUInt(), application_qt_version);
+}
 
-    connect(this, &sss::extsystem::ComponentLoader::destroyed, [=](QObject*) { delete component; });
+auto sss::extsystem::ComponentLoader::addComponent(const QString& component_filename,
+                                                   const LibraryMetadata& library_metadata,
+                                                   bool application_debug_build,
+                                                   const QVersionNumber& application_qt_version)
+    -> sss::extsystem::Component* {
+  if (!library_metadata.has_descriptor) {
+    return addComponent(component_filename, library_metadata.metadata, application_debug_build,
+                        application_qt_version);
+  }
 
-    if (component_qt_version.majorVersion() != application_qt_version.majorVersion()) {
-      component->load_flags_.setFlag(LoadFlag::kIncompatibleQtVersion);
-      SPDLOG_WARN("Library {} incompatible Qt version", component_filename.toStdString());
-    }
+  // 嵌入式描述符已在构建时校验，名称总是存在
 
-    if (component_search_list_.contains(component_name.toString())) {
-      component->load_flags_.setFlag(LoadFlag::kNameClash);
-      SPDLOG_DEBUG("Library {} name clash", component_filename.toStdString());
-    }
+  const auto& descriptor = library_metadata.descriptor;
 
-    component_search_list_[component_name.toString()] = component;
-    SPDLOG_DEBUG("Library {} added to component_search_list as {}", component_filename.toStdString(),
-                component_name.toString().toStdString());
+  SPDLOG_DEBUG("Library {} has embedded descriptor for component {}", component_filename.toStdString(),
+               descriptor.Name().toStdString());
 
-    delete plugin_loader;
+  if (library_metadata.debug_build != application_debug_build) {
+    SPDLOG_WARN("Component {} debug/release mode mismatch with application. This may cause instability.",
+                component_filename.toStdString());
+  }
+
+  if (isStaticallyLinked(component_filename, descriptor.Name())) {
+    return nullptr;
+  }
+
+  auto* component = new sss::extsystem::Component(component_filename, descriptor);
+
+  return registerComponent(component, library_metadata.qt_version, application_qt_version);
+}
+
+auto sss::extsystem::ComponentLoader::isStaticallyLinked(const QString& component_filename,
+                                                         const QString& component_name) -> bool {
+  // 静态链接的组件优先，不再加载同名的共享库
+
+  auto* existing_component = component_search_list_.value(component_name);
+
+  if (existing_component == nullptr || !static_instances_.contains(existing_component)) {
+    return false;
+  }
+
+  SPDLOG_INFO("Library {} ignored, component {} is linked statically", component_filename.toStdString(),
+              component_name.toStdString());
+  added_libraries_.insert(component_filename);
+
+  return true;
+}
+
+auto sss::extsystem::ComponentLoader::registerComponent(sss::extsystem::Component* component, quint32 qt_version,
+                                                        const QVersionNumber& application_qt_version)
+    -> sss::extsystem::Component* {
+  auto component_filename = component->Filename();
+  auto component_name = component->Name();
+
+  auto component_qt_major = static_cast<int>((qt_version & kQtMajorBitMask) >> kQtMajorBitShift);
+  auto component_qt_minor = static_cast<int>((qt_version & kQtMinorBitMask) >> kQtMinorBitShift);
+  auto component_qt_patch = static_cast<int>((qt_version & kQtPatchBitMask) >> kQtPatchBitShift);
+
+  auto component_qt_version = QVersionNumber(component_qt_major, component_qt_minor, component_qt_patch);
+
+  auto application_qt_version_str = QString("%1.%2.%3")
+                                        .arg(application_qt_version.majorVersion())
+                                        .arg(application_qt_version.minorVersion())
+                                        .arg(application_qt_version.microVersion());
+  auto component_qt_version_str = QString("%1.%2.%3")
+                                      .arg(component_qt_version.majorVersion())
+                                      .arg(component_qt_version.minorVersion())
+                                      .arg(component_qt_version.microVersion());
+  SPDLOG_INFO("Library {} application Qt version: {}, component Qt version: {}", component_filename.toStdString(),
+              application_qt_version_str.toStdString(), component_qt_version_str.toStdString());
+
+  connect(this, &sss::extsystem::ComponentLoader::destroyed, [=](QObject*) { delete component; });
+
+  added_libraries_.insert(component_filename);
+
+  if (component_qt_version.majorVersion() != application_qt_version.majorVersion()) {
+    component->load_flags_.setFlag(LoadFlag::kIncompatibleQtVersion);
+    SPDLOG_WARN("Library {} incompatible Qt version", component_filename.toStdString());
+  }
+
+  if (component_search_list_.contains(component_name)) {
+    component->load_flags_.setFlag(LoadFlag::kNameClash);
+    SPDLOG_DEBUG("Library {} name clash", component_filename.toStdString());
   }
+
+  component_search_list_[component_name] = component;
+  SPDLOG_DEBUG("Library {} added to component_search_list as {}", component_filename.toStdString(),
+               component_name.toStdString());
+
+  return component;
 }
 
 auto sss::extsystem::ComponentLoader::LoadComponents(
     std::function<bool(sss::extsystem::Component*)> load_function)  // NOLINT
     -> void {
   QList<sss::extsystem::Component*> component_load_list;
-  QList<sss::extsystem::Component*> resolved_load_list;
 
   // 查找并添加来自搜索的依赖项
 
@@ -204,184 +510,800 @@ auto sss::extsystem::ComponentLoader::LoadComponents(
       continue;
     }
 
-    auto metadata = component->Metadata().value("MetaData").toObject();
+    linkDependencies(component);
+
+    if (!component->load_flags_) {
+      component_load_list.append(component);
+    }
+  }
 
-    auto dependencies = metadata.value("Dependencies").toArray();
+  // 解析依赖项以创建加载顺序，同时检测循环依赖并检查版本约束
 
-    for (auto dependency : dependencies) {
-      auto dependency_name = dependency.toObject().value("Name").toString();
-      auto dependency_version = dependency.toObject().value("Version").toString();
+  auto resolved_load_list = sss::extsystem::DependencyResolver::Resolve(component_load_list);
 
-      if (component_search_list_.contains(dependency_name)) {
-        component->AddDependency(component_search_list_[dependency_name],
-                                 QVersionNumber::fromString(dependency_version));
-      } else {
-        component->missing_dependencies_.append(dependency_name);
-        component->load_flags_ |= LoadFlag::kMissingDependency;
-      }
+  SPDLOG_DEBUG("Final component load order:");
+  for (auto* component : resolved_load_list) {
+    SPDLOG_DEBUG("- {}", component->Name().toStdString());
+  }
+
+  // 声明了激活触发器的组件延迟加载，除非有立即加载的组件（直接或间接）依赖它
+
+  QSet<sss::extsystem::Component*> required_components;
+
+  for (auto component_iterator = resolved_load_list.rbegin(); component_iterator != resolved_load_list.rend();
+       component_iterator++) {
+    auto* component = *component_iterator;
+
+    if (component->IsLazy() && !required_components.contains(component)) {
+      continue;
     }
 
-    if (!component->load_flags_) {
-      component_load_list.append(component);
+    for (auto* dependency : component->dependencies_) {
+      required_components.insert(dependency);
     }
   }
 
-  // 解析依赖项以创建加载顺序
+  // 加载并初始化我们已满足依赖项的组件
 
-  // 清除现有的 resolved_load_list 以确保依赖项解析重新开始
-  resolved_load_list.clear();
+  load_function_ = load_function;
 
-  QList<sss::extsystem::Component*> processed_list_global;  // 使用全局处理列表进行跨所有调用的循环检测
+  QList<sss::extsystem::Component*> startup_components;
+
+  for (auto* component : resolved_load_list) {
+    if (component->load_flags_ == 0 && component->IsLazy() && !required_components.contains(component)) {
+      component->load_flags_.setFlag(sss::extsystem::ComponentLoader::kDeferred);
+      deferred_components_.append(component);
 
-  for (auto* current : component_load_list) {
-    if (!resolved_load_list.contains(current) && !processed_list_global.contains(current)) {
-      QList<sss::extsystem::Component*> current_processed_list;  // 此 processed_list 用于当前递归堆栈
-      resolve(current, resolved_load_list, current_processed_list);
+      SPDLOG_INFO("Component {} is deferred until one of its activation triggers fires.",
+                  component->Name().toStdString());
+      continue;
     }
+
+    startup_components.append(component);
   }
 
-  SPDLOG_DEBUG("Final component load order:");
-  for (auto* component : resolved_load_list) {
-    SPDLOG_DEBUG("- {}", component->Name().toStdString());
+  loadAndInitialiseComponents(startup_components);
+}
+
+auto sss::extsystem::ComponentLoader::SetLibraryPrefetch(bool enabled) -> void { library_prefetch_ = enabled; }
+
+auto sss::extsystem::ComponentLoader::WatchComponentFolders(const QStringList& component_folders) -> void {
+  if (folder_watcher_ == nullptr) {
+    folder_watcher_ = new QFileSystemWatcher(this);
+    install_timer_ = new QTimer(this);
+
+    // 复制库文件会产生多次变化通知，等待一段时间没有新的变化后再安装
+    install_timer_->setSingleShot(true);
+    install_timer_->setInterval(kInstallSettleTime);
+
+    connect(folder_watcher_, &QFileSystemWatcher::directoryChanged, install_timer_,
+            qOverload<>(&QTimer::start));
+    connect(install_timer_, &QTimer::timeout, this, [this]() { InstallComponents(watched_folders_); });
   }
 
-  // 加载我们已满足依赖项的组件
+  for (const auto& component_folder : component_folders) {
+    if (watched_folders_.contains(component_folder)) {
+      continue;
+    }
 
-  for (auto* component : resolved_load_list) {
-    if (component->load_flags_ != 0) {
-      SPDLOG_WARN("Component {} was not loaded because of pre-existing flags: {}", component->Name().toStdString(),
-                  loadFlagString(component->load_flags_).toStdString());
+    if (!folder_watcher_->addPath(component_folder)) {
+      SPDLOG_WARN("Unable to watch component folder: {}", component_folder.toStdString());
       continue;
     }
 
-    component->ValidateDependencies();
+    SPDLOG_INFO("Watching component folder: {}", component_folder.toStdString());
 
-    if (component->load_flags_ != 0) {
-      SPDLOG_WARN("Component {} was not loaded after dependency validation. Flags: {}", component->Name().toStdString(),
-                  loadFlagString(component->load_flags_).toStdString());
-      continue;
+    watched_folders_.append(component_folder);
+  }
+}
+
+auto sss::extsystem::ComponentLoader::InstallComponents(const QStringList& component_folders)
+    -> QList<sss::extsystem::Component*> {
+  if (load_depth_ > 0 || waiting_for_events_) {
+    for (const auto& component_folder : component_folders) {
+      if (!deferred_install_folders_.contains(component_folder)) {
+        deferred_install_folders_.append(component_folder);
+      }
     }
 
-    if (load_function) {
-      if (!load_function(component)) {
-        component->load_flags_.setFlag(sss::extsystem::ComponentLoader::kDisabled);
+    SPDLOG_DEBUG("Components are being loaded, installation deferred");
 
-        SPDLOG_INFO("Component {} was not loaded because it is disabled by configuration.",
-                    component->Name().toStdString());
+    return {};
+  }
+
+  auto application_debug_build = false;
+  auto application_qt_version = QVersionNumber();
+
+  applicationBuild(application_debug_build, application_qt_version);
+
+  // 只读取尚未添加过的库文件。被拒绝的库按读取前的身份记录，元数据为空的文件（例如仍在复制中）
+  // 复制完成后大小或修改时间会变化，因此会再次读取
+
+  QStringList candidates;
+  QHash<QString, QPair<qint64, qint64>> library_stamps;
+
+  for (const auto& component_folder : component_folders) {
+    for (const auto& candidate : candidateLibraries(component_folder)) {
+      if (added_libraries_.contains(candidate)) {
+        continue;
+      }
+
+      auto stamp = LibraryStamp(candidate);
+      auto rejected_iterator = rejected_libraries_.constFind(candidate);
+
+      if (rejected_iterator != rejected_libraries_.constEnd() && rejected_iterator.value() == stamp) {
         continue;
       }
+
+      candidates.append(candidate);
+      library_stamps.insert(candidate, stamp);
     }
+  }
 
-    // 检查依赖项是否已加载，如果没有加载则此组件无法加载
+  if (candidates.isEmpty()) {
+    return {};
+  }
 
-    auto* plugin_loader = new QPluginLoader(component->Filename());
+  auto library_metadata = readAllMetadata(candidates, true);
 
-    if (!plugin_loader->load()) {
-      component->load_flags_.setFlag(sss::extsystem::ComponentLoader::kUnableToLoad);
+  // 名称冲突时恢复的搜索列表，本次安装中先添加的同名组件优先于它
+  auto previous_search_list = component_search_list_;
 
-      SPDLOG_ERROR("Component {} was not loaded. Unable to load library. Error: {}", component->Name().toStdString(),
-                   plugin_loader->errorString().toStdString());
-      delete plugin_loader;
+  QList<sss::extsystem::Component*> registered_components;
+  QList<sss::extsystem::Component*> new_components;
 
+  for (int index = 0; index < candidates.size(); index++) {
+    auto* component = addComponent(candidates.at(index), library_metadata[static_cast<size_t>(index)],
+                                   application_debug_build, application_qt_version);
+
+    if (component == nullptr) {
+      rejected_libraries_.insert(candidates.at(index), library_stamps.value(candidates.at(index)));
       continue;
     }
 
-    auto* component_interface = qobject_cast<sss::extsystem::IComponent*>(plugin_loader->instance());
+    registered_components.append(component);
 
-    if (component_interface == nullptr) {
-      component->load_flags_.setFlag(sss::extsystem::ComponentLoader::kMissingInterface);
-      delete plugin_loader;
+    // 已有的同名组件保持不变
 
-      SPDLOG_ERROR("Component {} was not loaded. The library does not export a valid IComponent interface.",
-                   component->Name().toStdString());
+    if (component->load_flags_.testFlag(LoadFlag::kNameClash)) {
+      SPDLOG_WARN("Library {} ignored, component {} is already installed", candidates.at(index).toStdString(),
+                  component->Name().toStdString());
+
+      auto* existing_component = previous_search_list.value(component->Name());
+
+      for (auto* new_component : qAsConst(new_components)) {
+        if (new_component->Name() == component->Name()) {
+          existing_component = new_component;
+        }
+      }
+
+      component_search_list_[component->Name()] = existing_component;
       continue;
     }
 
-    component->load_flags_.setFlag(sss::extsystem::ComponentLoader::kLoaded);
+    new_components.append(component);
+  }
 
-    load_order_.append(QPair<QPluginLoader*, Component*>(plugin_loader, component));
+  if (new_components.isEmpty()) {
+    forgetUninstalledLibraries(registered_components, {}, library_stamps);
 
-    component->is_loaded_ = true;
+    return {};
   }
 
-  // 为每个组件调用 initialiseEvent（按加载顺序）
+  // 之前只因缺少依赖项而没有加载的组件可能由新组件满足，与新组件一起重新解析
 
-  for (auto component_pair : load_order_) {
-    auto* component_interface = qobject_cast<sss::extsystem::IComponent*>(component_pair.first->instance());
+  for (auto* component : qAsConst(component_search_list_)) {
+    if (component->load_flags_ != LoadFlag::kMissingDependency || new_components.contains(component)) {
+      continue;
+    }
 
-    component_interface->InitialiseEvent();
-  }
+    auto satisfied = std::all_of(
+        component->missing_dependencies_.cbegin(), component->missing_dependencies_.cend(),
+        [this](const QString& dependency_name) { return component_search_list_.contains(dependency_name); });
 
-  // 为每个组件调用 initialisationFinishedEvent（按反向加载顺序）
+    if (!satisfied) {
+      continue;
+    }
 
-  for (auto loaded_component_iterator = load_order_.rbegin(); loaded_component_iterator < load_order_.rend();
-       loaded_component_iterator++) {
-    auto* component_interface = qobject_cast<sss::extsystem::IComponent*>(loaded_component_iterator->first->instance());
+    component->load_flags_ = LoadFlags();
+    component->missing_dependencies_.clear();
+    component->dependencies_.clear();
+    component->dependency_versions_.clear();
 
-    component_interface->InitialisationFinishedEvent();
+    new_components.append(component);
   }
-}
 
-auto sss::extsystem::ComponentLoader::Components() -> QList<sss::extsystem::Component*> {
-  return component_search_list_.values();
-}
+  // 在已有组件和其他新组件中解析依赖项
 
-auto sss::extsystem::ComponentLoader::resolve(sss::extsystem::Component* component,
-                                              QList<sss::extsystem::Component*>& resolved_list) -> void {
-  QList<sss::extsystem::Component*> processed_list;
+  QList<sss::extsystem::Component*> component_install_list;
 
-  resolve(component, resolved_list, processed_list);
-}
+  for (auto* component : new_components) {
+    if (component->load_flags_ != 0) {
+      continue;
+    }
 
-auto sss::extsystem::ComponentLoader::resolve(sss::extsystem::Component* component,
-                                              QList<sss::extsystem::Component*>& resolved_list,
-                                              QList<sss::extsystem::Component*>& processed_list_current_branch)
-    -> void {
-  // 如果组件已经在最终解析列表中，跳过它。
-  if (resolved_list.contains(component)) {
-    return;
-  }
+    linkDependencies(component);
 
-  // 如果组件已经在当前处理分支中，则是循环依赖。
-  if (processed_list_current_branch.contains(component)) {
-    component->load_flags_.setFlag(LoadFlag::kCircularDependency);
-    SPDLOG_ERROR("Circular dependency detected involving component: {}", component->Name().toStdString());
-    return;  // 中断此递归分支
+    if (!component->load_flags_) {
+      component_install_list.append(component);
+    }
   }
 
-  processed_list_current_branch.append(component);  // 将组件标记为当前正在处理
+  // 解析结果包含已有的依赖项，只有新组件和它们需要的延迟组件会被加载
+
+  auto resolved_install_list = sss::extsystem::DependencyResolver::Resolve(component_install_list);
+
+  QSet<sss::extsystem::Component*> install_set(component_install_list.cbegin(), component_install_list.cend());
+  QSet<sss::extsystem::Component*> required_components;
+
+  for (auto component_iterator = resolved_install_list.rbegin(); component_iterator != resolved_install_list.rend();
+       component_iterator++) {
+    auto* component = *component_iterator;
+    auto can_defer = (install_set.contains(component) && component->IsLazy()) ||
+                     component->load_flags_.testFlag(sss::extsystem::ComponentLoader::kDeferred);
 
-  for (auto* dependency : component->dependencies_) {
-    // 仅在依赖项尚未解析时才解析它
-    if (!resolved_list.contains(dependency)) {
-      resolve(dependency, resolved_list, processed_list_current_branch);
+    if (can_defer && !required_components.contains(component)) {
+      continue;
     }
-  }
 
-  // 解析所有其依赖项（或处理循环依赖项）后，添加组件
-  // 如果它尚未解析且未标记为循环依赖。
-  if (!resolved_list.contains(component) && !component->load_flags_.testFlag(LoadFlag::kCircularDependency)) {
-    resolved_list.append(component);
+    for (auto* dependency : component->dependencies_) {
+      required_components.insert(dependency);
+    }
   }
 
-  processed_list_current_branch.removeAll(component);  // 完成后从当前处理分支中移除
-}
+  QList<sss::extsystem::Component*> install_list;
 
-auto sss::extsystem::ComponentLoader::UnloadComponents() -> void {
-  for (auto loaded_component_iterator = load_order_.rbegin(); loaded_component_iterator < load_order_.rend();
-       loaded_component_iterator++) {
-    auto* plugin_loader = qobject_cast<QPluginLoader*>(loaded_component_iterator->first);
+  for (auto* component : resolved_install_list) {
+    if (component->load_flags_.testFlag(sss::extsystem::ComponentLoader::kDeferred)) {
+      if (required_components.contains(component)) {
+        component->load_flags_.setFlag(sss::extsystem::ComponentLoader::kDeferred, false);
+        deferred_components_.removeAll(component);
+        install_list.append(component);
+      }
 
-    auto* component_interface = qobject_cast<sss::extsystem::IComponent*>(plugin_loader->instance());
+      continue;
+    }
 
-    if (component_interface == nullptr) {
+    if (!install_set.contains(component) || component->load_flags_ != 0) {
       continue;
     }
 
-    component_interface->FinaliseEvent();
+    if (component->IsLazy() && !required_components.contains(component)) {
+      component->load_flags_.setFlag(sss::extsystem::ComponentLoader::kDeferred);
+      deferred_components_.append(component);
 
-    if (plugin_loader != nullptr) {
-#if !defined(Q_OS_MACOS)
+      SPDLOG_INFO("Installed component {} is deferred until one of its activation triggers fires.",
+                  component->Name().toStdString());
+      continue;
+    }
+
+    install_list.append(component);
+  }
+
+  auto installed_components = loadAndInitialiseComponents(install_list);
+
+  forgetUninstalledLibraries(registered_components, installed_components, library_stamps);
+
+  SPDLOG_INFO("Installed {} of {} new components at runtime", installed_components.size(), new_components.size());
+
+  if (!installed_components.isEmpty()) {
+    Q_EMIT ComponentsActivated(installed_components);
+  }
+
+  return installed_components;
+}
+
+auto sss::extsystem::ComponentLoader::forgetUninstalledLibraries(
+    const QList<sss::extsystem::Component*>& registered_components,
+    const QList<sss::extsystem::Component*>& installed_components,
+    const QHash<QString, QPair<qint64, qint64>>& library_stamps) -> void {
+  // 组件对象仍可能被其他组件的依赖项引用，保留到加载器销毁时释放
+
+  const auto permanent_flags = LoadFlags(LoadFlag::kDisabled) | LoadFlag::kIncompatibleQtVersion | LoadFlag::kNameClash;
+
+  for (auto* component : registered_components) {
+    if (installed_components.contains(component) ||
+        component->load_flags_.testFlag(sss::extsystem::ComponentLoader::kDeferred)) {
+      continue;
+    }
+
+    added_libraries_.remove(component->Filename());
+
+    // 缺少依赖项或加载失败的库可能因其他文件变化而成功，下次文件夹变化时重新读取
+
+    if (component->load_flags_ & permanent_flags) {
+      rejected_libraries_.insert(component->Filename(), library_stamps.value(component->Filename()));
+
+      SPDLOG_INFO("Library {} is skipped until it changes ({})", component->Filename().toStdString(),
+                  loadFlagString(component->load_flags_).toStdString());
+    }
+
+    if (component_search_list_.value(component->Name()) == component) {
+      component_search_list_.remove(component->Name());
+    }
+  }
+}
+
+auto sss::extsystem::ComponentLoader::ActivateTrigger(ActivationTrigger trigger, const QString& identifier) -> bool {
+  // 组件初始化期间直接调用时立即激活，等待期间由排队调用重新进入时推迟到当前加载结束之后
+
+  if (waiting_for_events_) {
+    deferred_activations_.append({trigger, identifier});
+
+    SPDLOG_DEBUG("Components are being loaded, activation trigger {} deferred", identifier.toStdString());
+
+    return false;
+  }
+
+  QSet<sss::extsystem::Component*> activation_set;
+
+  for (auto* component : deferred_components_) {
+    if (component->ActivationTriggers(trigger).contains(identifier)) {
+      activation_set.insert(component);
+    }
+  }
+
+  if (activation_set.isEmpty()) {
+    return false;
+  }
+
+  // 同时激活延迟的依赖项，deferred_components_ 按加载顺序排列，依赖项总在依赖它的组件之前
+
+  for (auto component_iterator = deferred_components_.rbegin(); component_iterator != deferred_components_.rend();
+       component_iterator++) {
+    if (!activation_set.contains(*component_iterator)) {
+      continue;
+    }
+
+    for (auto* dependency : (*component_iterator)->dependencies_) {
+      if (deferred_components_.contains(dependency)) {
+        activation_set.insert(dependency);
+      }
+    }
+  }
+
+  QList<sss::extsystem::Component*> activation_list;
+
+  for (auto* component : deferred_components_) {
+    if (activation_set.contains(component)) {
+      activation_list.append(component);
+    }
+  }
+
+  // 先从延迟列表中移除，防止组件在初始化期间再次触发自身的激活
+
+  for (auto* component : activation_list) {
+    deferred_components_.removeAll(component);
+  }
+
+  for (auto* component : activation_list) {
+    component->load_flags_.setFlag(sss::extsystem::ComponentLoader::kDeferred, false);
+  }
+
+  auto activated_components = loadAndInitialiseComponents(activation_list);
+
+  SPDLOG_INFO("Activation trigger {} activated {} components", identifier.toStdString(), activated_components.size());
+
+  if (activated_components.isEmpty()) {
+    return false;
+  }
+
+  Q_EMIT ComponentsActivated(activated_components);
+
+  return true;
+}
+
+auto sss::extsystem::ComponentLoader::PendingTriggers(ActivationTrigger trigger)
+    -> QMap<QString, sss::extsystem::Component*> {
+  QMap<QString, sss::extsystem::Component*> pending_triggers;
+
+  for (auto* component : deferred_components_) {
+    for (const auto& identifier : component->ActivationTriggers(trigger)) {
+      if (!pending_triggers.contains(identifier)) {
+        pending_triggers[identifier] = component;
+      }
+    }
+  }
+
+  return pending_triggers;
+}
+
+auto sss::extsystem::ComponentLoader::linkDependencies(sss::extsystem::Component* component) -> void {
+  for (const auto& dependency : component->Descriptor().Dependencies()) {
+    auto* dependency_component = component_search_list_.value(dependency.name);
+
+    if (dependency_component != nullptr) {
+      component->AddDependency(dependency_component, dependency.version);
+    } else {
+      component->missing_dependencies_.append(dependency.name);
+      component->load_flags_ |= LoadFlag::kMissingDependency;
+    }
+  }
+}
+
+auto sss::extsystem::ComponentLoader::loadComponent(sss::extsystem::Component* component,
+                                                    sss::extsystem::LibraryPrefetcher* prefetcher) -> bool {
+  if (component->load_flags_ != 0) {
+    SPDLOG_WARN("Component {} was not loaded because of pre-existing flags: {}", component->Name().toStdString(),
+                loadFlagString(component->load_flags_).toStdString());
+    return false;
+  }
+
+  component->ValidateDependencies();
+
+  if (component->load_flags_ != 0) {
+    SPDLOG_WARN("Component {} was not loaded after dependency validation. Flags: {}", component->Name().toStdString(),
+                loadFlagString(component->load_flags_).toStdString());
+    return false;
+  }
+
+  // 检查依赖项是否已加载，如果没有加载则此组件无法加载
+
+  QPluginLoader* plugin_loader = nullptr;
+  QObject* component_instance = nullptr;
+
+  auto static_instance = static_instances_.value(component);
+
+  if (static_instance != nullptr) {
+    sss::extsystem::StartupTrace::Span trace_span(
+        [&](QJsonObject& args) {
+          args.insert("library", component->Filename());
+          return "Instantiate " + component->Name();
+        },
+        "load");
+
+    component_instance = static_instance();
+  } else {
+    // 插件总是在主线程中通过 QPluginLoader 加载，预取器已打开的库只增加引用计数；这里通知它跳过正在加载的文件
+
+    if (prefetcher != nullptr) {
+      prefetcher->Claim(component->Filename());
+    }
+
+    plugin_loader = new QPluginLoader(component->Filename());
+
+    auto library_loaded = [&]() {
+      sss::extsystem::StartupTrace::Span trace_span(
+          [&](QJsonObject& args) {
+            args.insert("library", component->Filename());
+            return "Load " + component->Name();
+          },
+          "load");
+
+      return plugin_loader->load();
+    }();
+
+    if (!library_loaded) {
+      component->load_flags_.setFlag(sss::extsystem::ComponentLoader::kUnableToLoad);
+
+      SPDLOG_ERROR("Component {} was not loaded. Unable to load library. Error: {}", component->Name().toStdString(),
+                   plugin_loader->errorString().toStdString());
+      delete plugin_loader;
+
+      return false;
+    }
+
+    component_instance = plugin_loader->instance();
+  }
+
+  auto* component_interface = qobject_cast<sss::extsystem::IComponent*>(component_instance);
+
+  if (component_interface == nullptr) {
+    component->load_flags_.setFlag(sss::extsystem::ComponentLoader::kMissingInterface);
+    delete plugin_loader;
+
+    SPDLOG_ERROR("Component {} was not loaded. The library does not export a valid IComponent interface.",
+                 component->Name().toStdString());
+    return false;
+  }
+
+  component->load_flags_.setFlag(sss::extsystem::ComponentLoader::kLoaded);
+
+  load_order_.append(LoadedComponent{plugin_loader, component, component_interface});
+
+  component->is_loaded_ = true;
+
+  return true;
+}
+
+auto sss::extsystem::ComponentLoader::loadAndInitialiseComponents(const QList<sss::extsystem::Component*>& components)
+    -> QList<sss::extsystem::Component*> {
+  load_depth_++;
+
+  // 先应用加载函数，被禁用的组件的库不会被预取
+
+  if (load_function_) {
+    for (auto* component : components) {
+      if (component->load_flags_ == 0 && !load_function_(component)) {
+        component->load_flags_.setFlag(sss::extsystem::ComponentLoader::kDisabled);
+
+        SPDLOG_INFO("Component {} was not loaded because it is disabled by configuration.",
+                    component->Name().toStdString());
+      }
+    }
+  }
+
+  // 计算拓扑层级：没有依赖项的组件位于第 0 层，其余组件位于其依赖项的最高层级之后
+
+  QHash<sss::extsystem::Component*, int> component_levels;
+  QMap<int, QList<sss::extsystem::Component*>> level_components;
+
+  for (auto* component : components) {
+    auto level = 0;
+
+    for (auto* dependency : component->dependencies_) {
+      if (component_levels.contains(dependency)) {
+        level = qMax(level, component_levels.value(dependency) + 1);
+      }
+    }
+
+    component_levels.insert(component, level);
+    level_components[level].append(component);
+  }
+
+  // 按层级顺序在工作线程中预先打开共享库，主线程初始化前面的层级时后面层级的库已在读入和重定位
+
+  QStringList prefetch_libraries;
+
+  for (const auto& level_list : qAsConst(level_components)) {
+    for (auto* component : level_list) {
+      if (component->load_flags_ == 0 && !static_instances_.contains(component)) {
+        prefetch_libraries.append(component->Filename());
+      }
+    }
+  }
+
+  std::unique_ptr<sss::extsystem::LibraryPrefetcher> prefetcher;
+
+  if (library_prefetch_ && prefetch_libraries.size() > 1) {
+    prefetcher = std::make_unique<sss::extsystem::LibraryPrefetcher>(prefetch_libraries);
+    prefetcher->Start();
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+
+  QThreadPool thread_pool;
+  thread_pool.setMaxThreadCount(QThread::idealThreadCount());
+
+  auto* application = QCoreApplication::instance();
+  auto can_process_events = application != nullptr && QThread::currentThread() == application->thread();
+
+  QList<int> initialised_indices;
+  auto initialised_count = 0;
+  auto total_count = static_cast<int>(
+      std::count_if(components.cbegin(), components.cend(),
+                    [](sss::extsystem::Component* component) { return component->load_flags_ == 0; }));
+
+  for (auto level_iterator = level_components.constBegin(); level_iterator != level_components.constEnd();
+       ++level_iterator) {
+    // 在主线程中加载该层级的组件并创建实例，依赖项都位于之前的层级，已经加载完毕
+
+    QList<int> indices;
+
+    for (auto* component : level_iterator.value()) {
+      if (loadComponent(component, prefetcher.get())) {
+        indices.append(load_order_.size() - 1);
+      } else if (component->load_flags_ != sss::extsystem::ComponentLoader::kDisabled) {
+        // 加载失败的组件不会初始化，从进度总数中扣除
+        total_count--;
+      }
+    }
+
+    // 在线程池中启动该层级所有后台初始化，完成标志只在主线程中修改
+
+    QVector<bool> background_finished(indices.size(), true);
+    auto concurrent_count = 0;
+
+    for (auto position = 0; position < indices.size(); position++) {
+      auto loaded_component = load_order_.at(indices.at(position));
+
+      if (!loaded_component.component->InitialisesConcurrently()) {
+        continue;
+      }
+
+      auto* component_interface = loaded_component.component_interface;
+      auto* finished = &background_finished[position];
+      auto component_name = loaded_component.component->Name();
+
+      *finished = false;
+      concurrent_count++;
+
+      thread_pool.start(QRunnable::create([this, component_interface, component_name, finished,
+                                           can_process_events]() {
+        {
+          sss::extsystem::StartupTrace::Span trace_span(
+              [&]() { return "InitialiseBackgroundEvent " + component_name; }, "initialise");
+
+          component_interface->InitialiseBackgroundEvent();
+        }
+
+        if (can_process_events) {
+          QMetaObject::invokeMethod(this, [finished]() { *finished = true; }, Qt::QueuedConnection);
+        }
+      }));
+    }
+
+    if (concurrent_count > 0) {
+      SPDLOG_DEBUG("Initialising {} components concurrently at dependency level {}", concurrent_count,
+                   level_iterator.key());
+    }
+
+    if (!can_process_events) {
+      // 没有可用的事件循环时直接等待，后台初始化此时不能使用 RunOnMainThread
+      thread_pool.waitForDone();
+      background_finished.fill(true);
+    }
+
+    // 为每个组件调用 initialiseEvent（按加载顺序），必要时先等待其后台初始化完成
+
+    std::vector<std::unique_ptr<QFutureWatcher<void>>> async_watchers;
+    auto pending_async_count = 0;
+
+    for (auto position = 0; position < indices.size(); position++) {
+      while (!background_finished.at(position)) {
+        waitForEvents();
+      }
+
+      auto loaded_component = load_order_.at(indices.at(position));
+
+      {
+        sss::extsystem::StartupTrace::Span trace_span(
+            [&]() { return "InitialiseEvent " + loaded_component.component->Name(); }, "initialise");
+
+        loaded_component.component_interface->InitialiseEvent();
+      }
+
+      // 异步初始化在本层级结束前等待，依赖此组件的组件位于后面的层级
+
+      auto future = loaded_component.component_interface->InitialiseAsyncEvent();
+
+      if (future.isFinished()) {
+        Q_EMIT InitialisationProgress(loaded_component.component, ++initialised_count, total_count);
+        continue;
+      }
+
+      if (!can_process_events) {
+        sss::extsystem::StartupTrace::Span async_trace_span(
+            [&]() { return "InitialiseAsyncEvent " + loaded_component.component->Name(); }, "initialise");
+
+        future.waitForFinished();
+
+        Q_EMIT InitialisationProgress(loaded_component.component, ++initialised_count, total_count);
+        continue;
+      }
+
+      auto* component = loaded_component.component;
+      auto async_start = sss::extsystem::StartupTrace::Now();
+      auto watcher = std::make_unique<QFutureWatcher<void>>();
+
+      connect(watcher.get(), &QFutureWatcher<void>::finished, this,
+              [this, component, async_start, &pending_async_count, &initialised_count, &total_count]() {
+                if (sss::extsystem::StartupTrace::IsEnabled()) {
+                  sss::extsystem::StartupTrace::AddSpan("InitialiseAsyncEvent " + component->Name(), "initialise",
+                                                        async_start,
+                                                        sss::extsystem::StartupTrace::Now() - async_start);
+                }
+
+                pending_async_count--;
+
+                Q_EMIT InitialisationProgress(component, ++initialised_count, total_count);
+              });
+
+      watcher->setFuture(future);
+
+      async_watchers.push_back(std::move(watcher));
+      pending_async_count++;
+    }
+
+    if (pending_async_count > 0) {
+      SPDLOG_DEBUG("Waiting for {} asynchronous initialisations at dependency level {}", pending_async_count,
+                   level_iterator.key());
+    }
+
+    while (pending_async_count > 0) {
+      waitForEvents();
+    }
+
+    async_watchers.clear();
+
+    initialised_indices.append(indices);
+  }
+
+  SPDLOG_INFO("Initialised {} components in {} dependency levels in {}ms", initialised_indices.size(),
+              level_components.size(), timer.elapsed());
+
+  // 为每个组件调用 initialisationFinishedEvent（按反向加载顺序），初始化期间被激活的组件已自行完成
+
+  QList<sss::extsystem::Component*> loaded_components;
+
+  for (auto index : initialised_indices) {
+    loaded_components.append(load_order_.at(index).component);
+  }
+
+  for (auto index_iterator = initialised_indices.crbegin(); index_iterator != initialised_indices.crend();
+       ++index_iterator) {
+    auto loaded_component = load_order_.at(*index_iterator);
+
+    sss::extsystem::StartupTrace::Span trace_span(
+        [&]() { return "InitialisationFinishedEvent " + loaded_component.component->Name(); }, "initialise");
+
+    loaded_component.component_interface->InitialisationFinishedEvent();
+  }
+
+  load_depth_--;
+
+  if (load_depth_ == 0) {
+    scheduleDeferredRequests();
+  }
+
+  return loaded_components;
+}
+
+auto sss::extsystem::ComponentLoader::waitForEvents() -> void {
+  auto previous_waiting = waiting_for_events_;
+
+  waiting_for_events_ = true;
+
+  QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents | QEventLoop::ExcludeUserInputEvents);
+
+  waiting_for_events_ = previous_waiting;
+}
+
+auto sss::extsystem::ComponentLoader::scheduleDeferredRequests() -> void {
+  if (deferred_activations_.isEmpty() && deferred_install_folders_.isEmpty()) {
+    return;
+  }
+
+  // 排队执行，使调用方先完成本次加载（例如发出 ComponentsActivated）
+  QMetaObject::invokeMethod(
+      this,
+      [this]() {
+        auto activations = std::exchange(deferred_activations_, {});
+        auto install_folders = std::exchange(deferred_install_folders_, {});
+
+        for (const auto& activation : activations) {
+          ActivateTrigger(activation.first, activation.second);
+        }
+
+        if (!install_folders.isEmpty()) {
+          InstallComponents(install_folders);
+        }
+      },
+      Qt::QueuedConnection);
+}
+
+auto sss::extsystem::ComponentLoader::Components() -> QList<sss::extsystem::Component*> {
+  return component_search_list_.values();
+}
+
+auto sss::extsystem::ComponentLoader::SetShutdownPolicy(ShutdownPolicy policy, int finalise_timeout) -> void {
+  shutdown_policy_ = policy;
+  finalise_timeout_ = finalise_timeout;
+}
+
+auto sss::extsystem::ComponentLoader::UnloadComponents() -> void {
+  if (install_timer_ != nullptr) {
+    install_timer_->stop();
+  }
+
+  if (shutdown_policy_ == ShutdownPolicy::kFast) {
+    fastUnloadComponents();
+
+    deferred_activations_.clear();
+    deferred_install_folders_.clear();
+
+    return;
+  }
+
+  for (auto loaded_component_iterator = load_order_.rbegin(); loaded_component_iterator < load_order_.rend();
+       loaded_component_iterator++) {
+    auto* plugin_loader = loaded_component_iterator->plugin_loader;
+
+    loaded_component_iterator->component_interface->FinaliseEvent();
+
+    if (plugin_loader != nullptr) {
+#if !defined(Q_OS_MACOS)
       /**
        * 注意：在 macOS 上调用 unload 会导致应用程序崩溃，这里泄漏内存没关系，所有内存将在我们退出时释放。
        * 对于 Windows 和 Linux，我们包含 unload 以完整性并阻止内存泄漏分析器报告泄漏。
@@ -393,6 +1315,148 @@ auto sss::extsystem::ComponentLoader::UnloadComponents() -> void {
   }
 
   load_order_.clear();
+
+  deferred_activations_.clear();
+  deferred_install_folders_.clear();
+}
+
+auto sss::extsystem::ComponentLoader::fastUnloadComponents() -> void {
+  if (load_order_.isEmpty()) {
+    return;
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+
+  // 计算所有已加载组件的拓扑层级，不需要结束的组件也参与计算，以保持间接依赖关系的顺序
+
+  QHash<sss::extsystem::Component*, int> component_levels;
+  QMap<int, QList<LoadedComponent>> level_components;
+
+  for (const auto& loaded_component : qAsConst(load_order_)) {
+    auto level = 0;
+
+    for (auto* dependency : loaded_component.component->dependencies_) {
+      if (component_levels.contains(dependency)) {
+        level = qMax(level, component_levels.value(dependency) + 1);
+      }
+    }
+
+    component_levels.insert(loaded_component.component, level);
+
+    if (loaded_component.component->FinalisesOnExit()) {
+      level_components[level].append(loaded_component);
+    }
+  }
+
+  // 库不卸载，QPluginLoader 和插件实例随进程退出一起释放
+
+  load_order_.clear();
+
+  // 完成标志由工作线程设置，放弃等待后仍可能被写入，因此与线程池一起在堆上共享
+
+  struct FinaliseTask {
+    QString name;
+    std::atomic<bool> finished{false};
+  };
+
+  auto* application = QCoreApplication::instance();
+  auto can_process_events = application != nullptr && QThread::currentThread() == application->thread();
+  auto* thread_pool = new QThreadPool;
+  auto finalise_count = 0;
+  auto timed_out = false;
+
+  thread_pool->setMaxThreadCount(QThread::idealThreadCount());
+
+  // 依赖其他组件的组件先结束，因此从最高层级开始
+
+  for (auto level_iterator = level_components.constEnd(); level_iterator != level_components.constBegin();) {
+    --level_iterator;
+
+    std::vector<std::shared_ptr<FinaliseTask>> tasks;
+
+    for (const auto& loaded_component : level_iterator.value()) {
+      auto task = std::make_shared<FinaliseTask>();
+      auto* component_interface = loaded_component.component_interface;
+
+      task->name = loaded_component.component->Name();
+
+      thread_pool->start(QRunnable::create([task, component_interface, application, can_process_events]() {
+        {
+          sss::extsystem::StartupTrace::Span trace_span([&]() { return "FinaliseEvent " + task->name; },
+                                                        "finalise");
+
+          component_interface->FinaliseEvent();
+        }
+
+        task->finished.store(true);
+
+        if (can_process_events) {
+          // 唤醒主线程的事件循环
+          QMetaObject::invokeMethod(application, []() {}, Qt::QueuedConnection);
+        }
+      }));
+
+      tasks.push_back(task);
+      finalise_count++;
+    }
+
+    auto level_finished = [&tasks]() {
+      return std::all_of(tasks.cbegin(), tasks.cend(),
+                         [](const std::shared_ptr<FinaliseTask>& task) { return task->finished.load(); });
+    };
+
+    if (can_process_events) {
+      // 处理事件以便 FinaliseEvent 可以使用 RunOnMainThread，计时器保证在超时时唤醒事件循环
+
+      QTimer watchdog;
+
+      watchdog.start(qMax(1, finalise_timeout_ - static_cast<int>(timer.elapsed())));
+
+      while (!level_finished() && timer.elapsed() < finalise_timeout_) {
+        waitForEvents();
+      }
+    } else {
+      thread_pool->waitForDone(qMax(0, finalise_timeout_ - static_cast<int>(timer.elapsed())));
+    }
+
+    if (!level_finished()) {
+      for (const auto& task : tasks) {
+        if (!task->finished.load()) {
+          SPDLOG_WARN("Component {} did not finish FinaliseEvent within {}ms", task->name.toStdString(),
+                      finalise_timeout_);
+        }
+      }
+
+      // 更低层级的组件被仍在运行的组件依赖，不再调用它们的 FinaliseEvent
+
+      QStringList skipped_names;
+
+      for (auto skipped_iterator = level_components.constBegin(); skipped_iterator != level_iterator;
+           ++skipped_iterator) {
+        for (const auto& skipped_component : skipped_iterator.value()) {
+          skipped_names.append(skipped_component.component->Name());
+        }
+      }
+
+      if (!skipped_names.isEmpty()) {
+        SPDLOG_WARN("Fast shutdown skipped FinaliseEvent of {}", skipped_names.join(", ").toStdString());
+      }
+
+      timed_out = true;
+
+      break;
+    }
+  }
+
+  if (timed_out) {
+    // 仍在运行的 FinaliseEvent 使用线程池，不能等待其销毁
+    SPDLOG_WARN("Fast shutdown abandoned the remaining finalisers after {}ms", timer.elapsed());
+  } else {
+    delete thread_pool;
+  }
+
+  SPDLOG_INFO("Fast shutdown finalised {} components in {}ms", finalise_count, timer.elapsed());
 }
 
 auto sss::extsystem::ComponentLoader::loadFlagString(sss::extsystem::ComponentLoader::LoadFlags flags)  // NOLINT
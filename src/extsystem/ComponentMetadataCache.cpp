@@ -0,0 +1,215 @@
+#include "ComponentMetadataCache.h"
+
+#include <spdlog/spdlog.h>
+
+#include <QCborValue>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonValue>
+#include <QSaveFile>
+#include <utility>
+
+#if defined(Q_OS_UNIX)
+#include <sys/stat.h>
+#endif
+
+constexpr quint32 kCacheMagic = 0x44534D43;  // "DSMC"
+constexpr quint32 kCacheFormatVersion = 3;
+
+sss::extsystem::ComponentMetadataCache::ComponentMetadataCache(QString cache_filename)
+    : cache_filename_(std::move(cache_filename)) {}
+
+auto sss::extsystem::ComponentMetadataCache::Load() -> bool {
+  entries_.clear();
+  dirty_ = false;
+
+  QFile cache_file(cache_filename_);
+
+  if (!cache_file.open(QIODevice::ReadOnly)) {
+    SPDLOG_DEBUG("Component metadata cache {} not found", cache_filename_.toStdString());
+    return false;
+  }
+
+  QDataStream stream(&cache_file);
+  stream.setVersion(QDataStream::Qt_5_15);
+
+  quint32 magic = 0;
+  quint32 format_version = 0;
+  qint32 entry_count = 0;
+
+  stream >> magic >> format_version >> entry_count;
+
+  if (magic != kCacheMagic || format_version != kCacheFormatVersion || entry_count < 0) {
+    SPDLOG_WARN("Component metadata cache {} has an unknown format, ignoring it", cache_filename_.toStdString());
+    return false;
+  }
+
+  for (qint32 index = 0; index < entry_count; index++) {
+    QString filename;
+    Entry entry;
+    QByteArray encoded_metadata;
+
+    stream >> filename >> entry.stamp.size >> entry.stamp.modified >> entry.stamp.inode
+        >> entry.record.has_descriptor;
+
+    if (entry.record.has_descriptor) {
+      stream >> entry.record.descriptor >> entry.record.qt_version >> entry.record.debug_build;
+    } else {
+      stream >> encoded_metadata;
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+      SPDLOG_WARN("Component metadata cache {} is truncated, ignoring it", cache_filename_.toStdString());
+      entries_.clear();
+      return false;
+    }
+
+    if (!entry.record.has_descriptor) {
+      entry.record.metadata = QCborValue::fromCbor(encoded_metadata).toJsonValue().toObject();
+    }
+
+    entries_.insert(filename, entry);
+  }
+
+  SPDLOG_INFO("Loaded {} entries from component metadata cache {}", entries_.size(), cache_filename_.toStdString());
+
+  return true;
+}
+
+auto sss::extsystem::ComponentMetadataCache::Save() -> bool {
+  if (!dirty_) {
+    return true;
+  }
+
+  // 丢弃已删除的库文件的条目
+  for (auto entry_iterator = entries_.begin(); entry_iterator != entries_.end();) {
+    if (!Stamp(entry_iterator.key()).IsValid()) {
+      entry_iterator = entries_.erase(entry_iterator);
+    } else {
+      ++entry_iterator;
+    }
+  }
+
+  QDir().mkpath(QFileInfo(cache_filename_).absolutePath());
+
+  QSaveFile cache_file(cache_filename_);
+
+  if (!cache_file.open(QIODevice::WriteOnly)) {
+    SPDLOG_WARN("Unable to write component metadata cache {}: {}", cache_filename_.toStdString(),
+                cache_file.errorString().toStdString());
+    return false;
+  }
+
+  QDataStream stream(&cache_file);
+  stream.setVersion(QDataStream::Qt_5_15);
+
+  stream << kCacheMagic << kCacheFormatVersion << static_cast<qint32>(entries_.size());
+
+  for (auto entry_iterator = entries_.constBegin(); entry_iterator != entries_.constEnd(); ++entry_iterator) {
+    const auto& entry = entry_iterator.value();
+
+    stream << entry_iterator.key() << entry.stamp.size << entry.stamp.modified << entry.stamp.inode
+           << entry.record.has_descriptor;
+
+    if (entry.record.has_descriptor) {
+      stream << entry.record.descriptor << entry.record.qt_version << entry.record.debug_build;
+    } else {
+      stream << QCborValue::fromJsonValue(QJsonValue(entry.record.metadata)).toCbor();
+    }
+  }
+
+  if (!cache_file.commit()) {
+    SPDLOG_WARN("Unable to commit component metadata cache {}", cache_filename_.toStdString());
+    return false;
+  }
+
+  dirty_ = false;
+
+  return true;
+}
+
+auto sss::extsystem::ComponentMetadataCache::Lookup(const QString& filename, FileStamp& stamp, Record& record)
+    -> bool {
+  stamp = Stamp(filename);
+
+  auto entry_iterator = entries_.constFind(filename);
+
+  if (stamp.IsValid() && entry_iterator != entries_.constEnd() && entry_iterator->stamp == stamp) {
+    record = entry_iterator->record;
+    hits_++;
+
+    return true;
+  }
+
+  misses_++;
+
+  return false;
+}
+
+auto sss::extsystem::ComponentMetadataCache::Lookup(const QString& filename, FileStamp& stamp, QJsonObject& metadata)
+    -> bool {
+  Record record;
+
+  if (!Lookup(filename, stamp, record)) {
+    return false;
+  }
+
+  metadata = record.metadata;
+
+  return true;
+}
+
+auto sss::extsystem::ComponentMetadataCache::Insert(const QString& filename, const FileStamp& stamp,
+                                                    const Record& record) -> void {
+  if (!stamp.IsValid()) {
+    return;
+  }
+
+  entries_.insert(filename, Entry{stamp, record});
+  dirty_ = true;
+}
+
+auto sss::extsystem::ComponentMetadataCache::Insert(const QString& filename, const FileStamp& stamp,
+                                                    const QJsonObject& metadata) -> void {
+  Record record;
+
+  record.metadata = metadata;
+
+  Insert(filename, stamp, record);
+}
+
+auto sss::extsystem::ComponentMetadataCache::Stamp(const QString& filename) -> FileStamp {
+  FileStamp stamp;
+
+#if defined(Q_OS_UNIX)
+  struct stat file_status {};
+
+  if (::stat(QFile::encodeName(filename).constData(), &file_status) != 0) {
+    return stamp;
+  }
+
+  stamp.size = static_cast<qint64>(file_status.st_size);
+#if defined(Q_OS_MACOS)
+  const auto& modified = file_status.st_mtimespec;
+#else
+  const auto& modified = file_status.st_mtim;
+#endif
+
+  stamp.modified = static_cast<qint64>(modified.tv_sec) * 1000000000 + static_cast<qint64>(modified.tv_nsec);
+  stamp.inode = static_cast<quint64>(file_status.st_ino);
+#else
+  QFileInfo file_info(filename);
+
+  if (!file_info.exists()) {
+    return stamp;
+  }
+
+  stamp.size = file_info.size();
+  stamp.modified = file_info.lastModified().toMSecsSinceEpoch() * 1000000;
+#endif
+
+  return stamp;
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+
+#include "extsystem/ComponentDescriptor.h"
+
+namespace sss::extsystem {
+/**
+ * @brief       ComponentMetadataCache 在磁盘上缓存库文件的组件描述符和插件元数据。
+ *
+ * @details     缓存以库文件的绝对路径为键，并记录文件的大小、纳秒精度的修改时间和 inode。
+ *              只有这些属性都与磁盘上的文件一致时才认为缓存命中，命中时无需再打开库文件
+ *              读取嵌入式描述符或元数据。不是插件的库（元数据为空）同样会被缓存。
+ *
+ * @class       sss::extsystem::ComponentMetadataCache ComponentMetadataCache.h <ComponentMetadataCache>
+ */
+class ComponentMetadataCache {
+ public:
+  /**
+   * @brief       库文件的身份标识。
+   */
+  struct FileStamp {
+    qint64 size = -1;
+    qint64 modified = -1;  // 纳秒，同一秒内重新构建的库也会被识别为变化
+    quint64 inode = 0;
+
+    [[nodiscard]] auto IsValid() const -> bool { return size >= 0; }
+
+    auto operator==(const FileStamp& other) const -> bool {
+      return size == other.size && modified == other.modified && inode == other.inode;
+    }
+  };
+
+  /**
+   * @brief       从库文件读取的描述符或元数据。
+   */
+  struct Record {
+    QJsonObject metadata;  // 没有嵌入式描述符的库（第三方插件）的 Qt 插件元数据
+    sss::extsystem::ComponentDescriptor descriptor;
+    quint32 qt_version = 0;
+    bool debug_build = false;
+    bool has_descriptor = false;
+  };
+
+  /**
+   * @brief       构造使用给定缓存文件的 ComponentMetadataCache。
+   *
+   * @param[in]   cache_filename 缓存文件的路径。
+   */
+  explicit ComponentMetadataCache(QString cache_filename);
+
+  /**
+   * @brief       从磁盘加载缓存。
+   *
+   * @details     缓存文件不存在、版本不匹配或已损坏时，缓存为空。
+   *
+   * @returns     如果成功加载返回 true；否则返回 false。
+   */
+  auto Load() -> bool;
+
+  /**
+   * @brief       如果缓存有变化，将其写回磁盘。
+   *
+   * @details     写入前会丢弃已不存在的库文件的条目。
+   *
+   * @returns     如果写入成功或无需写入返回 true；否则返回 false。
+   */
+  auto Save() -> bool;
+
+  /**
+   * @brief       查找库文件的缓存记录。
+   *
+   * @param[in]   filename 库文件的绝对路径。
+   * @param[out]  stamp 库文件当前的身份标识，未命中时应传给 Insert()。
+   * @param[out]  record 命中时的缓存记录。
+   *
+   * @returns     如果命中返回 true；否则返回 false。
+   */
+  auto Lookup(const QString& filename, FileStamp& stamp, Record& record) -> bool;
+
+  /**
+   * @brief       查找库文件的缓存元数据。
+   *
+   * @details     只用于没有嵌入式描述符的库，见 Lookup(const QString&, FileStamp&, Record&)。
+   *
+   * @param[in]   filename 库文件的绝对路径。
+   * @param[out]  stamp 库文件当前的身份标识，未命中时应传给 Insert()。
+   * @param[out]  metadata 命中时的缓存元数据。
+   *
+   * @returns     如果命中返回 true；否则返回 false。
+   */
+  auto Lookup(const QString& filename, FileStamp& stamp, QJsonObject& metadata) -> bool;
+
+  /**
+   * @brief       记录库文件的描述符或元数据。
+   *
+   * @param[in]   filename 库文件的绝对路径。
+   * @param[in]   stamp 读取之前获取的身份标识。
+   * @param[in]   record 从库文件读取的描述符或元数据。
+   */
+  auto Insert(const QString& filename, const FileStamp& stamp, const Record& record) -> void;
+
+  /**
+   * @brief       记录库文件的元数据。
+   *
+   * @param[in]   filename 库文件的绝对路径。
+   * @param[in]   stamp 读取元数据之前获取的身份标识。
+   * @param[in]   metadata 从库文件读取的元数据。
+   */
+  auto Insert(const QString& filename, const FileStamp& stamp, const QJsonObject& metadata) -> void;
+
+  /**
+   * @brief       返回库文件当前的身份标识。
+   *
+   * @param[in]   filename 库文件的绝对路径。
+   *
+   * @returns     身份标识；如果文件不存在则无效。
+   */
+  static auto Stamp(const QString& filename) -> FileStamp;
+
+  /**
+   * @brief       返回自构造以来的命中次数。
+   */
+  [[nodiscard]] auto Hits() const -> int { return hits_; }
+
+  /**
+   * @brief       返回自构造以来的未命中次数。
+   */
+  [[nodiscard]] auto Misses() const -> int { return misses_; }
+
+ private:
+  //! @cond
+
+  struct Entry {
+    FileStamp stamp;
+    Record record;
+  };
+
+  QString cache_filename_;
+  QHash<QString, Entry> entries_;
+  bool dirty_ = false;
+  int hits_ = 0;
+  int misses_ = 0;
+
+  //! @endcond
+};
+}  // namespace sss::extsystem
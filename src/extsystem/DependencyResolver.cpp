@@ -0,0 +1,118 @@
+#include "DependencyResolver.h"
+
+#include <spdlog/spdlog.h>
+
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+#include <QVector>
+
+#include "extsystem/Component.h"
+
+auto sss::extsystem::DependencyResolver::Resolve(const QList<sss::extsystem::Component*>& components)
+    -> QList<sss::extsystem::Component*> {
+  struct Frame {
+    sss::extsystem::Component* component;
+    int next_dependency;
+  };
+
+  QList<sss::extsystem::Component*> resolved_list;
+
+  QHash<sss::extsystem::Component*, int> indices;
+  QHash<sss::extsystem::Component*, int> lowlinks;
+  QSet<sss::extsystem::Component*> on_stack;
+  QVector<sss::extsystem::Component*> component_stack;
+  QVector<Frame> call_stack;
+
+  auto next_index = 0;
+
+  auto visit = [&](sss::extsystem::Component* component) {
+    indices.insert(component, next_index);
+    lowlinks.insert(component, next_index);
+    next_index++;
+
+    component_stack.append(component);
+    on_stack.insert(component);
+    call_stack.append(Frame{component, 0});
+
+    // 每条依赖边只检查一次版本约束
+
+    for (auto* dependency : component->dependencies_) {
+      if (dependency->Version() < component->dependency_versions_.value(dependency)) {
+        component->load_flags_ |= sss::extsystem::ComponentLoader::kIncompatibleVersion;
+
+        SPDLOG_WARN("Component {} requires {} {} but version {} was found", component->Name().toStdString(),
+                    dependency->Name().toStdString(),
+                    component->dependency_versions_.value(dependency).toString().toStdString(),
+                    dependency->Version().toString().toStdString());
+      }
+    }
+  };
+
+  for (auto* root : components) {
+    if (indices.contains(root)) {
+      continue;
+    }
+
+    visit(root);
+
+    while (!call_stack.isEmpty()) {
+      auto* component = call_stack.last().component;
+      auto dependency_index = call_stack.last().next_dependency;
+
+      if (dependency_index < component->dependencies_.size()) {
+        call_stack.last().next_dependency++;
+
+        auto* dependency = component->dependencies_.at(dependency_index);
+
+        if (!indices.contains(dependency)) {
+          visit(dependency);
+        } else if (on_stack.contains(dependency)) {
+          lowlinks[component] = qMin(lowlinks.value(component), indices.value(dependency));
+        }
+
+        continue;
+      }
+
+      call_stack.removeLast();
+
+      if (!call_stack.isEmpty()) {
+        auto* parent = call_stack.last().component;
+
+        lowlinks[parent] = qMin(lowlinks.value(parent), lowlinks.value(component));
+      }
+
+      if (lowlinks.value(component) != indices.value(component)) {
+        continue;
+      }
+
+      // component 是一个强连通分量的根，弹出其所有成员
+
+      QList<sss::extsystem::Component*> members;
+      sss::extsystem::Component* member = nullptr;
+
+      do {
+        member = component_stack.takeLast();
+        on_stack.remove(member);
+        members.prepend(member);
+      } while (member != component);
+
+      if (members.size() == 1 && !component->dependencies_.contains(component)) {
+        resolved_list.append(component);
+        continue;
+      }
+
+      QStringList member_names;
+
+      for (auto* cycle_member : members) {
+        cycle_member->load_flags_.setFlag(sss::extsystem::ComponentLoader::kCircularDependency);
+        member_names.append(cycle_member->Name());
+      }
+
+      SPDLOG_ERROR("Circular dependency detected between components: {}",
+                   member_names.join(", ").toStdString());
+    }
+  }
+
+  return resolved_list;
+}
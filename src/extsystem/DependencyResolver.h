@@ -0,0 +1,35 @@
+#pragma once
+
+#include <QList>
+
+namespace sss::extsystem {
+class Component;
+
+/**
+ * @brief       DependencyResolver 计算组件的加载顺序。
+ *
+ * @details     使用迭代的 Tarjan 强连通分量算法遍历依赖图，时间复杂度与组件数和依赖边数呈线性关系。
+ *              强连通分量按依赖项在前的顺序产生，因此无环部分的输出顺序就是加载顺序。
+ *
+ *              解析过程中同时完成两项检查：
+ *              - 每个包含多个组件（或自依赖）的强连通分量都是一个循环，其中所有成员都会被标记为
+ *                kCircularDependency，并在日志中列出全部成员的名称；
+ *              - 每条依赖边只检查一次版本约束，不满足时依赖方被标记为 kIncompatibleVersion。
+ *
+ * @class       sss::extsystem::DependencyResolver DependencyResolver.h <DependencyResolver>
+ */
+class DependencyResolver {
+ public:
+  /**
+   * @brief       解析给定组件及其依赖项的加载顺序。
+   *
+   * @details     按 components 的顺序作为遍历起点，依赖项按声明顺序访问，因此结果是确定的。
+   *              循环中的组件不会出现在结果中，依赖它们的组件仍会出现，并在加载时因依赖项未加载而失败。
+   *
+   * @param[in]   components 要加载的组件。
+   *
+   * @returns     依赖项在前的组件列表。
+   */
+  static auto Resolve(const QList<sss::extsystem::Component*>& components) -> QList<sss::extsystem::Component*>;
+};
+}  // namespace sss::extsystem
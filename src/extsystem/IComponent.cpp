@@ -1,9 +1,27 @@
 #include "extsystem/IComponent.h"
 
+#include <QCoreApplication>
+#include <QThread>
+
 sss::extsystem::IComponent::~IComponent() = default;
 
+auto sss::extsystem::IComponent::InitialiseBackgroundEvent() -> void {}
+
 auto sss::extsystem::IComponent::InitialiseEvent() -> void {}
 
+auto sss::extsystem::IComponent::InitialiseAsyncEvent() -> QFuture<void> { return {}; }
+
 auto sss::extsystem::IComponent::InitialisationFinishedEvent() -> void {}
 
 auto sss::extsystem::IComponent::FinaliseEvent() -> void {}
+
+auto sss::extsystem::RunOnMainThread(const std::function<void()>& function) -> void {
+  auto* application = QCoreApplication::instance();
+
+  if (application == nullptr || QThread::currentThread() == application->thread()) {
+    function();
+    return;
+  }
+
+  QMetaObject::invokeMethod(application, function, Qt::BlockingQueuedConnection);
+}
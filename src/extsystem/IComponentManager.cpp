@@ -1,6 +1,26 @@
 #include "extsystem/IComponentManager.h"
 
-sss::extsystem::IComponentManager::~IComponentManager() = default;
+#include <QMutexLocker>
+#include <QThread>
+#include <utility>
+
+struct sss::extsystem::IComponentManager::TypeEntry {
+  QByteArray type_key;
+  QList<QObject*> objects;
+  TypeEntry* next;
+};
+
+sss::extsystem::IComponentManager::Snapshot::~Snapshot() {
+  auto* entry = lazy_entries.load(std::memory_order_acquire);
+
+  while (entry != nullptr) {
+    delete std::exchange(entry, entry->next);
+  }
+}
+
+sss::extsystem::IComponentManager::IComponentManager() { snapshot_.store(new Snapshot, std::memory_order_release); }
+
+sss::extsystem::IComponentManager::~IComponentManager() { delete snapshot_.load(std::memory_order_acquire); }
 
 auto sss::extsystem::IComponentManager::GetInstance() -> sss::extsystem::IComponentManager* {
   static IComponentManager component_manager;
@@ -12,9 +32,164 @@ auto sss::extsystem::IComponentManager::AddObject(QObject* object) -> void {
   if (object == nullptr) {
     return;
   }
-  object_list_.append(object);
+
+  {
+    QMutexLocker locker(&write_mutex_);
+
+    auto* next_snapshot = copySnapshot(*snapshot_.load(std::memory_order_acquire));
+
+    next_snapshot->objects.append(object);
+
+    for (auto index_iterator = next_snapshot->type_index.begin(); index_iterator != next_snapshot->type_index.end();
+         ++index_iterator) {
+      if (object->qt_metacast(index_iterator.key().constData()) != nullptr) {
+        index_iterator.value().append(object);
+      }
+    }
+
+    publish(next_snapshot);
+  }
+
+  Q_EMIT ObjectAdded(object);
+}
+
+auto sss::extsystem::IComponentManager::RemoveObject(QObject* object) -> void {
+  {
+    QMutexLocker locker(&write_mutex_);
+
+    const auto* current_snapshot = snapshot_.load(std::memory_order_acquire);
+
+    if (!current_snapshot->objects.contains(object)) {
+      return;
+    }
+
+    auto* next_snapshot = copySnapshot(*current_snapshot);
+
+    next_snapshot->objects.removeAll(object);
+
+    for (auto index_iterator = next_snapshot->type_index.begin(); index_iterator != next_snapshot->type_index.end();
+         ++index_iterator) {
+      index_iterator.value().removeAll(object);
+    }
+
+    publish(next_snapshot);
+  }
+
+  Q_EMIT ObjectRemoved(object);
+}
+
+auto sss::extsystem::IComponentManager::AllObjects() -> QList<QObject*> {
+  auto slot = enterRead();
+
+  auto objects = snapshot_.load(std::memory_order_seq_cst)->objects;
+
+  leaveRead(slot);
+
+  return objects;
+}
+
+auto sss::extsystem::IComponentManager::TypedObjects(const char* type_key) -> QList<QObject*> {
+  if (type_key == nullptr) {
+    return {};
+  }
+
+  // 查找时不复制键，只有首次建立索引时才保存一份深拷贝
+  auto lookup_key = QByteArray::fromRawData(type_key, int(qstrlen(type_key)));
+
+  auto slot = enterRead();
+
+  const auto* current_snapshot = snapshot_.load(std::memory_order_seq_cst);
+  QList<QObject*> typed_objects;
+
+  auto index_iterator = current_snapshot->type_index.constFind(lookup_key);
+
+  if (index_iterator != current_snapshot->type_index.constEnd()) {
+    typed_objects = index_iterator.value();
+
+    leaveRead(slot);
+
+    return typed_objects;
+  }
+
+  auto* first_entry = current_snapshot->lazy_entries.load(std::memory_order_acquire);
+
+  for (auto* entry = first_entry; entry != nullptr; entry = entry->next) {
+    if (entry->type_key == lookup_key) {
+      typed_objects = entry->objects;
+
+      leaveRead(slot);
+
+      return typed_objects;
+    }
+  }
+
+  // 首次查询此类型：扫描快照并把结果追加到快照的索引项链表，不获取写者的锁。并发的首次查询可能各自追加一项，
+  // 内容相同，查找时使用最先找到的一项
+  for (auto* object : current_snapshot->objects) {
+    if (object->qt_metacast(type_key) != nullptr) {
+      typed_objects.append(object);
+    }
+  }
+
+  auto* new_entry = new TypeEntry{QByteArray(type_key), typed_objects, first_entry};
+
+  while (!current_snapshot->lazy_entries.compare_exchange_weak(new_entry->next, new_entry, std::memory_order_release,
+                                                               std::memory_order_relaxed)) {
+  }
+
+  leaveRead(slot);
+
+  return typed_objects;
 }
 
-auto sss::extsystem::IComponentManager::RemoveObject(QObject* object) -> void { object_list_.removeAll(object); }
+auto sss::extsystem::IComponentManager::enterRead() -> int {
+  for (;;) {
+    auto epoch = read_epoch_.load(std::memory_order_seq_cst);
+    auto slot = int(epoch & 1);
+
+    active_readers_[slot].fetch_add(1, std::memory_order_seq_cst);
 
-auto sss::extsystem::IComponentManager::AllObjects() -> QList<QObject*> { return object_list_; }
+    // 计数期间纪元没有改变，写者一定会等待这个计数归零
+    if (read_epoch_.load(std::memory_order_seq_cst) == epoch) {
+      return slot;
+    }
+
+    active_readers_[slot].fetch_sub(1, std::memory_order_release);
+  }
+}
+
+auto sss::extsystem::IComponentManager::leaveRead(int slot) -> void {
+  active_readers_[slot].fetch_sub(1, std::memory_order_release);
+}
+
+auto sss::extsystem::IComponentManager::copySnapshot(const Snapshot& snapshot) -> Snapshot* {
+  auto* next_snapshot = new Snapshot;
+
+  next_snapshot->objects = snapshot.objects;
+  next_snapshot->type_index = snapshot.type_index;
+
+  // 读者追加的索引项并入新快照的索引，新快照的链表从空开始
+  for (auto* entry = snapshot.lazy_entries.load(std::memory_order_acquire); entry != nullptr; entry = entry->next) {
+    if (!next_snapshot->type_index.contains(entry->type_key)) {
+      next_snapshot->type_index.insert(entry->type_key, entry->objects);
+    }
+  }
+
+  return next_snapshot;
+}
+
+auto sss::extsystem::IComponentManager::publish(const Snapshot* snapshot) -> void {
+  const auto* previous_snapshot = snapshot_.exchange(snapshot, std::memory_order_seq_cst);
+
+  // 宽限期：纪元每次发布前进两次，每次翻转后等待上一个纪元的读者离开。交换之前进入的读者都计在这两个计数中，
+  // 之后进入的读者只能看到新快照
+  for (auto flip = 0; flip < 2; flip++) {
+    auto epoch = read_epoch_.fetch_add(1, std::memory_order_seq_cst);
+
+    while (active_readers_[epoch & 1].load(std::memory_order_seq_cst) != 0) {
+      QThread::yieldCurrentThread();
+    }
+  }
+
+  delete previous_snapshot;
+}
@@ -0,0 +1,138 @@
+#include "LibraryPrefetcher.h"
+
+#include <spdlog/spdlog.h>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QThread>
+#include <utility>
+
+#include "extsystem/StartupTrace.h"
+
+#if defined(Q_OS_LINUX)
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+// 把整个文件读入页缓存，Linux 上 readahead() 在读取完成后才返回
+auto ReadAhead(const QString& filename) -> void {
+#if defined(Q_OS_LINUX)
+  auto file_descriptor = ::open(QFile::encodeName(filename).constData(), O_RDONLY | O_CLOEXEC);
+
+  if (file_descriptor < 0) {
+    return;
+  }
+
+  struct stat file_status = {};
+
+  if (::fstat(file_descriptor, &file_status) == 0 && file_status.st_size > 0) {
+    ::readahead(file_descriptor, 0, static_cast<size_t>(file_status.st_size));
+  }
+
+  ::close(file_descriptor);
+#else
+  Q_UNUSED(filename)
+#endif
+}
+
+// 以与 QPluginLoader 相同的 RTLD_LOCAL 打开库并立即解析所有符号，失败时返回 nullptr
+auto PreOpen(const QString& filename) -> void* {
+#if defined(Q_OS_LINUX)
+  auto* handle = ::dlopen(QFile::encodeName(filename).constData(), RTLD_NOW | RTLD_LOCAL);
+
+  if (handle == nullptr) {
+    // 主线程的 QPluginLoader::load() 会再次尝试并报告错误
+    SPDLOG_DEBUG("Pre-opening {} failed: {}", filename.toStdString(), ::dlerror());
+  }
+
+  return handle;
+#else
+  Q_UNUSED(filename)
+
+  return nullptr;
+#endif
+}
+}  // namespace
+
+sss::extsystem::LibraryPrefetcher::LibraryPrefetcher(QStringList filenames) : filenames_(std::move(filenames)) {
+  for (const auto& filename : filenames_) {
+    remaining_.insert(filename);
+  }
+}
+
+sss::extsystem::LibraryPrefetcher::~LibraryPrefetcher() {
+  cancelled_.store(true);
+
+  if (thread_) {
+    thread_->wait();
+  }
+
+  // 释放预先打开的引用，没有被 QPluginLoader 加载的库（例如被跳过的组件）在这里卸载
+
+#if defined(Q_OS_LINUX)
+  for (auto* handle : qAsConst(library_handles_)) {
+    ::dlclose(handle);
+  }
+#endif
+}
+
+auto sss::extsystem::LibraryPrefetcher::Start() -> void {
+  if (thread_ || filenames_.isEmpty()) {
+    return;
+  }
+
+  thread_.reset(QThread::create([this]() { run(); }));
+  thread_->start();
+}
+
+auto sss::extsystem::LibraryPrefetcher::Claim(const QString& filename) -> bool {
+  QMutexLocker locker(&mutex_);
+
+  return remaining_.remove(filename);
+}
+
+auto sss::extsystem::LibraryPrefetcher::Wait() -> void {
+  if (thread_) {
+    thread_->wait();
+  }
+}
+
+auto sss::extsystem::LibraryPrefetcher::run() -> void {
+  for (const auto& filename : filenames_) {
+    if (cancelled_.load()) {
+      break;
+    }
+
+    {
+      QMutexLocker locker(&mutex_);
+
+      // 主线程已经开始加载的库不再预取
+
+      if (!remaining_.contains(filename)) {
+        continue;
+      }
+    }
+
+    sss::extsystem::StartupTrace::Span trace_span(
+        [&](QJsonObject& args) {
+          args.insert("library", filename);
+          return "Prefetch " + QFileInfo(filename).fileName();
+        },
+        "load");
+
+    ReadAhead(filename);
+
+    auto* handle = PreOpen(filename);
+
+    if (handle != nullptr) {
+      QMutexLocker locker(&mutex_);
+
+      library_handles_.append(handle);
+    }
+  }
+}
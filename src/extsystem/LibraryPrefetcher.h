@@ -0,0 +1,81 @@
+#pragma once
+
+#include <QList>
+#include <QMutex>
+#include <QSet>
+#include <QStringList>
+#include <atomic>
+#include <memory>
+
+class QThread;
+
+namespace sss::extsystem {
+/**
+ * @brief       LibraryPrefetcher 在工作线程中按加载顺序预先打开组件库。
+ *
+ * @details     工作线程把每个库文件读入页缓存（Linux 上为 readahead），然后用 dlopen(RTLD_NOW) 预先打开库，
+ *              使磁盘 I/O、缺页和符号重定位与主线程上已加载组件的初始化重叠。主线程随后的
+ *              QPluginLoader::load() 只增加库的引用计数，插件实例仍在主线程中创建。
+ *
+ *              库的静态初始化代码在工作线程中运行，因此组件不应在静态初始化中创建 QObject；Qt 插件的实例
+ *              由 qt_plugin_instance() 在首次调用时创建，不受影响。
+ *
+ *              主线程开始加载某个库之前调用 Claim()，工作线程随后跳过该文件。预先打开的库在析构时关闭，
+ *              已由 QPluginLoader 加载的库仍保持打开。
+ *
+ * @class       sss::extsystem::LibraryPrefetcher LibraryPrefetcher.h <LibraryPrefetcher>
+ */
+class LibraryPrefetcher {
+ public:
+  /**
+   * @brief       构造预取给定库文件的 LibraryPrefetcher。
+   *
+   * @param[in]   filenames 按加载顺序排列的库文件。
+   */
+  explicit LibraryPrefetcher(QStringList filenames);
+
+  /**
+   * @brief       停止预取并等待工作线程结束。
+   */
+  ~LibraryPrefetcher();
+
+  LibraryPrefetcher(const LibraryPrefetcher&) = delete;
+  auto operator=(const LibraryPrefetcher&) -> LibraryPrefetcher& = delete;
+
+  /**
+   * @brief       启动工作线程。
+   */
+  auto Start() -> void;
+
+  /**
+   * @brief       标记库文件即将在调用线程中加载，工作线程不再预读该文件。
+   *
+   * @details     不会阻塞；如果工作线程正在读取该文件，加载时的缺页会等待同一批页面。
+   *
+   * @param[in]   filename 库文件。
+   *
+   * @returns     如果文件在预取列表中且尚未被标记返回 true；否则返回 false。
+   */
+  auto Claim(const QString& filename) -> bool;
+
+  /**
+   * @brief       等待工作线程处理完所有文件。
+   */
+  auto Wait() -> void;
+
+ private:
+  //! @cond
+
+  auto run() -> void;
+
+  QStringList filenames_;
+  std::unique_ptr<QThread> thread_;
+  std::atomic<bool> cancelled_{false};
+
+  QMutex mutex_;
+  QSet<QString> remaining_;
+  QList<void*> library_handles_;
+
+  //! @endcond
+};
+}  // namespace sss::extsystem
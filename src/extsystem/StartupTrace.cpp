@@ -0,0 +1,136 @@
+#include "extsystem/StartupTrace.h"
+
+#include <spdlog/spdlog.h>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <atomic>
+
+namespace {
+struct TraceState {
+  std::atomic<bool> enabled{false};
+  QMutex mutex;
+  QElapsedTimer timer;
+  QString filename;
+  QJsonArray events;
+  QHash<Qt::HANDLE, int> thread_ids;
+};
+
+auto State() -> TraceState& {
+  static TraceState state;
+
+  return state;
+}
+
+// 将线程句柄映射为从 1 开始的小整数，主线程（第一个记录的线程）通常为 1
+auto ThreadId(TraceState& state) -> int {
+  auto handle = QThread::currentThreadId();
+  auto thread_iterator = state.thread_ids.constFind(handle);
+
+  if (thread_iterator != state.thread_ids.constEnd()) {
+    return thread_iterator.value();
+  }
+
+  auto thread_id = state.thread_ids.size() + 1;
+  state.thread_ids.insert(handle, thread_id);
+
+  auto* application = QCoreApplication::instance();
+  auto is_main_thread = application != nullptr && QThread::currentThread() == application->thread();
+
+  state.events.append(QJsonObject{{"name", "thread_name"},
+                                  {"ph", "M"},
+                                  {"pid", 1},
+                                  {"tid", thread_id},
+                                  {"args", QJsonObject{{"name", is_main_thread ? QString("Main thread")
+                                                                               : QString("Worker %1").arg(thread_id)}}}});
+
+  return thread_id;
+}
+}  // namespace
+
+sss::extsystem::StartupTrace::Span::Span(const QString& name, const char* category, const QJsonObject& args)
+    : enabled_(StartupTrace::IsEnabled()), category_(category) {
+  if (!enabled_) {
+    return;
+  }
+
+  name_ = name;
+  args_ = args;
+  start_us_ = StartupTrace::Now();
+}
+
+sss::extsystem::StartupTrace::Span::~Span() {
+  if (!enabled_) {
+    return;
+  }
+
+  StartupTrace::AddSpan(name_, category_, start_us_, StartupTrace::Now() - start_us_, args_);
+}
+
+auto sss::extsystem::StartupTrace::Start(const QString& filename) -> void {
+  auto& state = State();
+  QMutexLocker locker(&state.mutex);
+
+  state.filename = filename;
+  state.events = QJsonArray();
+  state.thread_ids.clear();
+  state.timer.start();
+  state.enabled.store(true, std::memory_order_release);
+}
+
+auto sss::extsystem::StartupTrace::IsEnabled() -> bool { return State().enabled.load(std::memory_order_acquire); }
+
+auto sss::extsystem::StartupTrace::Now() -> qint64 { return State().timer.nsecsElapsed() / 1000; }
+
+auto sss::extsystem::StartupTrace::AddSpan(const QString& name, const char* category, qint64 start_us,
+                                            qint64 duration_us, const QJsonObject& args) -> void {
+  if (!IsEnabled()) {
+    return;
+  }
+
+  auto& state = State();
+  QMutexLocker locker(&state.mutex);
+
+  QJsonObject event{{"name", name},    {"cat", category}, {"ph", "X"}, {"ts", start_us},
+                    {"dur", duration_us}, {"pid", 1},        {"tid", ThreadId(state)}};
+
+  if (!args.isEmpty()) {
+    event.insert("args", args);
+  }
+
+  state.events.append(event);
+}
+
+auto sss::extsystem::StartupTrace::Finish() -> bool {
+  auto& state = State();
+  QMutexLocker locker(&state.mutex);
+
+  if (!state.enabled.exchange(false, std::memory_order_acq_rel)) {
+    return false;
+  }
+
+  QFile trace_file(state.filename);
+
+  if (!trace_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    SPDLOG_WARN("Unable to write startup trace {}: {}", state.filename.toStdString(),
+                trace_file.errorString().toStdString());
+    return false;
+  }
+
+  QJsonObject trace{{"traceEvents", state.events}, {"displayTimeUnit", "ms"}};
+
+  trace_file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact));
+
+  SPDLOG_INFO("Startup trace with {} events written to {}", state.events.size(), state.filename.toStdString());
+
+  state.events = QJsonArray();
+
+  return true;
+}
@@ -7,6 +7,7 @@
 #include <QString>
 #include <QVersionNumber>
 
+#include "extsystem/ComponentDescriptor.h"
 #include "extsystem/ComponentLoader.h"
 #include "extsystem/ComponentSystemSpec.h"
 
@@ -32,6 +33,16 @@ class EXT_SYSTEM_DLLSPEC Component {
    */
   Component(const QString& name, const QString& filename, const QJsonObject& metadata);
 
+  /**
+   * @brief       使用已解析的描述符构造新的 Component。
+   *
+   * @details     用于带有嵌入式描述符的组件，Metadata() 返回空对象。
+   *
+   * @param[in]   filename 组件的文件名。
+   * @param[in]   descriptor 组件的描述符。
+   */
+  Component(const QString& filename, sss::extsystem::ComponentDescriptor descriptor);
+
   /**
    * @brief       向此组件添加组件依赖项。
    *
@@ -93,19 +104,28 @@ class EXT_SYSTEM_DLLSPEC Component {
    */
   auto MissingDependencies() -> QStringList;
 
+  /**
+   * @brief       返回解析后的组件元数据。
+   *
+   * @details     元数据在构造组件时解析一次，下面的访问函数都直接读取描述符中的字段。
+   *
+   * @returns     组件描述符。
+   */
+  [[nodiscard]] auto Descriptor() const -> const sss::extsystem::ComponentDescriptor&;
+
   /**
    * @brief       返回组件的版本。
    *
    * @returns     组件版本。
    */
-  auto Version() -> QVersionNumber;
+  [[nodiscard]] auto Version() const -> QVersionNumber;
 
   /**
    * @brief       返回组件的格式化版本字符串。
    *
    * @returns     格式化的版本字符串。
    */
-  auto VersionString() -> QString;
+  [[nodiscard]] auto VersionString() const -> QString;
 
   /**
    * @brief       返回组件的反向 DNS 标识符。
@@ -113,14 +133,14 @@ class EXT_SYSTEM_DLLSPEC Component {
    * @returns     标识符。
    *
    */
-  auto Identifier() -> QString;
+  [[nodiscard]] auto Identifier() const -> QString;
 
   /**
    * @brief       返回此组件所属的类别。
    *
    * @returns     组件的类别。
    */
-  auto Category() -> QString;
+  [[nodiscard]] auto Category() const -> QString;
 
   /**
    * @brief       返回组件的供应商。
@@ -128,14 +148,14 @@ class EXT_SYSTEM_DLLSPEC Component {
    * @returns     供应商。
    *
    */
-  auto Vendor() -> QString;
+  [[nodiscard]] auto Vendor() const -> QString;
 
   /**
    * @brief       返回组件的许可证文本。
    *
    * @returns     许可证文本。
    */
-  auto License() -> QString;
+  [[nodiscard]] auto License() const -> QString;
 
   /**
    * @brief       返回组件的版权信息。
@@ -143,7 +163,7 @@ class EXT_SYSTEM_DLLSPEC Component {
    * @returns     版权文本。
    *
    */
-  auto Copyright() -> QString;
+  [[nodiscard]] auto Copyright() const -> QString;
 
   /**
    * @brief       返回组件的描述。
@@ -151,7 +171,7 @@ class EXT_SYSTEM_DLLSPEC Component {
    * @returns     描述文本。
    *
    */
-  auto Description() -> QString;
+  [[nodiscard]] auto Description() const -> QString;
 
   /**
    * @brief       返回组件的 URL。
@@ -159,7 +179,7 @@ class EXT_SYSTEM_DLLSPEC Component {
    * @returns     URL。
    *
    */
-  auto Url() -> QString;
+  [[nodiscard]] auto Url() const -> QString;
 
   /**
    * @brief       返回依赖项的字符串列表。
@@ -167,7 +187,7 @@ class EXT_SYSTEM_DLLSPEC Component {
    * @returns     依赖项。
    *
    */
-  auto Dependencies() -> QString;
+  [[nodiscard]] auto Dependencies() const -> QString;
 
   /**
    * @brief       返回组件是否可以禁用。
@@ -177,17 +197,52 @@ class EXT_SYSTEM_DLLSPEC Component {
    * @returns     如果组件可以禁用返回 true；否则返回 false。
    *
    */
-  auto CanBeDisabled() -> bool;
+  [[nodiscard]] auto CanBeDisabled() const -> bool;
+
+  /**
+   * @brief       返回组件是否选择在工作线程中并行执行后台初始化。
+   *
+   * @details     由元数据中的 "ConcurrentInitialise" 标志控制，默认为 false。
+   *
+   * @returns     如果组件的 InitialiseBackgroundEvent 可以并行调用返回 true；否则返回 false。
+   */
+  [[nodiscard]] auto InitialisesConcurrently() const -> bool;
+
+  /**
+   * @brief       返回组件在快速关闭时是否仍需调用 FinaliseEvent。
+   *
+   * @details     由元数据中的 "FinaliseOnExit" 标志控制，默认为 false。需要在退出时写回数据的组件应设置此标志。
+   *
+   * @returns     如果快速关闭时必须调用 FinaliseEvent 返回 true；否则返回 false。
+   */
+  [[nodiscard]] auto FinalisesOnExit() const -> bool;
+
+  /**
+   * @brief       返回组件声明的给定类型的延迟激活触发器。
+   *
+   * @param[in]   trigger 触发器类型。
+   *
+   * @returns     触发器标识符列表；如果组件没有声明此类型的触发器则为空。
+   */
+  [[nodiscard]] auto ActivationTriggers(sss::extsystem::ComponentLoader::ActivationTrigger trigger) const
+      -> QStringList;
+
+  /**
+   * @brief       返回组件是否声明了任何延迟激活触发器。
+   *
+   * @returns     如果组件可以延迟加载返回 true；否则返回 false。
+   */
+  [[nodiscard]] auto IsLazy() const -> bool;
 
   /**
    * @brief       验证依赖项。
    *
-   * @details     验证所有依赖项以确保它们已加载，并确保加载的版本
-   *              满足我们的最低要求。
+   * @details     验证所有依赖项以确保它们已加载。版本约束已在依赖解析期间检查。
    */
   auto ValidateDependencies() -> void;
 
   friend class ComponentLoader;
+  friend class DependencyResolver;
 
  private:
   //! @cond
@@ -196,6 +251,7 @@ class EXT_SYSTEM_DLLSPEC Component {
   QString filename_;
   QList<sss::extsystem::Component*> dependencies_;
   QJsonObject metadata_;
+  sss::extsystem::ComponentDescriptor descriptor_;
   bool is_loaded_;
   sss::extsystem::ComponentLoader::LoadFlags load_flags_;
   QList<QString> missing_dependencies_;
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <QDataStream>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QVersionNumber>
+
+#include "extsystem/ComponentSystemSpec.h"
+
+namespace sss::extsystem {
+/**
+ * @brief       ComponentDescriptor 是解析后的组件元数据。
+ *
+ * @details     插件元数据中的 "MetaData" 对象只在构造组件时解析一次：字符串被驻留以便在多个描述符之间
+ *              共享，版本号和依赖项的版本约束预先解析为 QVersionNumber，布尔选项压缩为标志位。
+ *              描述符构造后不可修改，可以通过 QDataStream 高效地序列化。
+ *
+ * @class       sss::extsystem::ComponentDescriptor ComponentDescriptor.h <ComponentDescriptor>
+ */
+class EXT_SYSTEM_DLLSPEC ComponentDescriptor {
+ public:
+  /**
+   * @brief       依赖项及其所需的最低版本。
+   */
+  struct Dependency {
+    QString name;
+    QVersionNumber version;
+  };
+
+  /**
+   * @brief       组件选项标志。
+   */
+  enum Flag {  // NOLINT
+    kNone = 0,
+    kCanBeDisabled = 1,
+    kConcurrentInitialise = 2,
+    kLazy = 4,
+    kFinaliseOnExit = 8
+  };
+  Q_DECLARE_FLAGS(Flags, Flag)
+
+  /**
+   * @brief       构造空的 ComponentDescriptor。
+   */
+  ComponentDescriptor() = default;
+
+  /**
+   * @brief       从插件元数据的 "MetaData" 对象解析描述符。
+   *
+   * @param[in]   metadata 组件元数据。
+   * @param[in]   name 组件加载器解析出的组件名称（元数据缺少 "Name" 时回退到 "name" 或插件类名），
+   *              为空时使用元数据中的 "Name"。名称同时决定组件标识符。
+   *
+   * @returns     解析后的描述符。
+   */
+  static auto FromMetadata(const QJsonObject& metadata, const QString& name = QString()) -> ComponentDescriptor;
+
+  /**
+   * @brief       从嵌入式描述符解析描述符。
+   *
+   * @details     嵌入式描述符由构建步骤从 metadata.json 生成（见 EmbeddedDescriptor.h），字段已经过校验，
+   *              解析时只拆分字符串，不涉及 JSON。
+   *
+   * @param[in]   data 以嵌入式描述符头部开始的数据。
+   * @param[in]   size 数据的大小（字节）。
+   * @param[out]  descriptor 解析后的描述符。
+   * @param[out]  qt_version 组件构建时的 QT_VERSION。
+   * @param[out]  debug_build 组件是否为调试构建。
+   *
+   * @returns     如果数据是有效的嵌入式描述符返回 true；否则返回 false。
+   */
+  static auto FromEmbedded(const char* data, qint64 size, ComponentDescriptor& descriptor, quint32& qt_version,
+                           bool& debug_build) -> bool;
+
+  /**
+   * @brief       读取库文件中的嵌入式描述符。
+   *
+   * @details     ELF 库按节头表只读取 .dsdescriptor 节；其他库文件映射到内存并搜索描述符标记。
+   *              不加载库本身，可以在工作线程中调用。
+   *
+   * @param[in]   library_filename 库文件名。
+   * @param[out]  descriptor 解析后的描述符。
+   * @param[out]  qt_version 组件构建时的 QT_VERSION。
+   * @param[out]  debug_build 组件是否为调试构建。
+   *
+   * @returns     如果库文件包含有效的嵌入式描述符返回 true；否则返回 false（例如第三方插件）。
+   */
+  static auto FromLibrary(const QString& library_filename, ComponentDescriptor& descriptor, quint32& qt_version,
+                          bool& debug_build) -> bool;
+
+  /**
+   * @brief       返回驻留的字符串。
+   *
+   * @details     相同内容的字符串共享同一份数据，可以在工作线程中调用。
+   *
+   * @param[in]   string 要驻留的字符串。
+   *
+   * @returns     驻留后的字符串。
+   */
+  static auto Intern(const QString& string) -> QString;
+
+  [[nodiscard]] auto Name() const -> const QString& { return name_; }
+  [[nodiscard]] auto Version() const -> const QVersionNumber& { return version_; }
+  [[nodiscard]] auto VersionString() const -> const QString& { return version_string_; }
+  [[nodiscard]] auto Identifier() const -> const QString& { return identifier_; }
+  [[nodiscard]] auto Category() const -> const QString& { return category_; }
+  [[nodiscard]] auto Vendor() const -> const QString& { return vendor_; }
+  [[nodiscard]] auto License() const -> const QString& { return license_; }
+  [[nodiscard]] auto Copyright() const -> const QString& { return copyright_; }
+  [[nodiscard]] auto Description() const -> const QString& { return description_; }
+  [[nodiscard]] auto Url() const -> const QString& { return url_; }
+  [[nodiscard]] auto Dependencies() const -> const QVector<Dependency>& { return dependencies_; }
+  [[nodiscard]] auto ActivationModes() const -> const QStringList& { return activation_modes_; }
+  [[nodiscard]] auto ActivationContexts() const -> const QStringList& { return activation_contexts_; }
+  [[nodiscard]] auto ActivationCommands() const -> const QStringList& { return activation_commands_; }
+  [[nodiscard]] auto Options() const -> Flags { return flags_; }
+
+  auto operator==(const ComponentDescriptor& other) const -> bool;
+
+  friend EXT_SYSTEM_DLLSPEC auto operator<<(QDataStream& stream, const ComponentDescriptor& descriptor)
+      -> QDataStream&;
+  friend EXT_SYSTEM_DLLSPEC auto operator>>(QDataStream& stream, ComponentDescriptor& descriptor) -> QDataStream&;
+
+ private:
+  //! @cond
+
+  QString name_;
+  QVersionNumber version_;
+  QString version_string_;
+  QString identifier_;
+  QString category_;
+  QString vendor_;
+  QString license_;
+  QString copyright_;
+  QString description_;
+  QString url_;
+  QVector<Dependency> dependencies_;
+  QStringList activation_modes_;
+  QStringList activation_contexts_;
+  QStringList activation_commands_;
+  Flags flags_ = kCanBeDisabled;
+
+  //! @endcond
+};
+
+/**
+ * @brief       将描述符写入数据流。
+ */
+EXT_SYSTEM_DLLSPEC auto operator<<(QDataStream& stream, const ComponentDescriptor& descriptor) -> QDataStream&;
+
+/**
+ * @brief       从数据流读取描述符，读取的字符串会被驻留。
+ */
+EXT_SYSTEM_DLLSPEC auto operator>>(QDataStream& stream, ComponentDescriptor& descriptor) -> QDataStream&;
+}  // namespace sss::extsystem
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(sss::extsystem::ComponentDescriptor::Flags)
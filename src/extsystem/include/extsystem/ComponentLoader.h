@@ -1,17 +1,31 @@
 #pragma once
 
+#include <QHash>
+#include <QJsonObject>
 #include <QList>
 #include <QMap>
 #include <QObject>
 #include <QPair>
+#include <QSet>
+#include <QStringList>
+#include <QVersionNumber>
+#include <QtPlugin>
 #include <functional>
+#include <memory>
+#include <vector>
 
+#include "extsystem/ComponentDescriptor.h"
 #include "extsystem/ComponentSystemSpec.h"
 
+class QFileSystemWatcher;
 class QPluginLoader;
+class QTimer;
 
 namespace sss::extsystem {
 class Component;
+class ComponentMetadataCache;
+class IComponent;
+class LibraryPrefetcher;
 
 /**
  * @brief       ComponentLoader 加载发现的组件。
@@ -41,12 +55,39 @@ class EXT_SYSTEM_DLLSPEC ComponentLoader : public QObject {
     kIncompatibleVersion = 32,
     kUnableToLoad = 64,
     kMissingInterface = 128,
-    kCircularDependency = 256
+    kCircularDependency = 256,
+    kDeferred = 512
   };
   Q_ENUM(LoadFlag)
   Q_DECLARE_FLAGS(LoadFlags, LoadFlag)
   Q_FLAGS(LoadFlags)
 
+  /**
+   * @brief       延迟激活触发器的类型。
+   *
+   * @details     组件可以在元数据的 "Activation" 对象中声明触发器：
+   *
+   *              "Activation": { "Modes": ["..."], "Contexts": ["..."], "Commands": ["..."] }
+   *
+   *              声明了触发器的组件在启动时不会加载，直到对应的模式被激活、上下文变为活动状态
+   *              或命令被触发时才加载并初始化。
+   */
+  enum class ActivationTrigger {
+    kMode,     /**< 模式标识符 */
+    kContext,  /**< 上下文名称 */
+    kCommand   /**< 命令标识符 */
+  };
+  Q_ENUM(ActivationTrigger)
+
+  /**
+   * @brief       UnloadComponents() 的关闭策略。
+   */
+  enum class ShutdownPolicy {
+    kFull, /**< 按反向加载顺序为所有组件调用 FinaliseEvent，然后卸载所有库 */
+    kFast  /**< 只为声明了 "FinaliseOnExit" 的组件调用 FinaliseEvent，不卸载库，用于进程退出 */
+  };
+  Q_ENUM(ShutdownPolicy)
+
   /**
    * @brief       构造一个 ComponentLoader，它是 parent 的子对象。
    *
@@ -68,6 +109,39 @@ class EXT_SYSTEM_DLLSPEC ComponentLoader : public QObject {
    */
   auto AddComponents(const QString& component_folder) -> void;
 
+  /**
+   * @brief       并行扫描多个文件夹，并将其中的组件添加到加载列表。
+   *
+   * @details     先按文件夹顺序枚举所有候选库文件，再在线程池中并行读取各库的插件元数据，
+   *              最后在调用线程上按枚举顺序合并结果。合并顺序与依次对每个文件夹调用
+   *              AddComponents(const QString&) 相同，因此名称冲突检测的结果保持不变。
+   *
+   * @param[in]   component_folders 按优先级排列的搜索文件夹列表。
+   */
+  auto AddComponents(const QStringList& component_folders) -> void;
+
+  /**
+   * @brief       将链接进应用程序的静态组件添加到加载列表。
+   *
+   * @details     从 QPluginLoader::staticPlugins() 中查找实现 IComponent 接口的静态插件（通过
+   *              Q_IMPORT_PLUGIN 导入），使用其内嵌的元数据创建组件。静态组件与动态组件经过相同的依赖
+   *              解析和生命周期，只是加载时直接创建插件实例而不打开共享库。
+   *
+   *              应在 AddComponents 之前调用：之后扫描到的同名动态组件会被忽略。
+   */
+  auto AddStaticComponents() -> void;
+
+  /**
+   * @brief       设置插件元数据缓存文件。
+   *
+   * @details     设置后，AddComponents 以库文件的路径、大小、修改时间和 inode 为键查询缓存，
+   *              命中的库文件直接使用缓存的元数据创建组件而不再打开共享库，只有变化过的文件
+   *              才会重新读取，并在扫描结束后写回缓存。传入空字符串将禁用缓存。
+   *
+   * @param[in]   cache_filename 缓存文件的路径，通常位于应用程序的存储文件夹中。
+   */
+  auto SetMetadataCacheFile(const QString& cache_filename) -> void;
+
   /**
    * @brief       加载所有发现的组件。
    *
@@ -76,6 +150,66 @@ class EXT_SYSTEM_DLLSPEC ComponentLoader : public QObject {
    */
   auto LoadComponents(std::function<bool(sss::extsystem::Component*)> load_function = nullptr) -> void;
 
+  /**
+   * @brief       监视组件文件夹，在运行时安装新添加的组件。
+   *
+   * @details     文件夹内容变化后（等待复制完成的短暂间隔）对监视的文件夹调用 InstallComponents()。
+   *              应在 LoadComponents() 之后调用，不存在的文件夹会被忽略。
+   *
+   * @param[in]   component_folders 要监视的文件夹列表。
+   */
+  auto WatchComponentFolders(const QStringList& component_folders) -> void;
+
+  /**
+   * @brief       在运行时安装给定文件夹中新出现的组件。
+   *
+   * @details     只读取尚未添加过的库文件的元数据，新组件的依赖项在已有组件和其他新组件中解析，
+   *              然后只加载和初始化这些新组件（以及它们需要的延迟依赖项），最后发出 ComponentsActivated
+   *              信号，使界面可以增量加入新组件的命令、菜单和工具栏。新组件同样应用 LoadComponents()
+   *              的加载函数和延迟激活规则。
+   *
+   *              与已有组件同名的库会被忽略，更新已加载的组件仍需重新启动应用程序。没有加载或延迟的库
+   *              （例如加载失败、缺少依赖项或仍在复制中）不计为已添加，文件夹下次变化时会再次读取；
+   *              其中不是组件、被禁用、Qt 版本不兼容或同名的库在文件本身（大小或修改时间）变化之前不再读取。
+   *
+   *              在组件加载或初始化期间调用时（例如由等待初始化时处理的文件夹变化通知调用），安装推迟到
+   *              当前加载结束之后执行，本次调用返回空列表。
+   *
+   * @param[in]   component_folders 搜索文件夹列表。
+   *
+   * @returns     按加载顺序排列的新加载的组件。
+   */
+  auto InstallComponents(const QStringList& component_folders) -> QList<sss::extsystem::Component*>;
+
+  /**
+   * @brief       激活声明了给定触发器的延迟组件。
+   *
+   * @details     按加载顺序加载声明了该触发器的所有延迟组件及其延迟的依赖项，为它们调用
+   *              InitialiseEvent（按加载顺序）和 InitialisationFinishedEvent（按反向加载顺序），
+   *              然后发出 ComponentsActivated 信号。
+   *
+   *              组件加载器等待后台或异步初始化时会处理事件，此时由排队调用（包括 RunOnMainThread）到达的
+   *              激活请求推迟到当前加载结束之后执行，本次调用返回 false。组件在 InitialiseEvent 中直接调用时
+   *              立即激活。
+   *
+   * @param[in]   trigger 触发器类型。
+   * @param[in]   identifier 模式标识符、上下文名称或命令标识符。
+   *
+   * @returns     如果有组件被激活返回 true；否则返回 false。
+   */
+  auto ActivateTrigger(ActivationTrigger trigger, const QString& identifier) -> bool;
+
+  /**
+   * @brief       返回尚未激活的给定类型的触发器。
+   *
+   * @details     可用于在组件加载之前显示占位的模式按钮或命令。
+   *
+   * @param[in]   trigger 触发器类型。
+   *
+   * @returns     触发器标识符到声明它的（第一个）延迟组件的映射。
+   */
+  auto PendingTriggers(ActivationTrigger trigger) -> QMap<QString, sss::extsystem::Component*>;
+
   /**
    * @brief       返回所有发现的组件列表。
    *
@@ -89,36 +223,235 @@ class EXT_SYSTEM_DLLSPEC ComponentLoader : public QObject {
 
   /**
    * @brief       卸载所有已加载的组件。
+   *
+   * @details     行为由关闭策略决定，见 SetShutdownPolicy()。
    */
   auto UnloadComponents() -> void;
 
+  /**
+   * @brief       设置 UnloadComponents() 的关闭策略。
+   *
+   * @details     快速关闭时，只有元数据中 "FinaliseOnExit" 为 true 的组件（例如需要写回数据的组件）会调用
+   *              FinaliseEvent。这些调用按依赖图的反向拓扑层级进行：同一层级的组件在线程池中并行执行，
+   *              依赖项在依赖它的组件完成之后才结束。其余组件的 FinaliseEvent 被跳过，库不会被卸载，
+   *              调用方随后应直接退出进程。
+   *
+   *              超过 finalise_timeout 毫秒仍未完成的 FinaliseEvent 会被记录到日志并放弃等待。
+   *
+   * @note        快速关闭时 FinaliseEvent 在工作线程中调用，需要访问 GUI 或注册对象时应使用 RunOnMainThread()。
+   *
+   * @param[in]   policy 关闭策略，默认为 ShutdownPolicy::kFull。
+   * @param[in]   finalise_timeout 快速关闭时等待 FinaliseEvent 的最长时间（毫秒）。
+   */
+  auto SetShutdownPolicy(ShutdownPolicy policy, int finalise_timeout = 5000) -> void;
+
+  /**
+   * @brief       设置是否在工作线程中预取组件库。
+   *
+   * @details     启用时（默认），加载组件期间工作线程按加载顺序把后续组件的共享库读入页缓存并预先打开，
+   *              使磁盘读取和符号重定位与主线程上的初始化重叠。插件仍在主线程中加载和创建实例。
+   *
+   * @param[in]   enabled 是否预取。
+   */
+  auto SetLibraryPrefetch(bool enabled) -> void;
+
+  /**
+   * @brief       延迟组件被激活或运行时安装的组件加载后发出的信号。
+   *
+   * @param[in]   components 按加载顺序排列的新激活的组件。
+   */
+  Q_SIGNAL void ComponentsActivated(const QList<sss::extsystem::Component*>& components);
+
+  /**
+   * @brief       组件完成初始化（包括异步初始化）后发出的信号。
+   *
+   * @details     在加载组件和激活延迟组件期间发出，可用于在启动画面中显示进度。等待异步初始化时
+   *              事件循环保持运行，因此接收者可以直接更新界面。
+   *
+   * @param[in]   component 完成初始化的组件。
+   * @param[in]   initialised_count 本轮已完成初始化的组件数。
+   * @param[in]   total_count 本轮要初始化的组件总数。
+   */
+  Q_SIGNAL void InitialisationProgress(sss::extsystem::Component* component, int initialised_count, int total_count);
+
  private:
   /**
-   * @brief       解析已加载组件的依赖项。
+   * @brief       检测应用程序自身的构建类型和 Qt 版本。
+   *
+   * @param[out]  application_debug_build 应用程序是否为调试构建。
+   * @param[out]  application_qt_version 应用程序加载的 Qt 版本。
+   */
+  static auto applicationBuild(bool& application_debug_build, QVersionNumber& application_qt_version) -> void;
+
+  /**
+   * @brief       返回给定文件夹中所有可能是组件的库文件。
    *
-   * @details     对于给定的组件，返回必须按顺序加载的组件列表，
-   *              以满足所有组件和子组件的依赖项。
+   * @param[in]   component_folder 搜索文件夹。
    *
-   * @param[in]   component 要解析的组件。
-   * @param[out]  resolvedList 已排序的组件列表。
+   * @returns     库文件的绝对路径列表（按目录迭代顺序）。
    */
-  auto resolve(sss::extsystem::Component* component, QList<sss::extsystem::Component*>& resolved_list) -> void;
+  static auto candidateLibraries(const QString& component_folder) -> QStringList;
+
+  //! @cond
+
+  struct LibraryMetadata {
+    QJsonObject metadata;  // 没有嵌入式描述符的库（第三方插件）的 Qt 插件元数据
+    sss::extsystem::ComponentDescriptor descriptor;
+    quint32 qt_version = 0;
+    bool debug_build = false;
+    bool has_descriptor = false;
+  };
+
+  //! @endcond
 
   /**
-   * @brief           解析已加载组件的依赖项。
+   * @brief       读取库文件中嵌入的插件元数据。
    *
-   * @details         对于给定的组件，返回必须按顺序加载的组件列表，
-   *                  以满足所有组件和子组件的依赖项。
+   * @note        不会加载库本身，可以在工作线程中调用。
    *
-   *                  此重载使用列表来标记节点为已处理，这允许我们检测
-   *                  循环引用。
+   * @param[in]   component_filename 库文件名。
    *
-   * @param[in]       component 要解析的组件。
-   * @param[in,out]   processedList 已处理节点的列表。
-   * @param[out]      resolvedList 已排序的组件列表。
+   * @returns     插件元数据；如果不是 Qt 插件则返回空对象。
    */
-  auto resolve(sss::extsystem::Component* component, QList<sss::extsystem::Component*>& resolved_list,
-               QList<sss::extsystem::Component*>& processed_list) -> void;
+  static auto readMetadata(const QString& component_filename) -> QJsonObject;
+
+  /**
+   * @brief       读取一组库文件的组件描述符或插件元数据。
+   *
+   * @details     先按文件的身份标识查找元数据缓存，缓存中同时保存解析后的描述符。未命中的库先读取构建时嵌入的
+   *              组件描述符（不解析 JSON），没有嵌入式描述符的库（第三方插件）再读取插件元数据。需要打开的文件
+   *              根据 parallel 在线程池中并行读取或串行读取。
+   *
+   * @param[in]   candidates 库文件列表。
+   * @param[in]   parallel 是否并行读取。
+   *
+   * @returns     与 candidates 一一对应的描述符或元数据。
+   */
+  auto readAllMetadata(const QStringList& candidates, bool parallel) -> std::vector<LibraryMetadata>;
+
+  /**
+   * @brief       将库文件的组件添加到搜索列表。
+   *
+   * @details     带有嵌入式描述符的库直接使用描述符创建组件，其余的库交给 JSON 元数据的校验流程。
+   *
+   * @param[in]   component_filename 库文件名。
+   * @param[in]   library_metadata 从库文件读取的描述符或元数据。
+   * @param[in]   application_debug_build 应用程序是否为调试构建。
+   * @param[in]   application_qt_version 应用程序加载的 Qt 版本。
+   *
+   * @returns     新创建的组件；如果元数据无效或已有同名的静态组件则返回 nullptr。
+   */
+  auto addComponent(const QString& component_filename, const LibraryMetadata& library_metadata,
+                    bool application_debug_build, const QVersionNumber& application_qt_version)
+      -> sss::extsystem::Component*;
+
+  /**
+   * @brief       检查是否已有同名的静态组件。
+   *
+   * @param[in]   component_filename 库文件名。
+   * @param[in]   component_name 组件名称。
+   *
+   * @returns     如果同名组件已静态链接（库文件将被忽略）返回 true；否则返回 false。
+   */
+  auto isStaticallyLinked(const QString& component_filename, const QString& component_name) -> bool;
+
+  /**
+   * @brief       检查新组件的 Qt 版本和名称冲突，并将其添加到搜索列表。
+   *
+   * @param[in]   component 新创建的组件。
+   * @param[in]   component_qt_version 组件构建时的 QT_VERSION。
+   * @param[in]   application_qt_version 应用程序加载的 Qt 版本。
+   *
+   * @returns     component。
+   */
+  auto registerComponent(sss::extsystem::Component* component, quint32 component_qt_version,
+                         const QVersionNumber& application_qt_version) -> sss::extsystem::Component*;
+
+  /**
+   * @brief       校验插件元数据，并将组件添加到搜索列表。
+   *
+   * @param[in]   component_filename 库文件名。
+   * @param[in]   meta_data_object 从库文件读取的插件元数据。
+   * @param[in]   application_debug_build 应用程序是否为调试构建。
+   * @param[in]   application_qt_version 应用程序加载的 Qt 版本。
+   *
+   * @returns     新创建的组件；如果元数据无效或已有同名的静态组件则返回 nullptr。
+   */
+  auto addComponent(const QString& component_filename, const QJsonObject& meta_data_object,
+                    bool application_debug_build, const QVersionNumber& application_qt_version)
+      -> sss::extsystem::Component*;
+
+  /**
+   * @brief       在搜索列表中查找组件的依赖项并建立依赖关系。
+   *
+   * @details     找不到的依赖项记录为缺失依赖项，并将组件标记为 kMissingDependency。
+   *
+   * @param[in]   component 组件。
+   */
+  auto linkDependencies(sss::extsystem::Component* component) -> void;
+
+  /**
+   * @brief       加载单个组件的共享库。
+   *
+   * @details     校验依赖项，成功后将组件追加到加载顺序中。静态组件直接创建插件实例。
+   *
+   * @param[in]   component 要加载的组件。
+   * @param[in]   prefetcher 在工作线程中预先打开库文件的预取器；可以为 nullptr。
+   *
+   * @returns     如果组件已加载返回 true；否则返回 false。
+   */
+  auto loadComponent(sss::extsystem::Component* component, sss::extsystem::LibraryPrefetcher* prefetcher = nullptr)
+      -> bool;
+
+  /**
+   * @brief       加载并初始化给定的组件。
+   *
+   * @details     先调用加载函数排除被禁用的组件，然后按依赖图的拓扑层级逐层加载和初始化：工作线程按层级顺序
+   *              预先打开各组件的库，主线程加载一个层级的组件后，该层级中选择并行初始化的组件在线程池中并行执行
+   *              InitialiseBackgroundEvent，主线程在等待期间处理事件；随后在主线程中按加载顺序调用该层级
+   *              各组件的 InitialiseEvent 和 InitialiseAsyncEvent，并在进入下一层级之前处理事件直到返回的
+   *              QFuture 全部完成。全部完成后按反向加载顺序调用 InitialisationFinishedEvent。
+   *              初始化期间被激活的组件会自行初始化，不包含在本次调用中。
+   *
+   * @param[in]   components 按依赖顺序排列的组件。
+   *
+   * @returns     按加载顺序排列的成功加载的组件。
+   */
+  auto loadAndInitialiseComponents(const QList<sss::extsystem::Component*>& components)
+      -> QList<sss::extsystem::Component*>;
+
+  /**
+   * @brief       在主线程中处理事件，等待后台初始化、异步初始化或快速关闭的结束事件。
+   *
+   * @details     不处理用户输入事件；等待期间到达的 ActivateTrigger 和 InstallComponents 请求被推迟。
+   */
+  auto waitForEvents() -> void;
+
+  /**
+   * @brief       排队执行加载期间被推迟的激活和安装请求。
+   */
+  auto scheduleDeferredRequests() -> void;
+
+  /**
+   * @brief       撤销本次安装中没有加载或延迟的库的注册，使其在文件夹下次变化时重新读取。
+   *
+   * @details     被加载函数禁用、Qt 版本不兼容或与已有组件同名的库不会因文件夹变化而改变结果，
+   *              按读取前的文件身份记入 rejected_libraries_，文件本身变化之前不再读取。
+   *
+   * @param[in]   registered_components 本次安装中注册的组件。
+   * @param[in]   installed_components 本次安装中已加载的组件。
+   * @param[in]   library_stamps 读取元数据之前各库文件的身份（大小和修改时间）。
+   */
+  auto forgetUninstalledLibraries(const QList<sss::extsystem::Component*>& registered_components,
+                                  const QList<sss::extsystem::Component*>& installed_components,
+                                  const QHash<QString, QPair<qint64, qint64>>& library_stamps) -> void;
+
+  /**
+   * @brief       按快速关闭策略卸载组件。
+   *
+   * @details     见 SetShutdownPolicy()。
+   */
+  auto fastUnloadComponents() -> void;
 
   /**
    * @brief       返回包含已设置标志的字符串。
@@ -131,8 +464,30 @@ class EXT_SYSTEM_DLLSPEC ComponentLoader : public QObject {
 
   //! @cond
 
-  QList<QPair<QPluginLoader*, sss::extsystem::Component*> > load_order_;
+  struct LoadedComponent {
+    QPluginLoader* plugin_loader;  // 静态组件为 nullptr
+    sss::extsystem::Component* component;
+    sss::extsystem::IComponent* component_interface;
+  };
+
+  QList<LoadedComponent> load_order_;
   QMap<QString, sss::extsystem::Component*> component_search_list_;
+  std::unique_ptr<sss::extsystem::ComponentMetadataCache> metadata_cache_;
+  std::function<bool(sss::extsystem::Component*)> load_function_;
+  QList<sss::extsystem::Component*> deferred_components_;
+  QHash<sss::extsystem::Component*, QtPluginInstanceFunction> static_instances_;
+  bool library_prefetch_ = true;
+  ShutdownPolicy shutdown_policy_ = ShutdownPolicy::kFull;
+  int finalise_timeout_ = 5000;
+  QSet<QString> added_libraries_;
+  QHash<QString, QPair<qint64, qint64>> rejected_libraries_;
+  QStringList watched_folders_;
+  QFileSystemWatcher* folder_watcher_ = nullptr;
+  QTimer* install_timer_ = nullptr;
+  int load_depth_ = 0;
+  bool waiting_for_events_ = false;
+  QList<QPair<ActivationTrigger, QString>> deferred_activations_;
+  QStringList deferred_install_folders_;
 
   //! @endcond
 };
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QtGlobal>
+#include <cstddef>
+
+/**
+ * @brief       嵌入式组件描述符的标记，组件加载器在库文件中搜索此标记。
+ */
+#define DS_EMBEDDED_DESCRIPTOR_MAGIC "DSCOMPONENTDESC"
+
+/**
+ * @brief       放置嵌入式组件描述符的段。
+ *
+ * @details     ELF 平台上放在独立的 .dsdescriptor 段中，紧邻 Qt 的 .qtmetadata 段；其他平台放在只读数据中，
+ *              由生成的导出函数引用以免被链接器丢弃。
+ */
+#if defined(Q_OF_ELF) && (defined(Q_CC_GNU) || defined(Q_CC_CLANG))
+#define DS_EMBEDDED_DESCRIPTOR_SECTION __attribute__((section(".dsdescriptor"), used))
+#else
+#define DS_EMBEDDED_DESCRIPTOR_SECTION
+#endif
+
+namespace sss::extsystem {
+/**
+ * @brief       嵌入式组件描述符的格式版本，布局变化时递增。
+ */
+constexpr quint32 kEmbeddedDescriptorFormat = 1;
+
+/**
+ * @brief       嵌入式组件描述符的固定布局头部。
+ *
+ * @details     由 cmake/component_descriptor.cmake 在构建时从组件的 metadata.json 生成。头部之后紧跟
+ *              fields_size 字节的字段区：按 EmbeddedDescriptorField 的顺序排列的 UTF-8 字符串，以 '\0' 分隔。
+ *              列表字段的元素以 0x1F 分隔，依赖项之间以 0x1E 分隔（每个依赖项为 "名称 0x1F 版本"）。
+ */
+struct EmbeddedDescriptorHeader {
+  char magic[sizeof(DS_EMBEDDED_DESCRIPTOR_MAGIC)];
+  quint32 format;
+  quint32 qt_version;
+  quint32 debug_build;
+  quint32 fields_size;
+};
+
+/**
+ * @brief       嵌入式组件描述符。
+ *
+ * @tparam      FieldsSize 字段区的大小（字节）。
+ */
+template <std::size_t FieldsSize>
+struct EmbeddedDescriptor {
+  EmbeddedDescriptorHeader header;
+  char fields[FieldsSize];
+};
+
+/**
+ * @brief       嵌入式组件描述符字段区中字段的顺序。
+ */
+enum class EmbeddedDescriptorField {
+  kName,
+  kVersion,
+  kBranch,
+  kRevision,
+  kVendor,
+  kCategory,
+  kCopyright,
+  kUrl,
+  kLicense,
+  kDescription,
+  kDependencies,
+  kActivationModes,
+  kActivationContexts,
+  kActivationCommands,
+  kOptions,
+  kCount
+};
+}  // namespace sss::extsystem
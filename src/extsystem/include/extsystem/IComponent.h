@@ -1,10 +1,13 @@
 #pragma once
 
+#include <QFuture>
 #include <QObject>
+#include <functional>
 
 #include "extsystem/ComponentSystemSpec.h"
 
-#define SSSComponentInterfaceIID "sss.IComponent/1.0"
+// 虚函数表布局变化时必须提升版本，使按旧头文件构建的组件在加载前被拒绝
+#define SSSComponentInterfaceIID "sss.IComponent/2.0"
 
 namespace sss::extsystem {
 /**
@@ -22,6 +25,18 @@ class EXT_SYSTEM_DLLSPEC IComponent {
    */
   virtual ~IComponent();
 
+  /**
+   * @brief       后台初始化事件在工作线程中执行组件与 GUI 无关的初始化。
+   *
+   * @details     仅当组件元数据中 "ConcurrentInitialise" 为 true 时调用。组件加载器按依赖图的
+   *              拓扑层级调度：同一层级的组件并行执行此事件，依赖项的 InitialiseEvent 总是在此之前
+   *              完成，而组件自身的 InitialiseEvent 在此之后于主线程中调用。
+   *
+   * @note        适合读取标定文件、加载模型等耗时工作。需要访问 GUI 或注册对象时应使用
+   *              RunOnMainThread()，或放到 InitialiseEvent 中完成。
+   */
+  virtual auto InitialiseBackgroundEvent() -> void;
+
   /**
    * @brief       初始化事件由组件加载器调用来初始化组件。
    *
@@ -29,6 +44,19 @@ class EXT_SYSTEM_DLLSPEC IComponent {
    */
   virtual auto InitialiseEvent() -> void;
 
+  /**
+   * @brief       异步初始化事件在 InitialiseEvent 之后于主线程中调用，返回尚未完成的初始化工作。
+   *
+   * @details     组件可以在此启动耗时工作（例如用 QtConcurrent::run 读取标定表或大型资源）并返回其 QFuture。
+   *              组件加载器在等待期间处理事件，启动画面保持响应；依赖此组件的组件在 QFuture 完成后才开始
+   *              初始化，InitialisationFinishedEvent 在所有异步初始化完成后调用。
+   *
+   *              默认实现返回已完成的 QFuture，组件加载器不会等待。
+   *
+   * @returns     异步初始化的 QFuture。
+   */
+  virtual auto InitialiseAsyncEvent() -> QFuture<void>;
+
   /**
    * @brief       初始化完成事件函数在所有组件初始化完成后由组件加载器调用。
    *
@@ -41,9 +69,25 @@ class EXT_SYSTEM_DLLSPEC IComponent {
    *
    * @note        对于所有已加载的组件，该事件按加载顺序的逆序调用，一旦每个组件
    *              都完成结束操作，组件管理器将以相同的顺序卸载所有组件。
+   *
+   * @note        快速关闭（ComponentLoader::ShutdownPolicy::kFast）时只为元数据中声明了 "FinaliseOnExit"
+   *              的组件调用，并且在 QThreadPool 的工作线程中执行，同一依赖层级的组件并行结束。因此这些组件的
+   *              FinaliseEvent 不能依赖调用线程：不能直接访问 GUI 或创建 QObject，需要时使用 RunOnMainThread()。
+   *              超时未完成的层级之后的组件不再结束。
    */
   virtual auto FinaliseEvent() -> void;
 };
+
+/**
+ * @brief       在主线程中执行 function 并等待其完成。
+ *
+ * @details     在主线程中调用时直接执行，否则将其排队到主线程的事件循环并阻塞等待。
+ *              组件加载器在等待后台初始化时会处理事件，因此可以在 InitialiseBackgroundEvent
+ *              中安全地使用。
+ *
+ * @param[in]   function 要执行的函数。
+ */
+EXT_SYSTEM_DLLSPEC auto RunOnMainThread(const std::function<void()>& function) -> void;
 }  // namespace sss::extsystem
 
 Q_DECLARE_INTERFACE(sss::extsystem::IComponent, SSSComponentInterfaceIID)
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
 #include <QObject>
+#include <atomic>
+#include <type_traits>
 
 #include "extsystem/ComponentSystemSpec.h"
 
@@ -11,6 +16,12 @@ namespace sss::extsystem {
  * @details     除了处理组件的管理外，此类还为组件提供全局
  *              注册表。
  *
+ *              注册表可以从任意线程并发读取，读者不获取任何锁：进入读区时在当前纪元的读者计数上做一次原子递增，
+ *              从当前不可变快照中复制列表（隐式共享，不复制元素）后递减。写者（AddObject、RemoveObject）相互串行，
+ *              复制当前快照、修改副本后以原子交换发布，然后把纪元前进两次，每次等待上一个纪元的读者计数归零
+ *              （宽限期），之后删除旧快照。因此写者可能短暂等待读者，读者从不等待写者，运行时反复安装和卸载组件
+ *              也不会累积旧快照。
+ *
  * @class       sss::extsystem::IComponentManager IComponentManager.h <IComponentManager>
  */
 class EXT_SYSTEM_DLLSPEC IComponentManager : public QObject {
@@ -21,7 +32,7 @@ class EXT_SYSTEM_DLLSPEC IComponentManager : public QObject {
   /**
    * @brief       构造一个新的 IComponentManager。
    */
-  IComponentManager() = default;
+  IComponentManager();
 
   /**
    * @brief       销毁 IComponentManager。
@@ -50,6 +61,24 @@ class EXT_SYSTEM_DLLSPEC IComponentManager : public QObject {
    */
   auto AllObjects() -> QList<QObject*>;
 
+  /**
+   * @brief       返回注册表中所有实现给定类型的对象。
+   *
+   * @details     类型由键标识：QObject 派生类使用类名，纯接口使用 Q_DECLARE_INTERFACE 的 IID，
+   *              对象是否匹配由 QObject::qt_metacast() 判断，与 qobject_cast 的语义一致。
+   *              每种类型首次查询时由读者扫描快照，并以比较交换把结果追加到快照的索引项链表（不获取锁）；
+   *              下一次 AddObject() 或 RemoveObject() 把这些项并入新快照的索引并增量维护，
+   *              因此后续查询是常数时间且不分配内存的。结果保持注册顺序。
+   *
+   * @note        返回快照中列表的隐式共享副本（不复制元素），不会反映之后的修改。
+   *              通常通过 GetTObject() 和 GetTObjects() 使用。
+   *
+   * @param[in]   type_key 类型键。
+   *
+   * @returns     匹配的对象列表。
+   */
+  auto TypedObjects(const char* type_key) -> QList<QObject*>;
+
   /**
    * @brief       返回 ComponentManager 对象的单例实例。
    *
@@ -57,8 +86,83 @@ class EXT_SYSTEM_DLLSPEC IComponentManager : public QObject {
    */
   static auto GetInstance() -> IComponentManager*;
 
+  /**
+   * @brief       对象被添加到注册表后发出的信号。
+   *
+   * @param[in]   object 新添加的对象。
+   */
+  Q_SIGNAL void ObjectAdded(QObject* object);
+
+  /**
+   * @brief       对象从注册表中移除后发出的信号。
+   *
+   * @note        信号发出时对象可能正在被销毁，接收者不应对其调用 qobject_cast。
+   *
+   * @param[in]   object 被移除的对象。
+   */
+  Q_SIGNAL void ObjectRemoved(QObject* object);
+
  private:
-  QList<QObject*> object_list_;
+  //! @cond
+
+  struct TypeEntry;
+
+  struct Snapshot {
+    QList<QObject*> objects;
+    QHash<QByteArray, QList<QObject*>> type_index;
+
+    // 读者首次查询某个类型时追加的索引项，只追加不修改，随快照一起删除
+    mutable std::atomic<TypeEntry*> lazy_entries{nullptr};
+
+    ~Snapshot();
+  };
+
+  //! @endcond
+
+  /**
+   * @brief       进入读区。
+   *
+   * @details     在当前纪元的读者计数上递增，离开读区前发布的快照不会被删除。
+   *
+   * @returns     读者计数的槽位，传给 leaveRead()。
+   */
+  auto enterRead() -> int;
+
+  /**
+   * @brief       离开读区。
+   *
+   * @param[in]   slot enterRead() 返回的槽位。
+   */
+  auto leaveRead(int slot) -> void;
+
+  /**
+   * @brief       复制快照，并把读者追加的索引项并入副本的索引。
+   *
+   * @note        调用者必须持有 write_mutex_。
+   *
+   * @param[in]   snapshot 当前快照。
+   *
+   * @returns     新分配的快照。
+   */
+  static auto copySnapshot(const Snapshot& snapshot) -> Snapshot*;
+
+  /**
+   * @brief       发布新的快照，等待宽限期结束后删除旧快照。
+   *
+   * @note        调用者必须持有 write_mutex_。
+   *
+   * @param[in]   snapshot 新快照，由注册表接管。
+   */
+  auto publish(const Snapshot* snapshot) -> void;
+
+  //! @cond
+
+  std::atomic<const Snapshot*> snapshot_{nullptr};
+  std::atomic<unsigned int> read_epoch_{0};
+  std::atomic<int> active_readers_[2] = {};
+  QMutex write_mutex_;
+
+  //! @endcond
 };
 }  // namespace sss::extsystem
 
@@ -98,6 +202,20 @@ inline auto RemoveObject(QObject* object) -> void { IComponentManager::GetInstan
  */
 inline auto AllObjects() -> QList<QObject*> { return IComponentManager::GetInstance()->AllObjects(); }
 
+/**
+ * @brief       返回类型 T 在对象注册表索引中的键。
+ *
+ * @returns     QObject 派生类返回类名；纯接口返回 IID。
+ */
+template <typename T>
+inline auto TypeKey() -> const char* {
+  if constexpr (std::is_base_of_v<QObject, T>) {
+    return T::staticMetaObject.className();
+  } else {
+    return qobject_interface_iid<T*>();
+  }
+}
+
 /**
  * @brief       返回第一个匹配类型 T 的对象。
  *
@@ -105,13 +223,11 @@ inline auto AllObjects() -> QList<QObject*> { return IComponentManager::GetInsta
  */
 template <typename T>
 inline auto GetTObject() -> T* {
-  for (auto* object : IComponentManager::GetInstance()->AllObjects()) {
-    auto cast_object = qobject_cast<T*>(object);
+  auto object_list = IComponentManager::GetInstance()->TypedObjects(TypeKey<T>());
 
-    if (cast_object) return cast_object;
-  }
+  if (object_list.isEmpty()) return nullptr;
 
-  return nullptr;
+  return qobject_cast<T*>(object_list.first());
 }
 
 /**
@@ -123,10 +239,8 @@ template <typename T>
 inline auto GetTObjects() -> QList<T*> {
   QList<T*> object_list;
 
-  for (auto* object : IComponentManager::GetInstance()->AllObjects()) {
-    auto cast_object = qobject_cast<T*>(object);
-
-    if (cast_object) object_list.append(cast_object);
+  for (auto* object : IComponentManager::GetInstance()->TypedObjects(TypeKey<T>())) {
+    object_list.append(qobject_cast<T*>(object));
   }
 
   return object_list;
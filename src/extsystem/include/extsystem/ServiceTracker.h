@@ -0,0 +1,136 @@
+#pragma once
+
+#include <QList>
+#include <QObject>
+#include <functional>
+#include <utility>
+
+#include "extsystem/IComponentManager.h"
+
+namespace sss::extsystem {
+/**
+ * @brief       ServiceTracker 缓存注册表中实现类型 T 的对象。
+ *
+ * @details     跟踪器在构造时解析一次服务，之后仅在 IComponentManager 发出 ObjectAdded 或
+ *              ObjectRemoved 信号时更新缓存，因此 Get() 只是一次指针读取。
+ *
+ *              可以提供回调以处理服务的到达和离开：added 对构造时已存在的服务和之后注册的服务
+ *              调用；removed 在服务从注册表移除（通常在提供者的 FinaliseEvent 中）后调用，
+ *              此时缓存已不再包含该服务。
+ *
+ * @code(.cpp)
+ *              sss::extsystem::ServiceTracker<IThemeService> theme_service_;
+ *
+ *              if (theme_service_) {
+ *                theme_service_->LoadTheme("dark");
+ *              }
+ * @endcode
+ *
+ * @class       sss::extsystem::ServiceTracker ServiceTracker.h <ServiceTracker>
+ */
+template <typename T>
+class ServiceTracker {
+ public:
+  using Callback = std::function<void(T*)>;
+
+  /**
+   * @brief       构造 ServiceTracker 并解析当前已注册的服务。
+   *
+   * @param[in]   added 服务可用时调用的回调（可选）。
+   * @param[in]   removed 服务被移除后调用的回调（可选）。
+   */
+  explicit ServiceTracker(Callback added = nullptr, Callback removed = nullptr)
+      : added_(std::move(added)), removed_(std::move(removed)) {
+    auto* component_manager = IComponentManager::GetInstance();
+
+    QObject::connect(component_manager, &IComponentManager::ObjectAdded, &context_,
+                     [this](QObject* object) { objectAdded(object); });
+    QObject::connect(component_manager, &IComponentManager::ObjectRemoved, &context_,
+                     [this](QObject* object) { objectRemoved(object); });
+
+    refresh();
+
+    if (added_) {
+      for (auto* service : services_) {
+        added_(service);
+      }
+    }
+  }
+
+  ServiceTracker(const ServiceTracker&) = delete;
+  auto operator=(const ServiceTracker&) -> ServiceTracker& = delete;
+
+  /**
+   * @brief       返回第一个（最早注册的）服务。
+   *
+   * @returns     服务；如果没有则返回 nullptr。
+   */
+  [[nodiscard]] auto Get() const -> T* { return service_; }
+
+  /**
+   * @brief       返回所有服务，按注册顺序排列。
+   *
+   * @returns     服务列表。
+   */
+  [[nodiscard]] auto Services() const -> const QList<T*>& { return services_; }
+
+  auto operator->() const -> T* { return service_; }
+
+  explicit operator bool() const { return service_ != nullptr; }
+
+ private:
+  //! @cond
+
+  auto refresh() -> void {
+    objects_.clear();
+    services_.clear();
+
+    for (auto* object : IComponentManager::GetInstance()->TypedObjects(TypeKey<T>())) {
+      objects_.append(object);
+      services_.append(qobject_cast<T*>(object));
+    }
+
+    service_ = services_.isEmpty() ? nullptr : services_.first();
+  }
+
+  auto objectAdded(QObject* object) -> void {
+    auto* service = qobject_cast<T*>(object);
+
+    if (service == nullptr) {
+      return;
+    }
+
+    refresh();
+
+    if (added_) {
+      added_(service);
+    }
+  }
+
+  auto objectRemoved(QObject* object) -> void {
+    // 对象可能正在销毁，因此通过缓存找到对应的服务指针而不是再次转换
+    auto index = objects_.indexOf(object);
+
+    if (index < 0) {
+      return;
+    }
+
+    auto* service = services_.at(index);
+
+    refresh();
+
+    if (removed_) {
+      removed_(service);
+    }
+  }
+
+  QObject context_;
+  QList<QObject*> objects_;
+  QList<T*> services_;
+  T* service_ = nullptr;
+  Callback added_;
+  Callback removed_;
+
+  //! @endcond
+};
+}  // namespace sss::extsystem
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+#include <type_traits>
+
+#include "extsystem/ComponentSystemSpec.h"
+
+namespace sss::extsystem {
+/**
+ * @brief       StartupTrace 记录启动过程中各阶段的耗时，并导出为 Chrome trace 格式。
+ *
+ * @details     跟踪默认关闭，此时记录跨度的开销只是一次原子读取。启用后，各线程记录的跨度
+ *              在 Finish() 时写入 JSON 文件，可以在 chrome://tracing 或 Perfetto 中打开，
+ *              用于查找拖慢启动时间的组件。
+ *
+ *              名称需要拼接或带有参数的跨度应传入生成函数，跟踪关闭时不会调用：
+ *
+ * @code(.cpp)
+ *              {
+ *                sss::extsystem::StartupTrace::Span trace_span(
+ *                    [&](QJsonObject& args) {
+ *                      args.insert("component", name);
+ *                      return "InitialiseEvent " + name;
+ *                    },
+ *                    "component");
+ *                ...
+ *              }
+ * @endcode
+ *
+ * @class       sss::extsystem::StartupTrace StartupTrace.h <StartupTrace>
+ */
+class EXT_SYSTEM_DLLSPEC StartupTrace {
+ public:
+  /**
+   * @brief       Span 在其生命周期内记录一个跨度。
+   */
+  class EXT_SYSTEM_DLLSPEC Span {
+   public:
+    /**
+     * @brief       开始一个跨度。
+     *
+     * @param[in]   name 跨度名称。
+     * @param[in]   category 跨度类别，用于在查看器中过滤。
+     * @param[in]   args 附加参数，显示在查看器的详情中。
+     */
+    explicit Span(const QString& name, const char* category, const QJsonObject& args = QJsonObject());
+
+    /**
+     * @brief       开始一个跨度，名称和参数只在跟踪启用时生成。
+     *
+     * @param[in]   details 返回跨度名称的函数，可以接受 QJsonObject& 参数以填写附加参数。
+     * @param[in]   category 跨度类别，用于在查看器中过滤。
+     */
+    template <typename Details, typename = std::enable_if_t<std::is_invocable_v<Details&> ||
+                                                            std::is_invocable_v<Details&, QJsonObject&>>>
+    Span(Details&& details, const char* category) : enabled_(StartupTrace::IsEnabled()), category_(category) {
+      if (!enabled_) {
+        return;
+      }
+
+      if constexpr (std::is_invocable_v<Details&>) {
+        name_ = details();
+      } else {
+        name_ = details(args_);
+      }
+
+      start_us_ = StartupTrace::Now();
+    }
+
+    /**
+     * @brief       结束跨度并记录它。
+     */
+    ~Span();
+
+    Span(const Span&) = delete;
+    auto operator=(const Span&) -> Span& = delete;
+
+   private:
+    //! @cond
+
+    bool enabled_;
+    qint64 start_us_ = 0;
+    QString name_;
+    const char* category_;
+    QJsonObject args_;
+
+    //! @endcond
+  };
+
+  /**
+   * @brief       启用跟踪。
+   *
+   * @details     时间戳以调用此函数的时刻为零点。
+   *
+   * @param[in]   filename Finish() 写入的文件名。
+   */
+  static auto Start(const QString& filename) -> void;
+
+  /**
+   * @brief       返回跟踪是否已启用。
+   *
+   * @returns     如果已启用返回 true；否则返回 false。
+   */
+  static auto IsEnabled() -> bool;
+
+  /**
+   * @brief       返回自跟踪开始以来的微秒数。
+   *
+   * @returns     时间戳。
+   */
+  static auto Now() -> qint64;
+
+  /**
+   * @brief       记录一个已完成的跨度。
+   *
+   * @param[in]   name 跨度名称。
+   * @param[in]   category 跨度类别。
+   * @param[in]   start_us 开始时间戳（微秒）。
+   * @param[in]   duration_us 持续时间（微秒）。
+   * @param[in]   args 附加参数。
+   */
+  static auto AddSpan(const QString& name, const char* category, qint64 start_us, qint64 duration_us,
+                      const QJsonObject& args = QJsonObject()) -> void;
+
+  /**
+   * @brief       写出跟踪文件并关闭跟踪。
+   *
+   * @returns     如果写入成功返回 true；否则返回 false。
+   */
+  static auto Finish() -> bool;
+};
+}  // namespace sss::extsystem
@@ -20,3 +20,8 @@ endif()
 
 # 设置用户自定义编译定义，根据需要添加
 list(APPEND PROJECT_COMPILE_DEFINITIONS DS_LIBRARY_COMPONENTSYSTEM_EXPORT)
+
+# LibraryPrefetcher 在工作线程中用 dlopen 预先打开组件库
+if(CMAKE_DL_LIBS)
+  target_link_libraries(${PROJECT_NAME} PRIVATE ${CMAKE_DL_LIBS})
+endif()
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <doctest/doctest.h>
+
+#include <QtGlobal>
+
+/**
+ * @brief       检查是否运行进程内的基准测试。
+ *
+ * @details     基准测试耗时较长，默认的 tests 运行中跳过，设置 DS_RUN_BENCHMARKS 环境变量（或构建
+ *              run_benchmarks 目标，见 user_config.cmake）时才运行。
+ *
+ * @returns     如果应运行基准测试返回 true；否则记录跳过原因并返回 false。
+ */
+inline auto BenchmarksEnabled() -> bool {
+  if (qEnvironmentVariableIsSet("DS_RUN_BENCHMARKS")) {
+    return true;
+  }
+
+  MESSAGE("DS_RUN_BENCHMARKS is not set, build the run_benchmarks target to run this benchmark");
+
+  return false;
+}
@@ -0,0 +1,135 @@
+# 组件加载器基准测试：生成 N 个一次性插件共享库，并通过 tests 程序中的 "ComponentLoader Lifecycle Benchmark"
+# 测试套件驱动完整的 AddComponents/LoadComponents/UnloadComponents 生命周期，以 JSON 输出耗时和峰值内存。
+#
+# 依赖图：被依赖的插件（提供者）为索引是 M = FAN_IN / FAN_OUT 倍数的插件，插件 i 依赖其之前最近的 FAN_OUT 个提供者，
+# 因此每个插件依赖 FAN_OUT 个插件，每个提供者约被 FAN_IN 个插件依赖（FAN_IN 向下取整为 FAN_OUT 的倍数）。
+#
+# 用法：cmake -DTESTS_BUILD_LOADER_BENCHMARK=ON ... && cmake --build . --target run_loader_benchmark
+#
+# 基线文件按插件数量和全部生成参数分别保存结果，只与参数相同的基线比较。基线不会自动写入，
+# 构建 update_loader_benchmark_baseline 目标以本次结果更新当前参数的基线。
+
+set(TESTS_LOADER_BENCHMARK_PLUGINS
+    100
+    CACHE STRING "Number of generated benchmark plugins")
+set(TESTS_LOADER_BENCHMARK_FAN_OUT
+    2
+    CACHE STRING "Dependencies per generated benchmark plugin")
+set(TESTS_LOADER_BENCHMARK_FAN_IN
+    4
+    CACHE STRING "Dependents per depended-on benchmark plugin")
+set(TESTS_LOADER_BENCHMARK_METADATA_BYTES
+    1024
+    CACHE STRING "Padding added to the metadata of each benchmark plugin")
+set(TESTS_LOADER_BENCHMARK_INIT_COST_US
+    0
+    CACHE STRING "Busy-wait time of each benchmark plugin's InitialiseEvent in microseconds")
+set(TESTS_LOADER_BENCHMARK_ITERATIONS
+    3
+    CACHE STRING "Lifecycle iterations, the median of each phase is reported")
+set(TESTS_LOADER_BENCHMARK_THRESHOLD
+    1.25
+    CACHE STRING "Allowed slowdown against the baseline before the benchmark fails")
+set(TESTS_LOADER_BENCHMARK_BASELINE
+    "${CMAKE_BINARY_DIR}/loader_benchmark_baseline.json"
+    CACHE FILEPATH "Baseline results keyed by the benchmark parameters, written by update_loader_benchmark_baseline")
+
+foreach(_benchmark_parameter TESTS_LOADER_BENCHMARK_PLUGINS TESTS_LOADER_BENCHMARK_FAN_OUT TESTS_LOADER_BENCHMARK_FAN_IN
+                             TESTS_LOADER_BENCHMARK_ITERATIONS)
+  if(NOT ${_benchmark_parameter} MATCHES "^[0-9]+$" OR ${_benchmark_parameter} LESS 1)
+    message(FATAL_ERROR "${_benchmark_parameter} must be a positive integer, got '${${_benchmark_parameter}}'")
+  endif()
+endforeach()
+
+foreach(_benchmark_parameter TESTS_LOADER_BENCHMARK_METADATA_BYTES TESTS_LOADER_BENCHMARK_INIT_COST_US)
+  if(NOT ${_benchmark_parameter} MATCHES "^[0-9]+$")
+    message(FATAL_ERROR "${_benchmark_parameter} must be a non-negative integer, got '${${_benchmark_parameter}}'")
+  endif()
+endforeach()
+
+if(NOT TESTS_LOADER_BENCHMARK_THRESHOLD MATCHES "^[0-9]+(\\.[0-9]+)?$")
+  message(
+    FATAL_ERROR "TESTS_LOADER_BENCHMARK_THRESHOLD must be a positive number, got '${TESTS_LOADER_BENCHMARK_THRESHOLD}'")
+endif()
+
+set(_benchmark_output_dir "${CMAKE_BINARY_DIR}/$<CONFIG>/loader_benchmark_plugins")
+set(_benchmark_source_dir "${CMAKE_CURRENT_BINARY_DIR}/loader_benchmark")
+
+math(EXPR _benchmark_provider_stride "${TESTS_LOADER_BENCHMARK_FAN_IN} / ${TESTS_LOADER_BENCHMARK_FAN_OUT}")
+if(_benchmark_provider_stride LESS 1)
+  set(_benchmark_provider_stride 1)
+endif()
+
+string(REPEAT "x" ${TESTS_LOADER_BENCHMARK_METADATA_BYTES} BENCHMARK_PADDING)
+
+set(_benchmark_targets "")
+math(EXPR _benchmark_last_index "${TESTS_LOADER_BENCHMARK_PLUGINS} - 1")
+
+foreach(BENCHMARK_INDEX RANGE ${_benchmark_last_index})
+  # 插件 i 依赖提供者 (floor((i - 1) / M) - k) * M，k = 0 .. FAN_OUT - 1
+  set(BENCHMARK_DEPENDENCIES "")
+
+  if(BENCHMARK_INDEX GREATER 0)
+    math(EXPR _provider_slot "(${BENCHMARK_INDEX} - 1) / ${_benchmark_provider_stride}")
+    math(EXPR _last_edge "${TESTS_LOADER_BENCHMARK_FAN_OUT} - 1")
+
+    foreach(_edge RANGE ${_last_edge})
+      math(EXPR _dependency_index "(${_provider_slot} - ${_edge}) * ${_benchmark_provider_stride}")
+
+      if(_dependency_index LESS 0)
+        break()
+      endif()
+
+      if(NOT BENCHMARK_DEPENDENCIES STREQUAL "")
+        string(APPEND BENCHMARK_DEPENDENCIES ",")
+      endif()
+      string(APPEND BENCHMARK_DEPENDENCIES "{\"Name\": \"benchmark${_dependency_index}\", \"Version\": \"1.0.0\"}")
+    endforeach()
+  endif()
+
+  configure_file(${CMAKE_CURRENT_LIST_DIR}/BenchmarkComponent.json.in
+                 ${_benchmark_source_dir}/BenchmarkComponent${BENCHMARK_INDEX}.json @ONLY)
+  configure_file(${CMAKE_CURRENT_LIST_DIR}/BenchmarkComponent.cpp.in
+                 ${_benchmark_source_dir}/BenchmarkComponent${BENCHMARK_INDEX}.cpp @ONLY)
+
+  set(_benchmark_target loader_benchmark_plugin${BENCHMARK_INDEX})
+
+  add_library(${_benchmark_target} MODULE ${_benchmark_source_dir}/BenchmarkComponent${BENCHMARK_INDEX}.cpp)
+  target_link_libraries(${_benchmark_target} PRIVATE extsystem::extsystem Qt5::Core)
+  target_compile_features(${_benchmark_target} PRIVATE cxx_std_17)
+  set_target_properties(
+    ${_benchmark_target}
+    PROPERTIES AUTOMOC ON
+               EXCLUDE_FROM_ALL ON
+               LIBRARY_OUTPUT_DIRECTORY "${_benchmark_output_dir}"
+               RUNTIME_OUTPUT_DIRECTORY "${_benchmark_output_dir}")
+
+  list(APPEND _benchmark_targets ${_benchmark_target})
+endforeach()
+
+set(_benchmark_environment
+    "DS_LOADER_BENCHMARK_DIR=${_benchmark_output_dir}"
+    "DS_LOADER_BENCHMARK_FAN_OUT=${TESTS_LOADER_BENCHMARK_FAN_OUT}"
+    "DS_LOADER_BENCHMARK_FAN_IN=${TESTS_LOADER_BENCHMARK_FAN_IN}"
+    "DS_LOADER_BENCHMARK_METADATA_BYTES=${TESTS_LOADER_BENCHMARK_METADATA_BYTES}"
+    "DS_LOADER_BENCHMARK_INIT_COST_US=${TESTS_LOADER_BENCHMARK_INIT_COST_US}"
+    "DS_LOADER_BENCHMARK_ITERATIONS=${TESTS_LOADER_BENCHMARK_ITERATIONS}"
+    "DS_LOADER_BENCHMARK_THRESHOLD=${TESTS_LOADER_BENCHMARK_THRESHOLD}"
+    "DS_LOADER_BENCHMARK_BASELINE=${TESTS_LOADER_BENCHMARK_BASELINE}"
+    "DS_LOADER_BENCHMARK_OUTPUT=${CMAKE_BINARY_DIR}/loader_benchmark_results.json")
+
+add_custom_target(
+  run_loader_benchmark
+  COMMAND ${CMAKE_COMMAND} -E env ${_benchmark_environment} $<TARGET_FILE:${PROJECT_NAME}>
+          "--test-suite=ComponentLoader Lifecycle Benchmark"
+  DEPENDS ${PROJECT_NAME} ${_benchmark_targets}
+  USES_TERMINAL VERBATIM
+  COMMENT "Running the component loader benchmark with ${TESTS_LOADER_BENCHMARK_PLUGINS} plugins")
+
+add_custom_target(
+  update_loader_benchmark_baseline
+  COMMAND ${CMAKE_COMMAND} -E env ${_benchmark_environment} "DS_LOADER_BENCHMARK_UPDATE_BASELINE=1"
+          $<TARGET_FILE:${PROJECT_NAME}> "--test-suite=ComponentLoader Lifecycle Benchmark"
+  DEPENDS ${PROJECT_NAME} ${_benchmark_targets}
+  USES_TERMINAL VERBATIM
+  COMMENT "Recording the component loader benchmark baseline with ${TESTS_LOADER_BENCHMARK_PLUGINS} plugins")
@@ -0,0 +1,78 @@
+# 静态组件基准测试：同一组组件分别编译为 tests 程序中的 Qt 静态插件和独立的共享库插件，test_static_components.cpp
+# 中的 "ComponentLoader Benchmark" 测试套件对两者分别运行完整的添加、加载和激活流程并比较耗时。
+#
+# 两种构建使用同一个源文件模板，只有类名、组件名和激活模式不同。组件通过激活模式延迟加载，因此其他调用
+# AddStaticComponents 的测试不会初始化它们。共享库插件中未定义的 extsystem 符号在加载时解析到 tests 程序导出的
+# 符号（与 runtime_install.cmake 相同），因此只在 Linux 上构建。
+#
+# 用法：cmake -DTESTS_BUILD_STATIC_BENCHMARK=ON ... && cmake --build . --target run_benchmarks
+
+set(TESTS_STATIC_BENCHMARK_COMPONENTS
+    20
+    CACHE STRING "Number of components built both statically and as shared libraries")
+
+if(NOT TESTS_STATIC_BENCHMARK_COMPONENTS MATCHES "^[0-9]+$" OR TESTS_STATIC_BENCHMARK_COMPONENTS LESS 1)
+  message(
+    FATAL_ERROR
+      "TESTS_STATIC_BENCHMARK_COMPONENTS must be a positive integer, got '${TESTS_STATIC_BENCHMARK_COMPONENTS}'")
+endif()
+
+set(_static_benchmark_output_dir "${CMAKE_BINARY_DIR}/$<CONFIG>/static_benchmark_plugins")
+set(_static_benchmark_source_dir "${CMAKE_CURRENT_BINARY_DIR}/static_benchmark")
+set(_static_benchmark_imports "")
+set(_static_benchmark_targets "")
+
+math(EXPR _static_benchmark_last_index "${TESTS_STATIC_BENCHMARK_COMPONENTS} - 1")
+
+foreach(BENCHMARK_INDEX RANGE ${_static_benchmark_last_index})
+  # 静态插件编译进 tests 程序
+  set(BENCHMARK_CLASS "StaticBenchmark${BENCHMARK_INDEX}")
+  set(BENCHMARK_MODE "tests.benchmark.static")
+  set(BENCHMARK_VARIANT_DESCRIPTION "静态插件")
+  set(BENCHMARK_STATIC_DEFINE "#define QT_STATICPLUGIN\n")
+
+  configure_file(${CMAKE_CURRENT_LIST_DIR}/StaticBenchmarkComponent.json.in
+                 ${_static_benchmark_source_dir}/${BENCHMARK_CLASS}.json @ONLY)
+  configure_file(${CMAKE_CURRENT_LIST_DIR}/StaticBenchmarkComponent.cpp.in
+                 ${_static_benchmark_source_dir}/${BENCHMARK_CLASS}.cpp @ONLY)
+
+  target_sources(${PROJECT_NAME} PRIVATE ${_static_benchmark_source_dir}/${BENCHMARK_CLASS}.cpp)
+  string(APPEND _static_benchmark_imports "Q_IMPORT_PLUGIN(${BENCHMARK_CLASS})\n")
+
+  # 同一个组件编译为共享库插件
+  set(BENCHMARK_CLASS "SharedBenchmark${BENCHMARK_INDEX}")
+  set(BENCHMARK_MODE "tests.benchmark.shared")
+  set(BENCHMARK_VARIANT_DESCRIPTION "共享库插件")
+  set(BENCHMARK_STATIC_DEFINE "")
+
+  configure_file(${CMAKE_CURRENT_LIST_DIR}/StaticBenchmarkComponent.json.in
+                 ${_static_benchmark_source_dir}/${BENCHMARK_CLASS}.json @ONLY)
+  configure_file(${CMAKE_CURRENT_LIST_DIR}/StaticBenchmarkComponent.cpp.in
+                 ${_static_benchmark_source_dir}/${BENCHMARK_CLASS}.cpp @ONLY)
+
+  set(_static_benchmark_target static_benchmark_plugin${BENCHMARK_INDEX})
+
+  add_library(${_static_benchmark_target} MODULE ${_static_benchmark_source_dir}/${BENCHMARK_CLASS}.cpp)
+  target_include_directories(${_static_benchmark_target} PRIVATE ${CMAKE_CURRENT_SOURCE_DIR}/../extsystem/include)
+  target_link_libraries(${_static_benchmark_target} PRIVATE Qt5::Core)
+  target_compile_features(${_static_benchmark_target} PRIVATE cxx_std_17)
+  set_target_properties(${_static_benchmark_target} PROPERTIES AUTOMOC ON LIBRARY_OUTPUT_DIRECTORY
+                                                                           "${_static_benchmark_output_dir}")
+
+  list(APPEND _static_benchmark_targets ${_static_benchmark_target})
+endforeach()
+
+file(
+  WRITE ${_static_benchmark_source_dir}/StaticBenchmarkImports.cpp.in
+  "// 由 static_benchmark.cmake 生成，导入编译进 tests 程序的静态基准测试插件，请勿修改\n\n"
+  "#include <QtPlugin>\n\n"
+  "${_static_benchmark_imports}")
+configure_file(${_static_benchmark_source_dir}/StaticBenchmarkImports.cpp.in
+               ${_static_benchmark_source_dir}/StaticBenchmarkImports.cpp COPYONLY)
+target_sources(${PROJECT_NAME} PRIVATE ${_static_benchmark_source_dir}/StaticBenchmarkImports.cpp)
+
+set_target_properties(${PROJECT_NAME} PROPERTIES ENABLE_EXPORTS ON)
+add_dependencies(${PROJECT_NAME} ${_static_benchmark_targets})
+target_compile_definitions(
+  ${PROJECT_NAME} PRIVATE DS_STATIC_BENCHMARK_DIR="${_static_benchmark_output_dir}"
+                          DS_STATIC_BENCHMARK_COMPONENTS=${TESTS_STATIC_BENCHMARK_COMPONENTS})
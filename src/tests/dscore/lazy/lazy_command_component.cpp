@@ -0,0 +1,13 @@
+// 测试插件以 Qt 静态插件的形式编译进测试程序，moc 生成 qt_static_plugin_LazyCommandPlugin()
+#define QT_STATICPLUGIN
+
+#include <QtPlugin>
+
+#include "lazy_command_component.h"
+
+class LazyCommandPlugin : public LazyCommandComponent {
+  Q_OBJECT
+  Q_PLUGIN_METADATA(IID SSSComponentInterfaceIID FILE "lazy_command_component.json")
+};
+
+#include "lazy_command_component.moc"
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <extsystem/IComponent.h>
+
+#include <QObject>
+#include <functional>
+
+// 由命令激活的测试组件，InitialiseEvent 中调用测试设置的函数注册命令。派生类以 Qt 静态插件的形式编译进测试程序。
+class LazyCommandComponent : public QObject, public sss::extsystem::IComponent {
+  Q_OBJECT
+  Q_INTERFACES(sss::extsystem::IComponent)
+
+ public:
+  static inline std::function<void()> register_commands;
+
+  auto InitialiseEvent() -> void override {
+    if (register_commands) {
+      register_commands();
+    }
+  }
+};
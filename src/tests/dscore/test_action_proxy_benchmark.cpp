@@ -0,0 +1,111 @@
+#include <doctest/doctest.h>
+
+#include <QAction>
+#include <QElapsedTimer>
+#include <memory>
+#include <vector>
+
+#include "ActionProxy.h"
+#include "benchmark/BenchmarkGate.h"
+
+namespace {
+// 代理数量
+constexpr int kProxyCount = 10000;
+
+// 上下文切换次数，每次切换所有代理都改变目标
+constexpr int kSwitchCount = 1000;
+
+// 公开 QObject::receivers() 以统计连接数
+class CountedAction : public QAction {
+ public:
+  using QAction::QAction;
+
+  auto ConnectionCount() const -> int {
+    return receivers(SIGNAL(changed())) + receivers(SIGNAL(triggered(bool))) + receivers(SIGNAL(toggled(bool)));
+  }
+};
+
+class CountedProxy : public sss::dscore::ActionProxy {
+ public:
+  using ActionProxy::ActionProxy;
+
+  auto ConnectionCount() const -> int {
+    return receivers(SIGNAL(changed())) + receivers(SIGNAL(triggered(bool))) + receivers(SIGNAL(toggled(bool)));
+  }
+};
+
+struct ProxyTargets {
+  CountedProxy proxy;
+  CountedAction first{"Action"};
+  CountedAction second{"Action"};
+};
+
+auto ConnectionCount(const std::vector<std::unique_ptr<ProxyTargets>>& entries) -> int {
+  auto count = 0;
+
+  for (const auto& entry : entries) {
+    count += entry->proxy.ConnectionCount() + entry->first.ConnectionCount() + entry->second.ConnectionCount();
+  }
+
+  return count;
+}
+}  // namespace
+
+TEST_SUITE("ActionProxy Benchmark") {
+  TEST_CASE("Retargeting does not accumulate connections") {
+    if (!BenchmarksEnabled()) {
+      return;
+    }
+
+    std::vector<std::unique_ptr<ProxyTargets>> entries;
+
+    entries.reserve(kProxyCount);
+
+    for (int index = 0; index < kProxyCount; index++) {
+      entries.push_back(std::make_unique<ProxyTargets>());
+      entries.back()->proxy.SetActive(&entries.back()->first);
+    }
+
+    auto initial_connections = ConnectionCount(entries);
+
+    QElapsedTimer timer;
+
+    timer.start();
+    for (int context_switch = 0; context_switch < kSwitchCount; context_switch++) {
+      for (auto& entry : entries) {
+        entry->proxy.SetActive((context_switch % 2) == 0 ? &entry->second : &entry->first);
+      }
+    }
+    auto elapsed_ms = timer.elapsed();
+
+    MESSAGE(kProxyCount << " proxies, " << kSwitchCount << " context switches: " << elapsed_ms << "ms");
+
+    CHECK(ConnectionCount(entries) == initial_connections);
+
+    // 切换后仍然转发到当前目标，旧目标的变化不再影响代理
+    auto& entry = *entries.front();
+    auto* active = kSwitchCount % 2 == 0 ? &entry.first : &entry.second;
+    auto* inactive = active == &entry.first ? &entry.second : &entry.first;
+
+    REQUIRE(entry.proxy.ActiveAction() == active);
+
+    auto triggered = 0;
+
+    QObject::connect(active, &QAction::triggered, [&triggered]() { triggered++; });
+    QObject::connect(inactive, &QAction::triggered, [&triggered]() { triggered += 100; });
+
+    entry.proxy.trigger();
+
+    CHECK(triggered == 1);
+
+    active->setText("Renamed");
+    inactive->setText("Stale");
+
+    CHECK(entry.proxy.text() == "Renamed");
+
+    entry.proxy.setEnabled(false);
+
+    CHECK_FALSE(active->isEnabled());
+    CHECK(inactive->isEnabled());
+  }
+}
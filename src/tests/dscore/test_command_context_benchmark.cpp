@@ -0,0 +1,204 @@
+#include <doctest/doctest.h>
+#include <dscore/ICommand.h>
+#include <extsystem/IComponentManager.h>
+
+#include <QAction>
+#include <QElapsedTimer>
+#include <QFile>
+#include <algorithm>
+
+#include "CommandManager.h"
+#include "ContextManager.h"
+#include "benchmark/BenchmarkGate.h"
+
+namespace {
+// 注册的命令数量
+constexpr int kCommandCount = 10000;
+
+// 命令分布在这么多个页面上下文中
+constexpr int kPageContextCount = 100;
+
+// 切换子上下文的次数
+constexpr int kToggleCount = 200;
+
+// 比较描述符和 QAction 注册方式的命令数量
+constexpr int kCatalogueCommandCount = 20000;
+
+struct CommandContextFixture {
+  sss::extsystem::IComponentManager* comp_mgr = nullptr;  // NOLINT
+  sss::dscore::ContextManager* context_mgr = nullptr;     // NOLINT
+  sss::dscore::CommandManager* cmd_mgr = nullptr;         // NOLINT
+
+  CommandContextFixture() {
+    comp_mgr = sss::extsystem::IComponentManager::GetInstance();
+
+    for (auto* obj : comp_mgr->AllObjects()) {
+      comp_mgr->RemoveObject(obj);
+    }
+
+    context_mgr = new sss::dscore::ContextManager();
+    comp_mgr->AddObject(context_mgr);
+
+    cmd_mgr = new sss::dscore::CommandManager();
+    comp_mgr->AddObject(cmd_mgr);
+  }
+
+  ~CommandContextFixture() {
+    comp_mgr->RemoveObject(cmd_mgr);
+    delete cmd_mgr;
+    comp_mgr->RemoveObject(context_mgr);
+    delete context_mgr;
+  }
+};
+
+// 返回进程的常驻内存（KB），不支持的平台返回 -1
+auto ResidentMemoryKb() -> qint64 {
+  QFile status("/proc/self/status");
+
+  if (!status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    return -1;
+  }
+
+  for (auto line = status.readLine(); !line.isEmpty(); line = status.readLine()) {
+    if (line.startsWith("VmRSS:")) {
+      return line.mid(6).trimmed().split(' ').first().toLongLong();
+    }
+  }
+
+  return -1;
+}
+
+auto VisibleCommandCount(const QList<sss::dscore::ICommand*>& commands) -> int {
+  return static_cast<int>(
+      std::count_if(commands.begin(), commands.end(), [](auto* command) { return command->Action()->isVisible(); }));
+}
+
+auto EnabledCommandCount(const QList<sss::dscore::ICommand*>& commands) -> int {
+  return static_cast<int>(
+      std::count_if(commands.begin(), commands.end(), [](auto* command) { return command->Action()->isEnabled(); }));
+}
+}  // namespace
+
+TEST_SUITE("CommandManager Benchmark") {
+  TEST_CASE_FIXTURE(CommandContextFixture, "Sub-context toggles only touch the commands indexed under them") {
+    if (!BenchmarksEnabled()) {
+      return;
+    }
+
+    QList<int> page_contexts;
+
+    for (int index = 0; index < kPageContextCount; index++) {
+      page_contexts.append(context_mgr->RegisterContext(QString("bench.page%1").arg(index)));
+    }
+
+    auto sub_context = context_mgr->RegisterContext("bench.sub");
+
+    // 每个页面上下文有 kCommandCount / kPageContextCount 个命令，其中一个命令还需要子上下文才能启用
+    QList<sss::dscore::ICommand*> commands;
+
+    for (int index = 0; index < kCommandCount; index++) {
+      auto page_context = page_contexts.at(index % kPageContextCount);
+      sss::dscore::ContextList enabled_contexts{page_context};
+
+      if (index < kPageContextCount) {
+        enabled_contexts.append(sub_context);
+      }
+
+      commands.append(cmd_mgr->RegisterAction(new QAction(QString("Command %1").arg(index)),
+                                              QString("bench.command%1").arg(index), {page_context},
+                                              enabled_contexts));
+    }
+
+    context_mgr->SetContext(page_contexts.first());
+
+    QElapsedTimer timer;
+
+    timer.start();
+    for (int toggle = 0; toggle < kToggleCount; toggle++) {
+      context_mgr->AddActiveContext(sub_context);
+      context_mgr->RemoveActiveContext(sub_context);
+    }
+    auto incremental_ms = timer.elapsed();
+
+    auto visible_count = VisibleCommandCount(commands);
+    auto enabled_count = EnabledCommandCount(commands);
+
+    // 全量重新计算作为对照，结果必须一致
+    timer.restart();
+    for (int toggle = 0; toggle < kToggleCount; toggle++) {
+      cmd_mgr->SetContext(sss::dscore::kGlobalContext);
+      cmd_mgr->SetContext(sss::dscore::kGlobalContext);
+    }
+    auto full_ms = timer.elapsed();
+
+    MESSAGE(kCommandCount << " commands, " << 2 * kToggleCount << " context changes: indexed " << incremental_ms
+                          << "ms, full re-evaluation " << full_ms << "ms");
+
+    CHECK(visible_count == kCommandCount / kPageContextCount);
+    CHECK(enabled_count == kCommandCount / kPageContextCount - 1);
+    CHECK(VisibleCommandCount(commands) == visible_count);
+    CHECK(EnabledCommandCount(commands) == enabled_count);
+
+    // 切换页面上下文后索引仍然正确
+    context_mgr->SetContext(page_contexts.last());
+    context_mgr->AddActiveContext(sub_context);
+
+    CHECK(VisibleCommandCount(commands) == kCommandCount / kPageContextCount);
+    CHECK(EnabledCommandCount(commands) == kCommandCount / kPageContextCount);
+  }
+
+  TEST_CASE_FIXTURE(CommandContextFixture, "Descriptor registration creates no QObjects until a command is used") {
+    if (!BenchmarksEnabled()) {
+      return;
+    }
+
+    auto context = context_mgr->RegisterContext("bench.catalogue");
+
+    QElapsedTimer timer;
+
+    auto memory_before = ResidentMemoryKb();
+
+    timer.start();
+    for (int index = 0; index < kCatalogueCommandCount; index++) {
+      sss::dscore::CommandDescriptor descriptor;
+
+      descriptor.id = QString("bench.descriptor%1").arg(index);
+      descriptor.text = QString("Descriptor %1").arg(index);
+      descriptor.visibility_expression = sss::dscore::ContextExpression::AnyOf({context});
+      descriptor.handler = []() {};
+
+      cmd_mgr->RegisterCommand(descriptor);
+    }
+    auto descriptor_ms = timer.elapsed();
+    auto descriptor_kb = ResidentMemoryKb() - memory_before;
+    auto descriptor_actions = cmd_mgr->ActionCount();
+
+    CHECK(cmd_mgr->MaterialisedCommandCount() == 0);
+
+    memory_before = ResidentMemoryKb();
+
+    timer.restart();
+    for (int index = 0; index < kCatalogueCommandCount; index++) {
+      cmd_mgr->RegisterAction(new QAction(QString("Action %1").arg(index)), QString("bench.action%1").arg(index),
+                              {context}, {context});
+    }
+    auto action_ms = timer.elapsed();
+    auto action_kb = ResidentMemoryKb() - memory_before;
+    auto action_actions = cmd_mgr->ActionCount() - descriptor_actions;
+
+    CHECK(cmd_mgr->MaterialisedCommandCount() == kCatalogueCommandCount);
+
+    // 常驻内存受分配器复用的影响只作报告，QAction 数量是确定的
+    MESSAGE(kCatalogueCommandCount << " commands: descriptors " << descriptor_ms << "ms, " << descriptor_actions
+                                   << " QActions, " << descriptor_kb << "KB; QAction commands " << action_ms << "ms, "
+                                   << action_actions << " QActions, " << action_kb << "KB");
+
+    // 每个 QAction 命令有注册的动作和代理动作，描述符在使用前不创建任何动作
+    CHECK(action_actions == 2 * kCatalogueCommandCount);
+    CHECK(descriptor_actions * 100 < action_actions);
+
+    // 只有被使用的命令才创建
+    REQUIRE(cmd_mgr->FindCommand("bench.descriptor7") != nullptr);
+    CHECK(cmd_mgr->MaterialisedCommandCount() == kCatalogueCommandCount + 1);
+  }
+}
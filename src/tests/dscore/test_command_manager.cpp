@@ -2,15 +2,25 @@
 #include <dscore/IActionContainer.h>
 #include <dscore/ICommand.h>
 #include <dscore/ICore.h>
+#include <extsystem/ComponentLoader.h>
 #include <extsystem/IComponentManager.h>
 
 #include <QAction>
 #include <QApplication>
+#include <QElapsedTimer>
 #include <QMainWindow>
+#include <QSemaphore>
+#include <QSignalSpy>
 #include <QTimer>
+#include <QtPlugin>
+#include <atomic>
+#include <stdexcept>
 
 #include "CommandManager.h"
 #include "ContextManager.h"
+#include "lazy/lazy_command_component.h"
+
+Q_IMPORT_PLUGIN(LazyCommandPlugin)
 
 // MainWindow的模拟Core
 class MockCore : public sss::dscore::ICore {
@@ -29,6 +39,24 @@ class MockCore : public sss::dscore::ICore {
   QMainWindow* main_window_;
 };
 
+// 处理事件直到条件满足或超时
+template <typename Predicate>
+auto WaitUntil(Predicate predicate, int timeout_ms = 5000) -> bool {
+  QElapsedTimer timer;
+
+  timer.start();
+
+  while (!predicate()) {
+    if (timer.elapsed() > timeout_ms) {
+      return false;
+    }
+
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+  }
+
+  return true;
+}
+
 // 测试夹具
 struct CommandManagerFixture {
   sss::extsystem::IComponentManager* comp_mgr = nullptr;  // NOLINT
@@ -118,6 +146,401 @@ TEST_SUITE("CommandManager") {
     CHECK(child_container != nullptr);
     CHECK(cmd_mgr->FindContainer(child_id) == child_container);
   }
+
+  TEST_CASE_FIXTURE(CommandManagerFixture, "Context changes only re-evaluate the commands that reference them") {
+    int editor_context = context_mgr->RegisterContext("Editor");
+    int tool_context = context_mgr->RegisterContext("Tool");
+
+    QAction editor_action("Editor Action");
+    QAction tool_action("Tool Action");
+    QAction global_action("Global Action");
+
+    auto* editor_command = cmd_mgr->RegisterAction(&editor_action, "test.editor", {editor_context}, {editor_context});
+    auto* tool_command =
+        cmd_mgr->RegisterAction(&tool_action, "test.tool", {editor_context}, {editor_context, tool_context});
+    auto* global_command = cmd_mgr->RegisterAction(&global_action, "test.global", {sss::dscore::kGlobalContext},
+                                                   {sss::dscore::kGlobalContext});
+
+    CHECK_FALSE(editor_command->Action()->isVisible());
+    CHECK(global_command->Action()->isVisible());
+
+    context_mgr->SetContext(editor_context);
+
+    CHECK(editor_command->Action()->isVisible());
+    CHECK(editor_command->Action()->isEnabled());
+    CHECK(tool_command->Action()->isVisible());
+    CHECK_FALSE(tool_command->Action()->isEnabled());
+
+    // 只有引用 Tool 上下文的命令需要更新
+    context_mgr->AddActiveContext(tool_context);
+
+    CHECK(tool_command->Action()->isEnabled());
+    CHECK(editor_command->Action()->isEnabled());
+
+    context_mgr->RemoveActiveContext(tool_context);
+
+    CHECK_FALSE(tool_command->Action()->isEnabled());
+    CHECK(tool_command->Action()->isVisible());
+
+    context_mgr->SetContext(sss::dscore::kGlobalContext);
+
+    CHECK_FALSE(editor_command->Action()->isVisible());
+    CHECK_FALSE(tool_command->Action()->isVisible());
+    CHECK(global_command->Action()->isVisible());
+  }
+
+  TEST_CASE_FIXTURE(CommandManagerFixture, "Commands registered with context expressions") {
+    QAction action("Expression Action");
+
+    auto visible = sss::dscore::ContextExpression::Compile("Editor", context_mgr);
+    auto enabled = sss::dscore::ContextExpression::Compile("Editor && !ReadOnly", context_mgr);
+
+    auto* command = cmd_mgr->RegisterAction(&action, "test.expression", visible, enabled);
+
+    REQUIRE(command != nullptr);
+    CHECK_FALSE(command->Action()->isVisible());
+
+    context_mgr->SetContext(context_mgr->Context("Editor"));
+
+    CHECK(command->Action()->isVisible());
+    CHECK(command->Action()->isEnabled());
+
+    // 取反的上下文也被索引，加入 ReadOnly 会禁用命令
+    context_mgr->AddActiveContext(context_mgr->Context("ReadOnly"));
+
+    CHECK(command->Action()->isVisible());
+    CHECK_FALSE(command->Action()->isEnabled());
+
+    context_mgr->RemoveActiveContext(context_mgr->Context("ReadOnly"));
+
+    CHECK(command->Action()->isEnabled());
+  }
+
+  TEST_CASE_FIXTURE(CommandManagerFixture, "Command state is flushed to the actions once per event loop turn") {
+    int editor_context = context_mgr->RegisterContext("Editor");
+    int tool_context = context_mgr->RegisterContext("Tool");
+
+    QAction editor_action("Editor Action");
+    QAction tool_action("Tool Action");
+
+    auto* editor_proxy = cmd_mgr->RegisterAction(&editor_action, "test.editor", {editor_context}, {editor_context})
+                             ->Action();
+    auto* tool_proxy =
+        cmd_mgr->RegisterAction(&tool_action, "test.tool", {tool_context}, {tool_context})->Action();
+
+    QSignalSpy editor_spy(editor_proxy, &QAction::changed);
+    QSignalSpy tool_spy(tool_proxy, &QAction::changed);
+
+    // 同一轮事件循环中的变化不会立即应用
+    context_mgr->SetContext(editor_context);
+
+    CHECK_FALSE(editor_proxy->isVisible());
+    CHECK(editor_spy.count() == 0);
+
+    // 一轮中来回切换的上下文不会改变命令的状态
+    context_mgr->AddActiveContext(tool_context);
+    context_mgr->RemoveActiveContext(tool_context);
+
+    QCoreApplication::sendPostedEvents();
+
+    auto editor_changes = editor_spy.count();
+
+    CHECK(editor_proxy->isVisible());
+    CHECK(editor_proxy->isEnabled());
+    CHECK(editor_changes > 0);
+    CHECK(tool_spy.count() == 0);
+
+    // 重新计算所有命令，但状态没有改变的命令不会被更新
+    cmd_mgr->SetContext(sss::dscore::kGlobalContext);
+    QCoreApplication::sendPostedEvents();
+
+    CHECK(editor_spy.count() == editor_changes);
+    CHECK(tool_spy.count() == 0);
+  }
+
+  TEST_CASE_FIXTURE(CommandManagerFixture, "Command descriptors are materialised on demand") {
+    auto initial_count = cmd_mgr->MaterialisedCommandCount();
+    auto handled = 0;
+
+    sss::dscore::CommandDescriptor descriptor;
+
+    descriptor.id = "test.descriptor";
+    descriptor.text = "Descriptor";
+    descriptor.visibility_expression = sss::dscore::ContextExpression::Compile("Editor", context_mgr);
+    descriptor.handler = [&handled]() { handled++; };
+
+    CHECK(cmd_mgr->RegisterCommand(descriptor));
+    CHECK_FALSE(cmd_mgr->RegisterCommand(descriptor));
+    CHECK(cmd_mgr->MaterialisedCommandCount() == initial_count);
+
+    // 查找命令时创建
+    auto* command = cmd_mgr->FindCommand("test.descriptor");
+
+    REQUIRE(command != nullptr);
+    CHECK(cmd_mgr->MaterialisedCommandCount() == initial_count + 1);
+    CHECK(cmd_mgr->FindCommand("test.descriptor") == command);
+    CHECK(command->Action()->text() == "Descriptor");
+    CHECK_FALSE(command->Action()->isVisible());
+
+    context_mgr->SetContext(context_mgr->Context("Editor"));
+
+    CHECK(command->Action()->isVisible());
+
+    command->Action()->trigger();
+
+    CHECK(handled == 1);
+
+    // 带快捷键的描述符在注册时创建
+    sss::dscore::CommandDescriptor shortcut_descriptor;
+
+    shortcut_descriptor.id = "test.descriptor.shortcut";
+    shortcut_descriptor.text = "Shortcut";
+    shortcut_descriptor.shortcut = QKeySequence("Ctrl+Shift+D");
+
+    CHECK(cmd_mgr->RegisterCommand(shortcut_descriptor));
+    CHECK(cmd_mgr->MaterialisedCommandCount() == initial_count + 2);
+    CHECK(cmd_mgr->FindCommand("test.descriptor.shortcut")->Action()->shortcut() == QKeySequence("Ctrl+Shift+D"));
+  }
+
+  TEST_CASE_FIXTURE(CommandManagerFixture, "Async commands run on a worker and follow the re-entrancy policy") {
+    std::atomic<int> runs{0};
+    std::atomic<int> cancelled_runs{0};
+    QSemaphore gate;
+
+    // 处理函数等待 gate 放行或被取消
+    auto handler = [&](sss::dscore::CommandProgress& progress) {
+      runs++;
+      progress.SetProgress(0, 2);
+      progress.SetMessage("Working");
+
+      while (!gate.tryAcquire(1, 10)) {
+        if (progress.IsCancelled()) {
+          cancelled_runs++;
+          return;
+        }
+      }
+
+      progress.SetProgress(2, 2);
+    };
+
+    auto register_async = [&](const QString& id, sss::dscore::ReentrancyPolicy policy) {
+      auto* command = cmd_mgr->RegisterAction(new QAction(id), id, sss::dscore::kGlobalContext);
+
+      REQUIRE(cmd_mgr->SetAsyncHandler(command, handler, policy));
+
+      return command;
+    };
+
+    SUBCASE("Drop") {
+      auto* command = register_async("test.async.drop", sss::dscore::ReentrancyPolicy::kDrop);
+
+      CHECK_FALSE(cmd_mgr->SetAsyncHandler(command, handler, sss::dscore::ReentrancyPolicy::kQueue));
+      CHECK_FALSE(cmd_mgr->SetAsyncHandler(nullptr, handler, sss::dscore::ReentrancyPolicy::kQueue));
+
+      QSignalSpy finished(command, &sss::dscore::ICommand::ExecutionFinished);
+
+      command->Action()->trigger();
+
+      CHECK(command->IsRunning());
+      CHECK_FALSE(command->Action()->isEnabled());
+
+      command->Execute();
+      gate.release(2);
+
+      REQUIRE(WaitUntil([&]() { return !command->IsRunning(); }));
+
+      CHECK(runs == 1);
+      CHECK(finished.count() == 1);
+      CHECK(finished.at(0).at(0).toBool() == false);
+      CHECK(command->Action()->isEnabled());
+    }
+
+    SUBCASE("Queue") {
+      auto* command = register_async("test.async.queue", sss::dscore::ReentrancyPolicy::kQueue);
+
+      QSignalSpy finished(command, &sss::dscore::ICommand::ExecutionFinished);
+
+      command->Execute();
+      command->Execute();
+      command->Execute();
+      gate.release(2);
+
+      REQUIRE(WaitUntil([&]() { return !command->IsRunning(); }));
+
+      // 排队的执行合并为一次
+      CHECK(runs == 2);
+      CHECK(finished.count() == 2);
+    }
+
+    SUBCASE("Restart") {
+      auto* command = register_async("test.async.restart", sss::dscore::ReentrancyPolicy::kRestart);
+
+      QSignalSpy finished(command, &sss::dscore::ICommand::ExecutionFinished);
+
+      command->Execute();
+      REQUIRE(WaitUntil([&]() { return runs == 1; }));
+
+      command->Execute();
+      REQUIRE(WaitUntil([&]() { return finished.count() == 1; }));
+
+      CHECK(finished.at(0).at(0).toBool() == true);
+      CHECK(command->IsRunning());
+
+      gate.release();
+
+      REQUIRE(WaitUntil([&]() { return !command->IsRunning(); }));
+
+      CHECK(runs == 2);
+      CHECK(cancelled_runs == 1);
+      CHECK(finished.at(1).at(0).toBool() == false);
+    }
+
+    SUBCASE("Cancel") {
+      auto* command = register_async("test.async.cancel", sss::dscore::ReentrancyPolicy::kQueue);
+
+      QSignalSpy finished(command, &sss::dscore::ICommand::ExecutionFinished);
+
+      command->Execute();
+      command->Execute();
+      command->Cancel();
+
+      REQUIRE(WaitUntil([&]() { return !command->IsRunning(); }));
+
+      // 取消同时丢弃排队的执行
+      CHECK(cancelled_runs == 1);
+      CHECK(finished.count() == 1);
+      CHECK(finished.at(0).at(0).toBool() == true);
+    }
+
+    SUBCASE("Quit") {
+      auto* command = register_async("test.async.quit", sss::dscore::ReentrancyPolicy::kQueue);
+
+      command->Execute();
+      REQUIRE(WaitUntil([&]() { return runs == 1; }));
+
+      // 应用程序退出事件循环时取消运行中的命令，并在返回前等待处理函数结束
+      QMetaObject::invokeMethod(qApp, "aboutToQuit", Qt::DirectConnection);
+
+      CHECK(cancelled_runs == 1);
+
+      REQUIRE(WaitUntil([&]() { return !command->IsRunning(); }));
+    }
+
+    SUBCASE("Exception") {
+      auto* command = cmd_mgr->RegisterAction(new QAction("test.async.throw"), "test.async.throw",
+                                              sss::dscore::kGlobalContext);
+
+      REQUIRE(cmd_mgr->SetAsyncHandler(
+          command, [](sss::dscore::CommandProgress&) { throw std::runtime_error("handler failed"); },
+          sss::dscore::ReentrancyPolicy::kDrop));
+
+      QSignalSpy finished(command, &sss::dscore::ICommand::ExecutionFinished);
+
+      command->Execute();
+
+      // 处理函数抛出异常时运行照常结束，命令重新启用
+      REQUIRE(WaitUntil([&]() { return !command->IsRunning(); }));
+
+      CHECK(finished.count() == 1);
+      CHECK(command->Action()->isEnabled());
+    }
+  }
+
+  TEST_CASE_FIXTURE(CommandManagerFixture, "Activation stubs are replaced only once the component registers") {
+    sss::extsystem::ComponentLoader loader;
+
+    comp_mgr->AddObject(&loader);
+    loader.AddStaticComponents();
+    loader.LoadComponents();
+
+    auto handled = 0;
+
+    LazyCommandComponent::register_commands = nullptr;
+
+    // 没有组件声明的命令激活失败，保留占位动作，下次触发时重试
+    cmd_mgr->RegisterActivationStub("tests.lazy.missing");
+
+    auto* missing_command = cmd_mgr->FindCommand("tests.lazy.missing");
+
+    REQUIRE(missing_command != nullptr);
+    missing_command->Action()->trigger();
+    CHECK(missing_command->Action()->isEnabled());
+
+    cmd_mgr->RegisterActivationStub("tests.lazy.command");
+
+    auto* command = cmd_mgr->FindCommand("tests.lazy.command");
+
+    REQUIRE(command != nullptr);
+
+    LazyCommandComponent::register_commands = [this, &handled]() {
+      auto* action = new QAction("Lazy");
+
+      QObject::connect(action, &QAction::triggered, [&handled]() { handled++; });
+
+      cmd_mgr->RegisterAction(action, "tests.lazy.command", sss::dscore::kGlobalContext);
+    };
+
+    // 触发占位动作激活组件，组件注册真实动作后命令被重新触发
+    command->Action()->trigger();
+
+    CHECK(handled == 1);
+
+    command->Action()->trigger();
+
+    CHECK(handled == 2);
+
+    LazyCommandComponent::register_commands = nullptr;
+
+    loader.UnloadComponents();
+    comp_mgr->RemoveObject(&loader);
+  }
+
+  TEST_CASE_FIXTURE(CommandManagerFixture, "Activation stubs are replaced by commands registered as descriptors") {
+    sss::extsystem::ComponentLoader loader;
+
+    comp_mgr->AddObject(&loader);
+    loader.AddStaticComponents();
+    loader.LoadComponents();
+
+    auto handled = 0;
+
+    cmd_mgr->RegisterActivationStub("tests.lazy.command");
+
+    auto* command = cmd_mgr->FindCommand("tests.lazy.command");
+
+    REQUIRE(command != nullptr);
+
+    // 命令已有真实动作时不能再以描述符注册
+    auto registered_over_real_action = true;
+
+    LazyCommandComponent::register_commands = [this, &handled, &registered_over_real_action]() {
+      sss::dscore::CommandDescriptor descriptor;
+
+      descriptor.id = "tests.lazy.command";
+      descriptor.text = "Lazy";
+      descriptor.handler = [&handled]() { handled++; };
+
+      CHECK(cmd_mgr->RegisterCommand(descriptor));
+
+      registered_over_real_action = cmd_mgr->RegisterCommand(descriptor);
+    };
+
+    // 组件以描述符注册激活命令，描述符立即创建动作，占位动作被替换后命令被重新触发
+    command->Action()->trigger();
+
+    CHECK(handled == 1);
+    CHECK_FALSE(registered_over_real_action);
+    CHECK(cmd_mgr->FindCommand("tests.lazy.command") == command);
+
+    command->Action()->trigger();
+
+    CHECK(handled == 2);
+
+    LazyCommandComponent::register_commands = nullptr;
+
+    loader.UnloadComponents();
+    comp_mgr->RemoveObject(&loader);
+  }
 }
 
 #include "test_command_manager.moc"
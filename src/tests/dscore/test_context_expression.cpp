@@ -0,0 +1,115 @@
+#include <doctest/doctest.h>
+#include <dscore/ContextExpression.h>
+
+#include "ContextManager.h"
+
+TEST_SUITE("ContextExpression") {
+  TEST_CASE("Operators follow the usual precedence") {
+    sss::dscore::ContextManager mgr;
+
+    auto a = mgr.RegisterContext("a");
+    auto b = mgr.RegisterContext("b");
+    auto c = mgr.RegisterContext("c");
+
+    auto expression = sss::dscore::ContextExpression::Compile("a || b && !c", &mgr);
+
+    REQUIRE(expression.IsValid());
+    CHECK(expression.ReferencedContexts() == sss::dscore::ContextSet{a, b, c});
+
+    CHECK(expression.Evaluate({a}));
+    CHECK(expression.Evaluate({a, c}));
+    CHECK(expression.Evaluate({b}));
+    CHECK_FALSE(expression.Evaluate({b, c}));
+    CHECK_FALSE(expression.Evaluate({}));
+
+    auto grouped = sss::dscore::ContextExpression::Compile("(a || b) && !c", &mgr);
+
+    REQUIRE(grouped.IsValid());
+    CHECK(grouped.Evaluate({a}));
+    CHECK_FALSE(grouped.Evaluate({a, c}));
+    CHECK(sss::dscore::ContextExpression::Compile("!!a", &mgr).Evaluate({a}));
+    CHECK(sss::dscore::ContextExpression::Compile("!(a && b)", &mgr).Evaluate({a}));
+  }
+
+  TEST_CASE("Unknown names are registered and flat expressions use bitmasks") {
+    sss::dscore::ContextManager mgr;
+
+    auto any_of = sss::dscore::ContextExpression::Compile("ws1.page || ws2.page", &mgr);
+    auto all_of = sss::dscore::ContextExpression::Compile("ws1.page && ws1.page:selection", &mgr);
+
+    auto page1 = mgr.Context("ws1.page");
+    auto page2 = mgr.Context("ws2.page");
+    auto selection = mgr.Context("ws1.page:selection");
+
+    REQUIRE(page1 != 0);
+    REQUIRE(page2 != 0);
+    REQUIRE(selection != 0);
+
+    CHECK(any_of.Evaluate({page2}));
+    CHECK_FALSE(any_of.Evaluate({selection}));
+    CHECK_FALSE(all_of.Evaluate({page1}));
+    CHECK(all_of.Evaluate({page1, selection}));
+
+    CHECK(sss::dscore::ContextExpression::AnyOf({page1, page2}).Evaluate({page1}));
+    CHECK_FALSE(sss::dscore::ContextExpression::AnyOf({}).Evaluate({page1}));
+    CHECK(sss::dscore::ContextExpression::AllOf({}).Evaluate({}));
+    CHECK(sss::dscore::ContextExpression::Always().Evaluate({}));
+    CHECK_FALSE(sss::dscore::ContextExpression::Never().Evaluate({page1}));
+  }
+
+  TEST_CASE("Syntax errors produce an invalid expression that is never true") {
+    sss::dscore::ContextManager mgr;
+
+    auto a = mgr.RegisterContext("a");
+
+    for (const auto* text : {"", "a &&", "(a", "a b", "a & b", "|| a", "a)"}) {
+      QString error;
+      auto expression = sss::dscore::ContextExpression::Compile(text, &mgr, &error);
+
+      CAPTURE(text);
+      CHECK_FALSE(expression.IsValid());
+      CHECK_FALSE(error.isEmpty());
+      CHECK_FALSE(expression.Evaluate({a}));
+    }
+
+    QString error = "stale";
+
+    CHECK(sss::dscore::ContextExpression::Compile("a", &mgr, &error).IsValid());
+    CHECK(error.isEmpty());
+  }
+
+  TEST_CASE("Expressions nested deeper than the evaluation stack are rejected") {
+    sss::dscore::ContextManager mgr;
+
+    // 右结合的 a && (a && (...)) 需要与嵌套层数相同的栈深度
+    QString deep = "a";
+
+    for (int index = 0; index < 70; index++) {
+      deep = QString("!a && (%1)").arg(deep);
+    }
+
+    CHECK_FALSE(sss::dscore::ContextExpression::Compile(deep, &mgr).IsValid());
+
+    // 解析器在递归中途拒绝过深的嵌套，不会耗尽调用栈
+    for (const auto& prefix : {QString("("), QString("!")}) {
+      QString error;
+      auto expression = sss::dscore::ContextExpression::Compile(prefix.repeated(100000) + "a", &mgr, &error);
+
+      CHECK_FALSE(expression.IsValid());
+      CHECK(error.contains("nested deeper"));
+    }
+
+    // 左结合的长表达式不会加深栈
+    QString long_expression = "!a";
+
+    for (int index = 0; index < 200; index++) {
+      long_expression += " || b";
+    }
+
+    auto expression = sss::dscore::ContextExpression::Compile(long_expression, &mgr);
+
+    REQUIRE(expression.IsValid());
+    CHECK(expression.Evaluate({mgr.Context("b")}));
+    CHECK_FALSE(expression.Evaluate({mgr.Context("a")}));
+  }
+}
@@ -90,4 +90,116 @@ TEST_SUITE("ContextManager") {
 
     CHECK(mgr.GetActiveContexts().contains(tool_a1));
   }
+
+  TEST_CASE("Active context set follows the active context list") {
+    sss::dscore::ContextManager mgr;
+    int mode_a = mgr.RegisterContext("ModeA");
+    int mode_b = mgr.RegisterContext("ModeB");
+    int tool_a1 = mgr.RegisterContext("ToolA1");
+
+    CHECK(mgr.GetActiveContextSet() == sss::dscore::ContextSet{sss::dscore::kGlobalContext});
+
+    mgr.ActivateMode(mode_a);
+    mgr.AddActiveContext(tool_a1);
+    CHECK(mgr.GetActiveContextSet() == sss::dscore::ContextSet(mgr.GetActiveContexts()));
+
+    mgr.ActivateMode(mode_b);
+    CHECK(mgr.GetActiveContextSet() == sss::dscore::ContextSet{sss::dscore::kGlobalContext, mode_b});
+
+    mgr.ActivateMode(mode_a);
+    CHECK(mgr.GetActiveContextSet().Contains(tool_a1));
+
+    mgr.RemoveActiveContext(tool_a1);
+    CHECK_FALSE(mgr.GetActiveContextSet().Contains(tool_a1));
+
+    mgr.SetContext(mode_b);
+    CHECK(mgr.GetActiveContextSet() == sss::dscore::ContextSet(mgr.GetActiveContexts()));
+  }
+
+  TEST_CASE("Transactions publish one coalesced change") {
+    sss::dscore::ContextManager mgr;
+    int mode = mgr.RegisterContext("Mode");
+    int tool1 = mgr.RegisterContext("Tool1");
+    int tool2 = mgr.RegisterContext("Tool2");
+    int tool3 = mgr.RegisterContext("Tool3");
+
+    mgr.SetContext(mode);
+    mgr.AddActiveContext(tool3);
+
+    QSignalSpy context_spy(&mgr, &sss::dscore::ContextManager::ContextChanged);
+    QSignalSpy delta_spy(&mgr, &sss::dscore::ContextManager::ActiveContextsChanged);
+
+    {
+      sss::dscore::ContextTransaction transaction(&mgr);
+
+      mgr.AddActiveContext(tool1);
+      {
+        // 嵌套事务在最外层提交时才发布
+        sss::dscore::ContextTransaction nested(&mgr);
+
+        mgr.AddActiveContext(tool2);
+      }
+      mgr.RemoveActiveContext(tool3);
+      mgr.AddActiveContext(tool3);
+      mgr.RemoveActiveContext(tool3);
+
+      CHECK(context_spy.isEmpty());
+      // 事务中的查询反映当前状态
+      CHECK(mgr.GetActiveContextSet().Contains(tool2));
+    }
+
+    REQUIRE(context_spy.count() == 1);
+    REQUIRE(delta_spy.count() == 1);
+
+    auto context_arguments = context_spy.takeFirst();
+    CHECK(context_arguments.at(0).toInt() == tool2);
+    CHECK(context_arguments.at(1).toInt() == tool3);
+
+    auto delta_arguments = delta_spy.takeFirst();
+    CHECK(qvariant_cast<sss::dscore::ContextSet>(delta_arguments.at(0)) == sss::dscore::ContextSet{tool1, tool2});
+    CHECK(qvariant_cast<sss::dscore::ContextSet>(delta_arguments.at(1)) == sss::dscore::ContextSet{tool3});
+
+    // 没有变化的事务不发布
+    {
+      sss::dscore::ContextTransaction transaction(&mgr);
+
+      mgr.AddActiveContext(tool1);
+    }
+
+    CHECK(context_spy.isEmpty());
+
+    // 相互抵消的变化不发布
+    {
+      sss::dscore::ContextTransaction transaction(&mgr);
+
+      mgr.AddActiveContext(tool3);
+      mgr.RemoveActiveContext(tool3);
+    }
+
+    CHECK(context_spy.isEmpty());
+    CHECK(delta_spy.isEmpty());
+
+    // 只改变顺序的事务同样发布，集合和主上下文都没有变化
+    mgr.AddActiveContext(tool3);
+    context_spy.clear();
+    delta_spy.clear();
+
+    {
+      sss::dscore::ContextTransaction transaction(&mgr);
+
+      mgr.RemoveActiveContext(tool1);
+      mgr.RemoveActiveContext(tool3);
+      mgr.AddActiveContext(tool1);
+      mgr.AddActiveContext(tool3);
+    }
+
+    auto expected_contexts = sss::dscore::ContextList{sss::dscore::kGlobalContext, mode, tool2, tool1, tool3};
+    CHECK(mgr.GetActiveContexts() == expected_contexts);
+    REQUIRE(context_spy.count() == 1);
+    REQUIRE(delta_spy.count() == 1);
+
+    delta_arguments = delta_spy.takeFirst();
+    CHECK(qvariant_cast<sss::dscore::ContextSet>(delta_arguments.at(0)).IsEmpty());
+    CHECK(qvariant_cast<sss::dscore::ContextSet>(delta_arguments.at(1)).IsEmpty());
+  }
 }
@@ -0,0 +1,59 @@
+#include <doctest/doctest.h>
+#include <dscore/ContextSet.h>
+
+TEST_SUITE("ContextSet") {
+  TEST_CASE("Contexts are inserted, removed and listed in ascending order") {
+    sss::dscore::ContextSet set;
+
+    CHECK(set.IsEmpty());
+
+    set.Insert(3);
+    set.Insert(0);
+    set.Insert(200);  // 超出内部缓冲区
+    set.Insert(-1);   // 忽略
+
+    CHECK(set.Contains(0));
+    CHECK(set.Contains(3));
+    CHECK(set.Contains(200));
+    CHECK_FALSE(set.Contains(4));
+    CHECK_FALSE(set.Contains(-1));
+    CHECK_FALSE(set.Contains(1000));
+    CHECK(set.ToList() == QList<int>{0, 3, 200});
+
+    QList<int> visited;
+
+    set.ForEach([&visited](int context_id) { visited.append(context_id); });
+
+    CHECK(visited == QList<int>{0, 3, 200});
+
+    set.Remove(200);
+    set.Remove(1000);
+
+    CHECK(set.ToList() == QList<int>{0, 3});
+    CHECK(set == sss::dscore::ContextSet{3, 0});
+
+    set.Clear();
+
+    CHECK(set.IsEmpty());
+  }
+
+  TEST_CASE("Intersection and subset tests match the list semantics") {
+    sss::dscore::ContextSet active{0, 2, 70};
+
+    CHECK(sss::dscore::ContextSet{5, 70}.Intersects(active));
+    CHECK_FALSE(sss::dscore::ContextSet{5, 130}.Intersects(active));
+    CHECK_FALSE(sss::dscore::ContextSet{}.Intersects(active));
+
+    CHECK(sss::dscore::ContextSet{2, 70}.IsSubsetOf(active));
+    CHECK_FALSE(sss::dscore::ContextSet{2, 3}.IsSubsetOf(active));
+    CHECK_FALSE(sss::dscore::ContextSet{2, 130}.IsSubsetOf(active));
+    CHECK(sss::dscore::ContextSet{}.IsSubsetOf(active));
+
+    // 移除后留下的空字不影响比较
+    sss::dscore::ContextSet shrunk{0, 2, 70, 300};
+    shrunk.Remove(300);
+
+    CHECK(shrunk == active);
+    CHECK(active.IsSubsetOf(shrunk));
+  }
+}
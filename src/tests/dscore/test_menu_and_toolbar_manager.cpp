@@ -5,9 +5,14 @@
 #include <dscore/IMenuProvider.h>
 #include <dscore/IToolbarProvider.h>
 #include <dscore/MenuAndToolbarManager.h>
+#include <extsystem/Component.h>
+#include <extsystem/ComponentLoader.h>
 #include <extsystem/IComponentManager.h>
 
+#include <QFile>
+#include <QFileInfo>
 #include <QSignalSpy>
+#include <QTemporaryDir>
 
 // Mock Command Manager
 class MockCommandManager : public sss::dscore::ICommandManager {
@@ -32,6 +37,34 @@ class MockCommandManager : public sss::dscore::ICommandManager {
     (void)enabled_contexts;
     return true;
   }
+  auto RegisterAction(QAction* action, QString id, const sss::dscore::ContextExpression& visibility_expression,
+                      const sss::dscore::ContextExpression& enabled_expression) -> sss::dscore::ICommand* override {
+    (void)action;
+    (void)id;
+    (void)visibility_expression;
+    (void)enabled_expression;
+    return nullptr;
+  }
+  auto RegisterAction(QAction* action, sss::dscore::ICommand* command,
+                      const sss::dscore::ContextExpression& visibility_expression,
+                      const sss::dscore::ContextExpression& enabled_expression) -> bool override {
+    (void)action;
+    (void)command;
+    (void)visibility_expression;
+    (void)enabled_expression;
+    return true;
+  }
+  auto RegisterCommand(const sss::dscore::CommandDescriptor& descriptor) -> bool override {
+    (void)descriptor;
+    return false;
+  }
+  auto SetAsyncHandler(sss::dscore::ICommand* command, sss::dscore::AsyncCommandHandler handler,
+                       sss::dscore::ReentrancyPolicy policy) -> bool override {
+    (void)command;
+    (void)handler;
+    (void)policy;
+    return false;
+  }
   auto SetContext(int context_id) -> void override { (void)context_id; }
 
   auto CreateActionContainer(const QString& identifier, sss::dscore::ContainerType type,
@@ -145,6 +178,59 @@ TEST_SUITE("MenuAndToolbarManager") {
     comp_mgr->RemoveObject(&toolbar_provider);
     comp_mgr->RemoveObject(&command_provider);
   }
+
+#if defined(DS_RUNTIME_INSTALL_PLUGIN)
+  TEST_CASE_FIXTURE(MenuToolbarFixture, "Components installed at runtime contribute their menus once") {
+    constexpr auto kRuntimeInstallMenu = "Tests.RuntimeInstallMenu";
+
+    sss::dscore::MenuAndToolbarManager manager;
+
+    manager.Build();
+
+    // 与 CoreComponent 相同，组件激活后增量构建
+    sss::extsystem::ComponentLoader loader;
+    QList<sss::extsystem::Component*> activated_components;
+    auto activated_count = 0;
+
+    QObject::connect(&loader, &sss::extsystem::ComponentLoader::ComponentsActivated,
+                     [&](const QList<sss::extsystem::Component*>& components) {
+                       activated_components = components;
+                       activated_count++;
+                       manager.Build();
+                     });
+
+    loader.LoadComponents();
+
+    QTemporaryDir temp_dir;
+    REQUIRE(temp_dir.isValid());
+
+    auto plugin_filename = QString(DS_RUNTIME_INSTALL_PLUGIN);
+    REQUIRE(QFile::copy(plugin_filename, temp_dir.filePath(QFileInfo(plugin_filename).fileName())));
+
+    auto installed_components = loader.InstallComponents(QStringList{temp_dir.path()});
+
+    REQUIRE(installed_components.size() == 1);
+    CHECK(installed_components.first()->Name() == "RuntimeInstall");
+    CHECK(activated_count == 1);
+    CHECK(activated_components == installed_components);
+
+    // 插件在 InitialiseEvent 中注册菜单提供者
+    CHECK(sss::extsystem::GetTObjects<sss::dscore::IMenuProvider>().size() == 1);
+    CHECK(cmd_mgr->created_containers.count(kRuntimeInstallMenu) == 1);
+
+    // 已安装的库不会再次安装，再次构建也不会重复调用已调用过的提供者
+    CHECK(loader.InstallComponents(QStringList{temp_dir.path()}).isEmpty());
+
+    manager.Build();
+
+    CHECK(activated_count == 1);
+    CHECK(cmd_mgr->created_containers.count(kRuntimeInstallMenu) == 1);
+
+    loader.UnloadComponents();
+
+    CHECK(sss::extsystem::GetTObjects<sss::dscore::IMenuProvider>().isEmpty());
+  }
+#endif
 }
 
 #include "test_menu_and_toolbar_manager.moc"
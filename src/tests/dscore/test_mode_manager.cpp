@@ -62,6 +62,24 @@ class MockWorkbench : public QObject, public sss::dscore::IWorkbench {
     (void)visible_contexts;
     (void)enable_contexts;
   }
+  void AddSqueezeWidget(sss::dscore::SqueezeSide side, QWidget* widget, int priority,
+                        const sss::dscore::ContextExpression& visible_expression,
+                        const sss::dscore::ContextExpression& enable_expression) override {
+    (void)side;
+    (void)widget;
+    (void)priority;
+    (void)visible_expression;
+    (void)enable_expression;
+  }
+  void AddOverlayWidget(sss::dscore::OverlayZone zone, QWidget* widget, int priority,
+                        const sss::dscore::ContextExpression& visible_expression,
+                        const sss::dscore::ContextExpression& enable_expression) override {
+    (void)zone;
+    (void)widget;
+    (void)priority;
+    (void)visible_expression;
+    (void)enable_expression;
+  }
   void ShowNotification(const QString& message, int duration_ms) override {
     (void)message;
     (void)duration_ms;
@@ -0,0 +1,16 @@
+// 测试插件以 Qt 静态插件的形式编译进测试程序，moc 生成 qt_static_plugin_LifecycleBaseComponent()
+#define QT_STATICPLUGIN
+
+#include <QtPlugin>
+
+#include "lifecycle_component.h"
+
+class LifecycleBaseComponent : public LifecycleComponent {
+  Q_OBJECT
+  Q_PLUGIN_METADATA(IID SSSComponentInterfaceIID FILE "lifecycle_base.json")
+
+ public:
+  LifecycleBaseComponent() : LifecycleComponent("LifecycleBase", true) {}
+};
+
+#include "lifecycle_base.moc"
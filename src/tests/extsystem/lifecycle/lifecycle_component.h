@@ -0,0 +1,51 @@
+#pragma once
+
+#include <extsystem/IComponent.h>
+
+#include <QFuture>
+#include <QFutureInterface>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+#include <utility>
+
+// 按调用顺序记录生命周期事件的测试组件，派生类以 Qt 静态插件的形式编译进测试程序（每个插件一个源文件）。
+// 所有派生组件都声明了激活触发器，因此只有测试显式激活时才会加载。
+class LifecycleComponent : public QObject, public sss::extsystem::IComponent {
+  Q_OBJECT
+  Q_INTERFACES(sss::extsystem::IComponent)
+
+ public:
+  static inline QStringList events;
+
+  explicit LifecycleComponent(QString name, bool initialise_async = false)
+      : name_(std::move(name)), initialise_async_(initialise_async) {}
+
+  auto InitialiseEvent() -> void override { events.append("Initialise " + name_); }
+
+  auto InitialiseAsyncEvent() -> QFuture<void> override {
+    if (!initialise_async_) {
+      return {};
+    }
+
+    QFutureInterface<void> future_interface;
+
+    future_interface.reportStarted();
+
+    // 只有组件加载器在等待期间处理事件时计时器才会触发
+    QTimer::singleShot(20, this, [this, future_interface]() mutable {
+      events.append("AsyncFinished " + name_);
+      future_interface.reportFinished();
+    });
+
+    return future_interface.future();
+  }
+
+  auto InitialisationFinishedEvent() -> void override { events.append("InitialisationFinished " + name_); }
+
+  auto FinaliseEvent() -> void override { events.append("Finalise " + name_); }
+
+ private:
+  QString name_;
+  bool initialise_async_;
+};
@@ -0,0 +1,16 @@
+// 测试插件以 Qt 静态插件的形式编译进测试程序，moc 生成 qt_static_plugin_LifecycleTopComponent()
+#define QT_STATICPLUGIN
+
+#include <QtPlugin>
+
+#include "lifecycle_component.h"
+
+class LifecycleTopComponent : public LifecycleComponent {
+  Q_OBJECT
+  Q_PLUGIN_METADATA(IID SSSComponentInterfaceIID FILE "lifecycle_top.json")
+
+ public:
+  LifecycleTopComponent() : LifecycleComponent("LifecycleTop") {}
+};
+
+#include "lifecycle_top.moc"
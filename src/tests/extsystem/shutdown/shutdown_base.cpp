@@ -0,0 +1,16 @@
+// 测试插件以 Qt 静态插件的形式编译进测试程序，moc 生成 qt_static_plugin_ShutdownBaseComponent()
+#define QT_STATICPLUGIN
+
+#include <QtPlugin>
+
+#include "shutdown_component.h"
+
+class ShutdownBaseComponent : public ShutdownComponent {
+  Q_OBJECT
+  Q_PLUGIN_METADATA(IID SSSComponentInterfaceIID FILE "shutdown_base.json")
+
+ public:
+  ShutdownBaseComponent() : ShutdownComponent("ShutdownBase") {}
+};
+
+#include "shutdown_base.moc"
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <extsystem/IComponent.h>
+
+#include <QObject>
+#include <QString>
+#include <functional>
+#include <utility>
+
+// 声明了 "FinaliseOnExit" 的测试组件，快速关闭时 FinaliseEvent 在线程池中调用 finalise 回调。
+// 派生类以 Qt 静态插件的形式编译进测试程序（每个插件一个源文件），只有测试显式激活时才会加载。
+class ShutdownComponent : public QObject, public sss::extsystem::IComponent {
+  Q_OBJECT
+  Q_INTERFACES(sss::extsystem::IComponent)
+
+ public:
+  static inline std::function<void(const QString&)> finalise;
+
+  explicit ShutdownComponent(QString name) : name_(std::move(name)) {}
+
+  auto FinaliseEvent() -> void override {
+    // 复制回调，超时后仍在运行的 FinaliseEvent 不受测试替换回调的影响
+    auto callback = finalise;
+
+    if (callback) {
+      callback(name_);
+    }
+  }
+
+ private:
+  QString name_;
+};
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <extsystem/Component.h>
+
+#include <QJsonObject>
 #include <QObject>
+#include <memory>
+#include <vector>
 
 // 为测试中的 Q_OBJECT 宏兼容性定义 MyCustomObject
 class MyCustomObject : public QObject {
@@ -8,3 +13,43 @@ class MyCustomObject : public QObject {
  public:
   explicit MyCustomObject(QObject* parent = nullptr) : QObject(parent) {}
 };
+
+// 不派生自 QObject 的纯接口，用于测试按 IID 的查找
+class ITestService {
+ public:
+  virtual ~ITestService() = default;
+};
+
+Q_DECLARE_INTERFACE(ITestService, "sss.tests.ITestService/1.0")
+
+class TestServiceObject : public QObject, public ITestService {
+  Q_OBJECT
+  Q_INTERFACES(ITestService)
+ public:
+  explicit TestServiceObject(QObject* parent = nullptr) : QObject(parent) {}
+};
+
+// 创建一个只包含名称和版本元数据的合成组件
+inline auto MakeSyntheticComponent(const QString& name, const QString& version = "1.0.0")
+    -> std::unique_ptr<sss::extsystem::Component> {
+  QJsonObject metadata{{"MetaData", QJsonObject{{"Name", name}, {"Version", version}}}};
+
+  return std::make_unique<sss::extsystem::Component>(name, QString("lib%1.so").arg(name), metadata);
+}
+
+// 创建 count 个合成组件，第 i 个组件依赖于它之前的至多 fan_out 个组件（按固定步长分散选择）
+inline auto MakeSyntheticComponentGraph(int count, int fan_out)
+    -> std::vector<std::unique_ptr<sss::extsystem::Component>> {
+  std::vector<std::unique_ptr<sss::extsystem::Component>> components;
+  components.reserve(count);
+
+  for (int index = 0; index < count; index++) {
+    components.push_back(MakeSyntheticComponent(QString("synthetic%1").arg(index)));
+
+    for (int edge = 1; edge <= fan_out && edge * 7 <= index; edge++) {
+      components.back()->AddDependency(components.at(index - edge * 7).get(), QVersionNumber(1, 0, 0));
+    }
+  }
+
+  return components;
+}
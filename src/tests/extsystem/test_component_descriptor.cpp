@@ -0,0 +1,226 @@
+#include <doctest/doctest.h>
+#include <extsystem/Component.h>
+#include <extsystem/ComponentDescriptor.h>
+#include <extsystem/EmbeddedDescriptor.h>
+
+#include <QDataStream>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <cstring>
+
+#if defined(Q_OF_ELF)
+#include <elf.h>
+#endif
+
+namespace {
+auto DescriptorMetadata() -> QJsonObject {
+  return QJsonObject{{"Name", "ws2"},
+                     {"Version", "0.1.0"},
+                     {"Branch", "main"},
+                     {"Revision", "abc"},
+                     {"Vendor", "3d-scantech.com"},
+                     {"Category", "Workspace"},
+                     {"License", QJsonArray{"MIT"}},
+                     {"Description", QJsonArray{"Workspace 2"}},
+                     {"Dependencies", QJsonArray{QJsonObject{{"Name", "dscore"}, {"Version", "1.0.0"}}}},
+                     {"CanBeDisabled", false},
+                     {"FinaliseOnExit", true},
+                     {"Activation", QJsonObject{{"Modes", QJsonArray{"ws2.mode"}}}}};
+}
+
+// 与 cmake/component_descriptor_generate.cmake 为 DescriptorMetadata() 生成的字段区相同
+#define DESCRIPTOR_FIELDS \
+  "ws2" "\0" "0.1.0" "\0" "main" "\0" "abc" "\0" "3d-scantech.com" "\0" "Workspace" "\0" "" "\0" "" "\0" "MIT" "\0" \
+  "Workspace 2" "\0" "dscore" "\x1f" "1.0.0" "\0" "ws2.mode" "\0" "" "\0" "" "\0" "8"
+
+const sss::extsystem::EmbeddedDescriptor<sizeof(DESCRIPTOR_FIELDS)> kEmbeddedDescriptor = {
+    {DS_EMBEDDED_DESCRIPTOR_MAGIC, sss::extsystem::kEmbeddedDescriptorFormat, QT_VERSION, 1, sizeof(DESCRIPTOR_FIELDS)},
+    DESCRIPTOR_FIELDS};
+
+#if defined(Q_OF_ELF)
+// 写入只有节头表的最小 ELF 文件：描述符放在名为 section_name 的节中，后面是节名字符串表和节头表
+auto WriteElfLibrary(const QString& filename, const char* section_name) -> void {
+  QByteArray section_names = QByteArray(1, '\0') + section_name + '\0' + ".shstrtab" + '\0';
+  auto descriptor_offset = sizeof(Elf64_Ehdr);
+  auto names_offset = descriptor_offset + sizeof(kEmbeddedDescriptor);
+  auto section_headers_offset = names_offset + static_cast<size_t>(section_names.size());
+
+  Elf64_Ehdr file_header{};
+
+  std::memcpy(file_header.e_ident, ELFMAG, SELFMAG);
+  file_header.e_ident[EI_CLASS] = ELFCLASS64;
+  file_header.e_ident[EI_DATA] = Q_BYTE_ORDER == Q_LITTLE_ENDIAN ? ELFDATA2LSB : ELFDATA2MSB;
+  file_header.e_ident[EI_VERSION] = EV_CURRENT;
+  file_header.e_type = ET_DYN;
+  file_header.e_version = EV_CURRENT;
+  file_header.e_ehsize = sizeof(Elf64_Ehdr);
+  file_header.e_shoff = section_headers_offset;
+  file_header.e_shentsize = sizeof(Elf64_Shdr);
+  file_header.e_shnum = 3;
+  file_header.e_shstrndx = 2;
+
+  Elf64_Shdr section_headers[3] = {};
+
+  section_headers[1].sh_name = 1;
+  section_headers[1].sh_type = SHT_PROGBITS;
+  section_headers[1].sh_offset = descriptor_offset;
+  section_headers[1].sh_size = sizeof(kEmbeddedDescriptor);
+  section_headers[2].sh_name = static_cast<Elf64_Word>(std::strlen(section_name) + 2);
+  section_headers[2].sh_type = SHT_STRTAB;
+  section_headers[2].sh_offset = names_offset;
+  section_headers[2].sh_size = static_cast<Elf64_Xword>(section_names.size());
+
+  QFile file(filename);
+
+  REQUIRE(file.open(QIODevice::WriteOnly));
+  file.write(reinterpret_cast<const char*>(&file_header), sizeof(file_header));
+  file.write(reinterpret_cast<const char*>(&kEmbeddedDescriptor), sizeof(kEmbeddedDescriptor));
+  file.write(section_names);
+  file.write(reinterpret_cast<const char*>(section_headers), sizeof(section_headers));
+}
+#endif
+}  // namespace
+
+TEST_SUITE("ComponentDescriptor") {
+  TEST_CASE("Metadata is parsed into typed fields") {
+    auto descriptor = sss::extsystem::ComponentDescriptor::FromMetadata(DescriptorMetadata());
+
+    CHECK(descriptor.Name() == "ws2");
+    CHECK(descriptor.Version() == QVersionNumber(0, 1, 0));
+    CHECK(descriptor.VersionString() == "0.1.0-main (abc)");
+    CHECK(descriptor.Identifier() == "ws2.3d-scantech.com");
+    REQUIRE(descriptor.Dependencies().size() == 1);
+    CHECK(descriptor.Dependencies().first().name == "dscore");
+    CHECK(descriptor.Dependencies().first().version == QVersionNumber(1, 0, 0));
+    CHECK(descriptor.ActivationModes() == QStringList{"ws2.mode"});
+    CHECK_FALSE(descriptor.Options().testFlag(sss::extsystem::ComponentDescriptor::kCanBeDisabled));
+    CHECK(descriptor.Options().testFlag(sss::extsystem::ComponentDescriptor::kLazy));
+  }
+
+  TEST_CASE("Component accessors read the descriptor") {
+    sss::extsystem::Component component("ws2", "libws2.so", QJsonObject{{"MetaData", DescriptorMetadata()}});
+
+    CHECK(component.Version() == QVersionNumber(0, 1, 0));
+    CHECK(component.Vendor() == "3d-scantech.com");
+    CHECK(component.Dependencies() == "dscore (1.0.0)\r\n");
+    CHECK_FALSE(component.CanBeDisabled());
+    CHECK(component.IsLazy());
+    CHECK(component.FinalisesOnExit());
+
+    // 缺省时组件可以禁用
+    sss::extsystem::Component default_component("empty", "libempty.so", QJsonObject{});
+    CHECK(default_component.CanBeDisabled());
+    CHECK_FALSE(default_component.IsLazy());
+    CHECK_FALSE(default_component.FinalisesOnExit());
+  }
+
+  TEST_CASE("Descriptors survive a data stream round trip with interned strings") {
+    auto descriptor = sss::extsystem::ComponentDescriptor::FromMetadata(DescriptorMetadata());
+
+    QByteArray data;
+    {
+      QDataStream stream(&data, QIODevice::WriteOnly);
+      stream << descriptor;
+    }
+
+    sss::extsystem::ComponentDescriptor restored;
+    {
+      QDataStream stream(data);
+      stream >> restored;
+      CHECK(stream.status() == QDataStream::Ok);
+    }
+
+    CHECK(restored == descriptor);
+    // 驻留的字符串共享同一份数据
+    CHECK(restored.Name().constData() == descriptor.Name().constData());
+  }
+
+  TEST_CASE("Embedded descriptors match the descriptors parsed from metadata") {
+    sss::extsystem::ComponentDescriptor descriptor;
+    quint32 qt_version = 0;
+    bool debug_build = false;
+
+    REQUIRE(sss::extsystem::ComponentDescriptor::FromEmbedded(reinterpret_cast<const char*>(&kEmbeddedDescriptor),
+                                                              sizeof(kEmbeddedDescriptor), descriptor, qt_version,
+                                                              debug_build));
+
+    CHECK(descriptor == sss::extsystem::ComponentDescriptor::FromMetadata(DescriptorMetadata()));
+    CHECK(descriptor.Options().testFlag(sss::extsystem::ComponentDescriptor::kFinaliseOnExit));
+    CHECK(qt_version == QT_VERSION);
+    CHECK(debug_build);
+
+    // 标记或长度不符时拒绝
+    auto corrupted = kEmbeddedDescriptor;
+    corrupted.header.magic[0] = 'X';
+
+    CHECK_FALSE(sss::extsystem::ComponentDescriptor::FromEmbedded(
+        reinterpret_cast<const char*>(&corrupted), sizeof(corrupted), descriptor, qt_version, debug_build));
+    CHECK_FALSE(sss::extsystem::ComponentDescriptor::FromEmbedded(reinterpret_cast<const char*>(&kEmbeddedDescriptor),
+                                                                  sizeof(kEmbeddedDescriptor) - 8, descriptor,
+                                                                  qt_version, debug_build));
+  }
+
+  TEST_CASE("Embedded descriptors are found inside library files") {
+    QTemporaryDir folder;
+
+    REQUIRE(folder.isValid());
+
+    auto filename = folder.filePath("libws2.so");
+    QFile file(filename);
+
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    file.write(QByteArray(1000, 'x'));
+    // 孤立的标记不影响后续的查找
+    file.write(DS_EMBEDDED_DESCRIPTOR_MAGIC, sizeof(DS_EMBEDDED_DESCRIPTOR_MAGIC));
+    file.write(reinterpret_cast<const char*>(&kEmbeddedDescriptor), sizeof(kEmbeddedDescriptor));
+    file.write(QByteArray(1000, 'x'));
+    file.close();
+
+    sss::extsystem::ComponentDescriptor descriptor;
+    quint32 qt_version = 0;
+    bool debug_build = false;
+
+    REQUIRE(sss::extsystem::ComponentDescriptor::FromLibrary(filename, descriptor, qt_version, debug_build));
+    CHECK(descriptor.Name() == "ws2");
+
+    // 没有描述符的库
+    auto plain_filename = folder.filePath("libplain.so");
+    QFile plain_file(plain_filename);
+
+    REQUIRE(plain_file.open(QIODevice::WriteOnly));
+    plain_file.write(QByteArray(1000, 'x'));
+    plain_file.close();
+
+    CHECK_FALSE(sss::extsystem::ComponentDescriptor::FromLibrary(plain_filename, descriptor, qt_version, debug_build));
+  }
+
+#if defined(Q_OF_ELF)
+  TEST_CASE("ELF libraries are read through the descriptor section only") {
+    QTemporaryDir folder;
+
+    REQUIRE(folder.isValid());
+
+    sss::extsystem::ComponentDescriptor descriptor;
+    quint32 qt_version = 0;
+    bool debug_build = false;
+
+    auto filename = folder.filePath("libws2.so");
+
+    WriteElfLibrary(filename, ".dsdescriptor");
+
+    REQUIRE(sss::extsystem::ComponentDescriptor::FromLibrary(filename, descriptor, qt_version, debug_build));
+    CHECK(descriptor.Name() == "ws2");
+    CHECK(qt_version == QT_VERSION);
+    CHECK(debug_build);
+
+    // 描述符不在 .dsdescriptor 节中时不会搜索整个文件
+    auto other_filename = folder.filePath("libother.so");
+
+    WriteElfLibrary(other_filename, ".rodata");
+
+    CHECK_FALSE(sss::extsystem::ComponentDescriptor::FromLibrary(other_filename, descriptor, qt_version, debug_build));
+  }
+#endif
+}
@@ -0,0 +1,78 @@
+#include <doctest/doctest.h>
+#include <extsystem/Component.h>
+#include <extsystem/ComponentLoader.h>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+#include <QtPlugin>
+
+#include "lifecycle/lifecycle_component.h"
+
+// LifecycleMiddle 依赖 LifecycleBase，LifecycleTop 依赖 LifecycleMiddle，LifecycleLate 没有依赖项
+Q_IMPORT_PLUGIN(LifecycleBaseComponent)
+Q_IMPORT_PLUGIN(LifecycleMiddleComponent)
+Q_IMPORT_PLUGIN(LifecycleTopComponent)
+Q_IMPORT_PLUGIN(LifecycleLateComponent)
+
+TEST_SUITE("ComponentLoader") {
+  TEST_CASE("Dependency levels initialise in order and finish in reverse order") {
+    using ActivationTrigger = sss::extsystem::ComponentLoader::ActivationTrigger;
+
+    auto& events = LifecycleComponent::events;
+
+    events.clear();
+
+    sss::extsystem::ComponentLoader loader;
+    loader.AddStaticComponents();
+    loader.LoadComponents();
+
+    // 所有生命周期组件都是延迟组件
+    CHECK(events.isEmpty());
+
+    QObject::connect(&loader, &sss::extsystem::ComponentLoader::ComponentsActivated,
+                     [&events](const QList<sss::extsystem::Component*>& components) {
+                       QStringList names;
+
+                       for (auto* component : components) {
+                         names.append(component->Name());
+                       }
+
+                       events.append("Activated " + names.join(","));
+                     });
+
+    // 第一次处理事件发生在等待 LifecycleBase 的异步初始化期间，此时到达的激活请求必须推迟到本次加载结束之后
+    QTimer::singleShot(0, &loader,
+                       [&loader]() { loader.ActivateTrigger(ActivationTrigger::kMode, "tests.lifecycle.late"); });
+
+    REQUIRE(loader.ActivateTrigger(ActivationTrigger::kMode, "tests.lifecycle.top"));
+
+    CHECK(events == QStringList{"Initialise LifecycleBase", "AsyncFinished LifecycleBase",
+                                "Initialise LifecycleMiddle", "Initialise LifecycleTop",
+                                "InitialisationFinished LifecycleTop", "InitialisationFinished LifecycleMiddle",
+                                "InitialisationFinished LifecycleBase",
+                                "Activated LifecycleBase,LifecycleMiddle,LifecycleTop"});
+
+    events.clear();
+
+    QElapsedTimer timer;
+
+    timer.start();
+
+    while (!events.contains("Activated LifecycleLate") && timer.elapsed() < 5000) {
+      QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+
+    CHECK(events == QStringList{"Initialise LifecycleLate", "InitialisationFinished LifecycleLate",
+                                "Activated LifecycleLate"});
+
+    events.clear();
+
+    loader.UnloadComponents();
+
+    CHECK(events == QStringList{"Finalise LifecycleLate", "Finalise LifecycleTop", "Finalise LifecycleMiddle",
+                                "Finalise LifecycleBase"});
+  }
+}
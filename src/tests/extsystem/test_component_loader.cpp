@@ -1,11 +1,17 @@
 #include <doctest/doctest.h>
 #include <extsystem/Component.h>
 #include <extsystem/ComponentLoader.h>
+#include <extsystem/IComponent.h>
 
 #include <QCoreApplication>
 #include <QDir>
 #include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
 #include <QPluginLoader>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
 #include <QTemporaryDir>
 
 TEST_SUITE("ComponentLoader") {
@@ -70,4 +76,52 @@ TEST_SUITE("ComponentLoader") {
     // 因此，Components() 应该为空。
     CHECK(loader.Components().isEmpty());
   }
+
+  TEST_CASE("Activation triggers are read from metadata") {
+    QJsonObject activation{{"Modes", QJsonArray{"lazy.mode"}}, {"Commands", QJsonArray{"lazy.open", "lazy.save"}}};
+    QJsonObject lazy_metadata{{"MetaData", QJsonObject{{"Name", "lazy"}, {"Activation", activation}}}};
+    QJsonObject eager_metadata{{"MetaData", QJsonObject{{"Name", "eager"}}}};
+
+    sss::extsystem::Component lazy_component("lazy", "liblazy.so", lazy_metadata);
+    sss::extsystem::Component eager_component("eager", "libeager.so", eager_metadata);
+
+    CHECK(lazy_component.IsLazy());
+    CHECK(lazy_component.ActivationTriggers(sss::extsystem::ComponentLoader::ActivationTrigger::kMode) ==
+          QStringList{"lazy.mode"});
+    CHECK(lazy_component.ActivationTriggers(sss::extsystem::ComponentLoader::ActivationTrigger::kCommand) ==
+          QStringList{"lazy.open", "lazy.save"});
+    CHECK(lazy_component.ActivationTriggers(sss::extsystem::ComponentLoader::ActivationTrigger::kContext).isEmpty());
+
+    CHECK_FALSE(eager_component.IsLazy());
+  }
+
+  TEST_CASE("Unknown activation triggers do nothing") {
+    sss::extsystem::ComponentLoader loader;
+    loader.LoadComponents();
+
+    CHECK(loader.PendingTriggers(sss::extsystem::ComponentLoader::ActivationTrigger::kMode).isEmpty());
+    CHECK_FALSE(loader.ActivateTrigger(sss::extsystem::ComponentLoader::ActivationTrigger::kMode, "missing.mode"));
+  }
+
+  TEST_CASE("RunOnMainThread marshals work from a worker thread") {
+    QThread* worker_thread = nullptr;
+    QThread* executing_thread = nullptr;
+    bool finished = false;
+
+    QThreadPool thread_pool;
+    thread_pool.start(QRunnable::create([&]() {
+      worker_thread = QThread::currentThread();
+      sss::extsystem::RunOnMainThread([&]() { executing_thread = QThread::currentThread(); });
+      sss::extsystem::RunOnMainThread([&]() { finished = true; });
+    }));
+
+    while (!finished) {
+      QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+    }
+
+    thread_pool.waitForDone();
+
+    CHECK(worker_thread != QCoreApplication::instance()->thread());
+    CHECK(executing_thread == QCoreApplication::instance()->thread());
+  }
 }
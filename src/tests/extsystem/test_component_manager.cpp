@@ -170,4 +170,71 @@ TEST_SUITE("IComponentManager") {
     delete widget_obj1;
     delete widget_obj2;
   }
+
+  TEST_CASE("Typed index is maintained incrementally") {
+    sss::extsystem::IComponentManager* manager = sss::extsystem::IComponentManager::GetInstance();
+    // 清除之前的状态
+    QList<QObject*> current_objects = manager->AllObjects();
+    for (QObject* obj : current_objects) {
+      manager->RemoveObject(obj);
+    }
+
+    // 首次查询建立空索引
+    CHECK(sss::extsystem::GetTObject<ITestService>() == nullptr);
+    CHECK(sss::extsystem::GetTObjects<MyCustomObject>().isEmpty());
+
+    auto* service1 = new TestServiceObject(nullptr);
+    auto* service2 = new TestServiceObject(nullptr);
+    auto* custom_obj = new MyCustomObject(nullptr);
+
+    manager->AddObject(service1);
+    manager->AddObject(custom_obj);
+    manager->AddObject(service2);
+
+    // 索引建立后添加的对象也能按接口和类查到，并保持注册顺序
+    CHECK(sss::extsystem::GetTObject<ITestService>() == qobject_cast<ITestService*>(service1));
+    CHECK(sss::extsystem::GetTObjects<ITestService>() ==
+          QList<ITestService*>{qobject_cast<ITestService*>(service1), qobject_cast<ITestService*>(service2)});
+    CHECK(sss::extsystem::GetTObject<MyCustomObject>() == custom_obj);
+    CHECK(sss::extsystem::GetTObjects<QObject>().size() == 3);
+
+    manager->RemoveObject(service1);
+    CHECK(sss::extsystem::GetTObject<ITestService>() == qobject_cast<ITestService*>(service2));
+    CHECK(sss::extsystem::GetTObjects<QObject>().size() == 2);
+
+    manager->RemoveObject(service2);
+    manager->RemoveObject(custom_obj);
+    CHECK(sss::extsystem::GetTObject<ITestService>() == nullptr);
+    CHECK(sss::extsystem::GetTObject<MyCustomObject>() == nullptr);
+
+    delete service1;
+    delete service2;
+    delete custom_obj;
+  }
+
+  TEST_CASE("Typed lists are unaffected by later registry changes") {
+    sss::extsystem::IComponentManager* manager = sss::extsystem::IComponentManager::GetInstance();
+    // 清除之前的状态
+    QList<QObject*> current_objects = manager->AllObjects();
+    for (QObject* obj : current_objects) {
+      manager->RemoveObject(obj);
+    }
+
+    TestServiceObject service;
+
+    manager->AddObject(&service);
+
+    auto typed_objects = manager->TypedObjects(sss::extsystem::TypeKey<ITestService>());
+
+    // 之后的修改发布新的快照，旧快照被释放后已返回的列表仍然有效
+    manager->RemoveObject(&service);
+
+    for (int round = 0; round < 100; round++) {
+      manager->AddObject(&service);
+      manager->RemoveObject(&service);
+    }
+
+    CHECK(typed_objects == QList<QObject*>{&service});
+    CHECK(manager->TypedObjects(sss::extsystem::TypeKey<ITestService>()).isEmpty());
+  }
 }
@@ -0,0 +1,102 @@
+#include <doctest/doctest.h>
+#include <extsystem/IComponentManager.h>
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QSet>
+#include <QThread>
+#include <memory>
+#include <vector>
+
+#include "test_classes.h"
+
+namespace {
+constexpr int kReaderThreads = 8;
+constexpr int kServiceCount = 32;
+constexpr int kRounds = 200;
+}  // namespace
+
+TEST_SUITE("IComponentManager Stress") {
+  TEST_CASE("Concurrent readers see consistent snapshots while components register and unregister") {
+    sss::extsystem::IComponentManager* manager = sss::extsystem::IComponentManager::GetInstance();
+    // 清除之前的状态
+    QList<QObject*> current_objects = manager->AllObjects();
+    for (QObject* obj : current_objects) {
+      manager->RemoveObject(obj);
+    }
+
+    // 服务对象在读者线程结束之前一直存活，读者可能仍持有它们的指针
+    std::vector<std::unique_ptr<TestServiceObject>> services;
+    QSet<ITestService*> known_services;
+
+    for (int index = 0; index < kServiceCount; index++) {
+      services.push_back(std::make_unique<TestServiceObject>());
+      known_services.insert(qobject_cast<ITestService*>(services.back().get()));
+    }
+
+    QAtomicInt stop(0);
+    QAtomicInt lookups(0);
+    QAtomicInt errors(0);
+
+    std::vector<std::unique_ptr<QThread>> readers;
+
+    for (int reader = 0; reader < kReaderThreads; reader++) {
+      readers.emplace_back(QThread::create([&]() {
+        while (stop.loadAcquire() == 0) {
+          auto typed_services = sss::extsystem::GetTObjects<ITestService>();
+
+          if (typed_services.size() > kServiceCount) {
+            errors.ref();
+          }
+
+          for (auto* service : typed_services) {
+            if (service == nullptr || !known_services.contains(service)) {
+              errors.ref();
+            }
+          }
+
+          if (sss::extsystem::GetTObject<MyCustomObject>() != nullptr) {
+            errors.ref();
+          }
+
+          // 首次查询的类型由读者无锁地建立索引，与写者并发进行
+          auto type_key = QByteArray("tests.stress.unknown") + QByteArray::number(lookups.loadAcquire() % 64);
+
+          if (!manager->TypedObjects(type_key.constData()).isEmpty()) {
+            errors.ref();
+          }
+
+          lookups.ref();
+        }
+      }));
+      readers.back()->start();
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int round = 0; round < kRounds; round++) {
+      for (auto& service : services) {
+        manager->AddObject(service.get());
+      }
+
+      for (auto& service : services) {
+        manager->RemoveObject(service.get());
+      }
+    }
+
+    stop.storeRelease(1);
+
+    for (auto& reader : readers) {
+      reader->wait();
+    }
+
+    MESSAGE(kRounds * kServiceCount * 2 << " registry updates with " << kReaderThreads << " readers performing "
+                                        << lookups.loadAcquire() << " lookups in " << timer.elapsed() << "ms");
+
+    CHECK(errors.loadAcquire() == 0);
+    CHECK(lookups.loadAcquire() > 0);
+    CHECK(manager->AllObjects().isEmpty());
+  }
+}
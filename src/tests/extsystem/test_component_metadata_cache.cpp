@@ -0,0 +1,160 @@
+#include <doctest/doctest.h>
+
+#include <QDateTime>
+#include <QFile>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include "ComponentMetadataCache.h"
+
+namespace {
+auto WriteFile(const QString& filename, const QByteArray& content) -> void {
+  QFile file(filename);
+  REQUIRE(file.open(QIODevice::WriteOnly));
+  file.write(content);
+}
+}  // namespace
+
+TEST_SUITE("ComponentMetadataCache") {
+  TEST_CASE("Entries survive a save and load round trip") {
+    QTemporaryDir temp_dir;
+    REQUIRE(temp_dir.isValid());
+
+    auto library = temp_dir.filePath("libcached.so");
+    auto cache_filename = temp_dir.filePath("cache/componentCache.bin");
+    WriteFile(library, "library");
+
+    QJsonObject metadata{{"IID", "sss.IComponent/2.0"}, {"MetaData", QJsonObject{{"Name", "cached"}}}};
+
+    {
+      sss::extsystem::ComponentMetadataCache cache(cache_filename);
+      CHECK_FALSE(cache.Load());
+
+      sss::extsystem::ComponentMetadataCache::FileStamp stamp;
+      QJsonObject cached_metadata;
+      CHECK_FALSE(cache.Lookup(library, stamp, cached_metadata));
+      CHECK(stamp.IsValid());
+
+      cache.Insert(library, stamp, metadata);
+      CHECK(cache.Save());
+    }
+
+    sss::extsystem::ComponentMetadataCache cache(cache_filename);
+    REQUIRE(cache.Load());
+
+    sss::extsystem::ComponentMetadataCache::FileStamp stamp;
+    QJsonObject cached_metadata;
+    CHECK(cache.Lookup(library, stamp, cached_metadata));
+    CHECK(cached_metadata == metadata);
+    CHECK(cache.Hits() == 1);
+    CHECK(cache.Misses() == 0);
+  }
+
+  TEST_CASE("Parsed descriptors survive a save and load round trip") {
+    QTemporaryDir temp_dir;
+    REQUIRE(temp_dir.isValid());
+
+    auto library = temp_dir.filePath("libdescribed.so");
+    auto cache_filename = temp_dir.filePath("componentCache.bin");
+    WriteFile(library, "library");
+
+    sss::extsystem::ComponentMetadataCache::Record record;
+    record.descriptor = sss::extsystem::ComponentDescriptor::FromMetadata(
+        QJsonObject{{"Name", "described"}, {"Version", "1.2.0"}, {"Vendor", "3d-scantech.com"}});
+    record.qt_version = QT_VERSION;
+    record.debug_build = true;
+    record.has_descriptor = true;
+
+    {
+      sss::extsystem::ComponentMetadataCache cache(cache_filename);
+
+      sss::extsystem::ComponentMetadataCache::FileStamp stamp;
+      sss::extsystem::ComponentMetadataCache::Record cached_record;
+      CHECK_FALSE(cache.Lookup(library, stamp, cached_record));
+
+      cache.Insert(library, stamp, record);
+      CHECK(cache.Save());
+    }
+
+    sss::extsystem::ComponentMetadataCache cache(cache_filename);
+    REQUIRE(cache.Load());
+
+    sss::extsystem::ComponentMetadataCache::FileStamp stamp;
+    sss::extsystem::ComponentMetadataCache::Record cached_record;
+    REQUIRE(cache.Lookup(library, stamp, cached_record));
+    CHECK(cached_record.has_descriptor);
+    CHECK(cached_record.descriptor == record.descriptor);
+    CHECK(cached_record.qt_version == QT_VERSION);
+    CHECK(cached_record.debug_build);
+    CHECK(cached_record.metadata.isEmpty());
+  }
+
+  TEST_CASE("Changed files miss the cache") {
+    QTemporaryDir temp_dir;
+    REQUIRE(temp_dir.isValid());
+
+    auto library = temp_dir.filePath("libchanged.so");
+    WriteFile(library, "library");
+
+    sss::extsystem::ComponentMetadataCache cache(temp_dir.filePath("componentCache.bin"));
+
+    sss::extsystem::ComponentMetadataCache::FileStamp stamp;
+    QJsonObject cached_metadata;
+    CHECK_FALSE(cache.Lookup(library, stamp, cached_metadata));
+    cache.Insert(library, stamp, QJsonObject{{"IID", "sss.IComponent/2.0"}});
+    CHECK(cache.Lookup(library, stamp, cached_metadata));
+
+    // 大小变化后必须重新读取
+    WriteFile(library, "rebuilt library");
+    CHECK_FALSE(cache.Lookup(library, stamp, cached_metadata));
+
+    // 已删除的文件不会命中
+    QFile::remove(library);
+    CHECK_FALSE(cache.Lookup(library, stamp, cached_metadata));
+    CHECK_FALSE(stamp.IsValid());
+  }
+
+  TEST_CASE("Files rebuilt within the same second miss the cache") {
+    QTemporaryDir temp_dir;
+    REQUIRE(temp_dir.isValid());
+
+    auto library = temp_dir.filePath("librebuilt.so");
+    auto modified = QDateTime::fromSecsSinceEpoch(1700000000);
+    WriteFile(library, "library");
+
+    {
+      QFile file(library);
+      REQUIRE(file.open(QIODevice::ReadWrite));
+      REQUIRE(file.setFileTime(modified, QFileDevice::FileModificationTime));
+    }
+
+    sss::extsystem::ComponentMetadataCache cache(temp_dir.filePath("componentCache.bin"));
+
+    sss::extsystem::ComponentMetadataCache::FileStamp stamp;
+    QJsonObject cached_metadata;
+    CHECK_FALSE(cache.Lookup(library, stamp, cached_metadata));
+    cache.Insert(library, stamp, QJsonObject{{"IID", "sss.IComponent/2.0"}});
+
+    // 大小和秒数都不变，只有亚秒部分不同
+    WriteFile(library, "LIBRARY");
+
+    {
+      QFile file(library);
+      REQUIRE(file.open(QIODevice::ReadWrite));
+      REQUIRE(file.setFileTime(modified.addMSecs(500), QFileDevice::FileModificationTime));
+    }
+
+    CHECK_FALSE(cache.Lookup(library, stamp, cached_metadata));
+  }
+
+  TEST_CASE("Corrupt cache files are ignored") {
+    QTemporaryDir temp_dir;
+    REQUIRE(temp_dir.isValid());
+
+    auto cache_filename = temp_dir.filePath("componentCache.bin");
+    WriteFile(cache_filename, "not a cache");
+
+    sss::extsystem::ComponentMetadataCache cache(cache_filename);
+    CHECK_FALSE(cache.Load());
+  }
+}
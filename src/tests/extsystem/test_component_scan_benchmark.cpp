@@ -0,0 +1,104 @@
+#include <doctest/doctest.h>
+#include <extsystem/Component.h>
+#include <extsystem/ComponentLoader.h>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QLibrary>
+#include <QSet>
+#include <QTemporaryDir>
+
+#include "benchmark/BenchmarkGate.h"
+
+namespace {
+// 每个搜索根目录中的库数量
+constexpr int kLibraryCounts[] = {8, 32, 128};
+constexpr int kRootCount = 3;
+
+// 返回测试程序旁边 components 目录中的真实插件（如果已构建），否则返回空列表
+auto RealPlugins() -> QStringList {
+  QStringList plugins;
+  QDir components_dir(QCoreApplication::applicationDirPath() + "/components");
+
+  for (const auto& entry : components_dir.entryInfoList(QDir::Files)) {
+    if (QLibrary::isLibrary(entry.absoluteFilePath())) {
+      plugins.append(entry.absoluteFilePath());
+    }
+  }
+
+  return plugins;
+}
+
+// 在 root 中创建 count 个库文件：优先复制真实插件，否则写入不含元数据的伪库文件
+auto PopulateRoot(const QString& root, int count, const QStringList& plugins) -> void {
+  QDir().mkpath(root);
+
+  for (int index = 0; index < count; index++) {
+    auto target = QString("%1/libbench_%2.so").arg(root).arg(index);
+
+    if (!plugins.isEmpty()) {
+      QFile::copy(plugins.at(index % plugins.size()), target);
+      continue;
+    }
+
+    QFile file(target);
+    if (file.open(QIODevice::WriteOnly)) {
+      file.write(QByteArray(4096, 'x'));
+    }
+  }
+}
+
+auto ComponentKeys(sss::extsystem::ComponentLoader& loader) -> QSet<QString> {
+  QSet<QString> keys;
+
+  for (auto* component : loader.Components()) {
+    keys.insert(QString("%1|%2|%3").arg(component->Name(), component->Filename()).arg(component->LoadStatus()));
+  }
+
+  return keys;
+}
+}  // namespace
+
+TEST_SUITE("ComponentLoader Benchmark") {
+  TEST_CASE("Parallel metadata scan matches serial scan and scales with library count") {
+    if (!BenchmarksEnabled()) {
+      return;
+    }
+
+    auto plugins = RealPlugins();
+
+    MESSAGE("Using " << (plugins.isEmpty() ? "dummy libraries" : "copies of built plugins") << " for the scan");
+
+    for (auto count : kLibraryCounts) {
+      QTemporaryDir temp_dir;
+      REQUIRE(temp_dir.isValid());
+
+      QStringList roots;
+      for (int root_index = 0; root_index < kRootCount; root_index++) {
+        roots.append(temp_dir.filePath(QString("root%1").arg(root_index)));
+        PopulateRoot(roots.last(), count, plugins);
+      }
+
+      QElapsedTimer timer;
+
+      sss::extsystem::ComponentLoader serial_loader;
+      timer.start();
+      for (const auto& root : roots) {
+        serial_loader.AddComponents(root);
+      }
+      auto serial_ms = timer.elapsed();
+
+      sss::extsystem::ComponentLoader parallel_loader;
+      timer.restart();
+      parallel_loader.AddComponents(roots);
+      auto parallel_ms = timer.elapsed();
+
+      MESSAGE(kRootCount * count << " libraries: serial " << serial_ms << "ms, parallel " << parallel_ms << "ms");
+
+      // 合并顺序确定，因此两种模式得到的组件（包括名称冲突标志）完全一致
+      CHECK(ComponentKeys(serial_loader) == ComponentKeys(parallel_loader));
+    }
+  }
+}
@@ -0,0 +1,142 @@
+#include <doctest/doctest.h>
+#include <extsystem/Component.h>
+#include <extsystem/ComponentLoader.h>
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <algorithm>
+
+#include "DependencyResolver.h"
+#include "benchmark/BenchmarkGate.h"
+#include "test_classes.h"
+
+namespace {
+auto RawPointers(const std::vector<std::unique_ptr<sss::extsystem::Component>>& components)
+    -> QList<sss::extsystem::Component*> {
+  QList<sss::extsystem::Component*> pointers;
+
+  for (const auto& component : components) {
+    pointers.append(component.get());
+  }
+
+  return pointers;
+}
+
+// 检查每个组件都排在其所有依赖项之后
+auto DependenciesComeFirst(const QList<sss::extsystem::Component*>& resolved_list,
+                           const std::vector<std::unique_ptr<sss::extsystem::Component>>& components, int fan_out)
+    -> bool {
+  QHash<QString, int> positions;
+
+  for (int index = 0; index < resolved_list.size(); index++) {
+    positions.insert(resolved_list.at(index)->Name(), index);
+  }
+
+  for (int index = 0; index < static_cast<int>(components.size()); index++) {
+    for (int edge = 1; edge <= fan_out && edge * 7 <= index; edge++) {
+      auto dependency_name = components.at(index - edge * 7)->Name();
+
+      if (positions.value(dependency_name, -1) > positions.value(components.at(index)->Name(), -1)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+}  // namespace
+
+TEST_SUITE("DependencyResolver") {
+  TEST_CASE("Dependencies are resolved before dependents") {
+    auto core = MakeSyntheticComponent("core");
+    auto ui = MakeSyntheticComponent("ui");
+    auto app = MakeSyntheticComponent("app");
+
+    ui->AddDependency(core.get(), QVersionNumber(1, 0, 0));
+    app->AddDependency(ui.get(), QVersionNumber(1, 0, 0));
+    app->AddDependency(core.get(), QVersionNumber(1, 0, 0));
+
+    auto resolved_list = sss::extsystem::DependencyResolver::Resolve({app.get(), core.get(), ui.get()});
+
+    REQUIRE(resolved_list.size() == 3);
+    CHECK(resolved_list.at(0) == core.get());
+    CHECK(resolved_list.at(1) == ui.get());
+    CHECK(resolved_list.at(2) == app.get());
+  }
+
+  TEST_CASE("Every member of a cycle is flagged") {
+    auto first = MakeSyntheticComponent("first");
+    auto second = MakeSyntheticComponent("second");
+    auto third = MakeSyntheticComponent("third");
+    auto dependent = MakeSyntheticComponent("dependent");
+    auto independent = MakeSyntheticComponent("independent");
+
+    first->AddDependency(second.get(), QVersionNumber(1));
+    second->AddDependency(third.get(), QVersionNumber(1));
+    third->AddDependency(first.get(), QVersionNumber(1));
+    dependent->AddDependency(first.get(), QVersionNumber(1));
+
+    auto resolved_list = sss::extsystem::DependencyResolver::Resolve(
+        {dependent.get(), first.get(), second.get(), third.get(), independent.get()});
+
+    for (auto* member : {first.get(), second.get(), third.get()}) {
+      CHECK(member->LoadStatus() & sss::extsystem::ComponentLoader::kCircularDependency);
+      CHECK_FALSE(resolved_list.contains(member));
+    }
+
+    // 依赖循环的组件仍然参与排序，在加载时因依赖项未加载而失败
+    CHECK(resolved_list == QList<sss::extsystem::Component*>{dependent.get(), independent.get()});
+    CHECK(dependent->LoadStatus() == 0);
+  }
+
+  TEST_CASE("Self dependencies are cycles") {
+    auto component = MakeSyntheticComponent("self");
+    component->AddDependency(component.get(), QVersionNumber(1));
+
+    CHECK(sss::extsystem::DependencyResolver::Resolve({component.get()}).isEmpty());
+    CHECK(component->LoadStatus() & sss::extsystem::ComponentLoader::kCircularDependency);
+  }
+
+  TEST_CASE("Version constraints are checked during resolution") {
+    auto core = MakeSyntheticComponent("core", "1.2.0");
+    auto satisfied = MakeSyntheticComponent("satisfied");
+    auto unsatisfied = MakeSyntheticComponent("unsatisfied");
+
+    satisfied->AddDependency(core.get(), QVersionNumber(1, 1));
+    unsatisfied->AddDependency(core.get(), QVersionNumber(2, 0));
+
+    sss::extsystem::DependencyResolver::Resolve({core.get(), satisfied.get(), unsatisfied.get()});
+
+    CHECK(satisfied->LoadStatus() == 0);
+    CHECK(unsatisfied->LoadStatus() & sss::extsystem::ComponentLoader::kIncompatibleVersion);
+  }
+}
+
+TEST_SUITE("DependencyResolver Benchmark") {
+  TEST_CASE("Resolve 10k synthetic components") {
+    if (!BenchmarksEnabled()) {
+      return;
+    }
+
+    constexpr int kComponentCount = 10000;
+
+    for (auto fan_out : {1, 4}) {
+      auto components = MakeSyntheticComponentGraph(kComponentCount, fan_out);
+      auto component_list = RawPointers(components);
+
+      // 以逆序作为遍历起点，使深度优先遍历必须沿着最长的依赖链下降
+      std::reverse(component_list.begin(), component_list.end());
+
+      QElapsedTimer timer;
+      timer.start();
+
+      auto resolved_list = sss::extsystem::DependencyResolver::Resolve(component_list);
+
+      MESSAGE(kComponentCount << " components with fan-out " << fan_out << " resolved in " << timer.elapsed()
+                              << "ms");
+
+      CHECK(resolved_list.size() == kComponentCount);
+      CHECK(DependenciesComeFirst(resolved_list, components, fan_out));
+    }
+  }
+}
@@ -0,0 +1,146 @@
+#include <doctest/doctest.h>
+#include <extsystem/ComponentLoader.h>
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStringList>
+#include <QThread>
+#include <QtPlugin>
+#include <atomic>
+#include <memory>
+
+#include "shutdown/shutdown_component.h"
+
+// ShutdownFirst 和 ShutdownSecond 依赖 ShutdownBase，三个组件都声明了 "FinaliseOnExit"
+Q_IMPORT_PLUGIN(ShutdownBaseComponent)
+Q_IMPORT_PLUGIN(ShutdownFirstComponent)
+Q_IMPORT_PLUGIN(ShutdownSecondComponent)
+
+namespace {
+// 激活所有快速关闭测试组件，然后按快速关闭策略卸载
+auto FastUnload(int finalise_timeout) -> void {
+  sss::extsystem::ComponentLoader loader;
+  loader.AddStaticComponents();
+  loader.LoadComponents();
+
+  REQUIRE(loader.ActivateTrigger(sss::extsystem::ComponentLoader::ActivationTrigger::kMode, "tests.shutdown"));
+
+  loader.SetShutdownPolicy(sss::extsystem::ComponentLoader::ShutdownPolicy::kFast, finalise_timeout);
+  loader.UnloadComponents();
+}
+
+// 在 timeout 毫秒内等待 condition 成立
+template <typename Condition>
+auto WaitFor(Condition condition, int timeout) -> bool {
+  QElapsedTimer timer;
+  timer.start();
+
+  while (!condition()) {
+    if (timer.elapsed() >= timeout) {
+      return false;
+    }
+
+    QThread::msleep(1);
+  }
+
+  return true;
+}
+}  // namespace
+
+TEST_SUITE("ComponentLoader") {
+  TEST_CASE("Fast shutdown finalises the components of one level in parallel") {
+    if (QThread::idealThreadCount() < 2) {
+      MESSAGE("A single processor is available, skipping the parallel finalise check");
+      return;
+    }
+
+    std::atomic<int> started_count{0};
+    std::atomic<int> overlapped_count{0};
+
+    ShutdownComponent::finalise = [&](const QString& name) {
+      if (name == "ShutdownBase") {
+        return;
+      }
+
+      started_count++;
+
+      // 只有两个组件同时运行时才能都看到对方已经开始
+      if (WaitFor([&]() { return started_count.load() == 2; }, 2000)) {
+        overlapped_count++;
+      }
+    };
+
+    FastUnload(5000);
+
+    ShutdownComponent::finalise = nullptr;
+
+    CHECK(started_count.load() == 2);
+    CHECK(overlapped_count.load() == 2);
+  }
+
+  TEST_CASE("Fast shutdown finalises dependent components before their dependencies") {
+    QMutex mutex;
+    QStringList events;
+
+    ShutdownComponent::finalise = [&](const QString& name) {
+      QMutexLocker locker(&mutex);
+
+      events.append(name);
+    };
+
+    FastUnload(5000);
+
+    ShutdownComponent::finalise = nullptr;
+
+    REQUIRE(events.size() == 3);
+    CHECK(events.mid(0, 2).contains("ShutdownFirst"));
+    CHECK(events.mid(0, 2).contains("ShutdownSecond"));
+    CHECK(events.last() == "ShutdownBase");
+  }
+
+  TEST_CASE("Fast shutdown skips the levels below a level that timed out") {
+    struct State {
+      QMutex mutex;
+      QStringList events;
+      std::atomic<bool> released{false};
+      std::atomic<bool> finished{false};
+    };
+
+    // 超时后 ShutdownFirst 仍在线程池中运行，状态由回调共享
+    auto state = std::make_shared<State>();
+
+    ShutdownComponent::finalise = [state](const QString& name) {
+      if (name == "ShutdownFirst") {
+        WaitFor([&state]() { return state->released.load(); }, 5000);
+        state->finished.store(true);
+
+        return;
+      }
+
+      QMutexLocker locker(&state->mutex);
+
+      state->events.append(name);
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+
+    FastUnload(100);
+
+    CHECK(timer.elapsed() < 5000);
+
+    ShutdownComponent::finalise = nullptr;
+
+    {
+      QMutexLocker locker(&state->mutex);
+
+      // ShutdownSecond 与超时的 ShutdownFirst 位于同一层级，只有多个工作线程时才在超时前结束
+      CHECK_FALSE(state->events.contains("ShutdownBase"));
+    }
+
+    state->released.store(true);
+
+    CHECK(WaitFor([&state]() { return state->finished.load(); }, 5000));
+  }
+}
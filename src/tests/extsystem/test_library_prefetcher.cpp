@@ -0,0 +1,182 @@
+#include <doctest/doctest.h>
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtGlobal>
+#include <vector>
+
+#include "LibraryPrefetcher.h"
+
+#if defined(Q_OS_LINUX)
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+// 返回文件在页缓存中的页数和总页数
+auto ResidentPages(const QString& filename, size_t& page_count) -> size_t {
+  auto file_descriptor = ::open(QFile::encodeName(filename).constData(), O_RDONLY | O_CLOEXEC);
+  auto file_size = static_cast<size_t>(QFile(filename).size());
+  auto page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+  page_count = (file_size + page_size - 1) / page_size;
+
+  auto* mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, file_descriptor, 0);
+
+  ::close(file_descriptor);
+
+  if (mapping == MAP_FAILED) {
+    return 0;
+  }
+
+  std::vector<unsigned char> residency(page_count);
+
+  ::mincore(mapping, file_size, residency.data());
+  ::munmap(mapping, file_size);
+
+  size_t resident_count = 0;
+
+  for (auto page : residency) {
+    resident_count += (page & 1);
+  }
+
+  return resident_count;
+}
+
+// 把文件写回磁盘并从页缓存中丢弃
+auto EvictFromPageCache(const QString& filename) -> void {
+  auto file_descriptor = ::open(QFile::encodeName(filename).constData(), O_RDONLY | O_CLOEXEC);
+
+  ::fdatasync(file_descriptor);
+  ::posix_fadvise(file_descriptor, 0, 0, POSIX_FADV_DONTNEED);
+  ::close(file_descriptor);
+}
+
+// 返回库是否已在进程中打开，RTLD_NOLOAD 不会打开未加载的库
+auto IsLibraryLoaded(const QString& filename) -> bool {
+  auto* handle = ::dlopen(QFile::encodeName(filename).constData(), RTLD_NOW | RTLD_NOLOAD);
+
+  if (handle == nullptr) {
+    return false;
+  }
+
+  ::dlclose(handle);
+
+  return true;
+}
+}  // namespace
+#endif
+
+TEST_SUITE("LibraryPrefetcher") {
+  TEST_CASE("Files outside the prefetch list cannot be claimed") {
+    sss::extsystem::LibraryPrefetcher prefetcher(QStringList{});
+
+    prefetcher.Start();
+
+    CHECK_FALSE(prefetcher.Claim("missing-library"));
+  }
+
+  TEST_CASE("Files are claimed once in any order") {
+    QTemporaryDir folder;
+
+    REQUIRE(folder.isValid());
+
+    QStringList filenames;
+
+    for (auto index = 0; index < 3; index++) {
+      auto filename = folder.filePath(QString("not_a_library%1.so").arg(index));
+      QFile file(filename);
+
+      REQUIRE(file.open(QIODevice::WriteOnly));
+      file.write("not a shared library");
+
+      filenames.append(filename);
+    }
+
+    sss::extsystem::LibraryPrefetcher prefetcher(filenames);
+
+    prefetcher.Start();
+
+    for (auto index = filenames.size() - 1; index >= 0; index--) {
+      CHECK(prefetcher.Claim(filenames.at(index)));
+    }
+
+    // 每个文件只能标记一次
+    CHECK_FALSE(prefetcher.Claim(filenames.first()));
+  }
+
+  TEST_CASE("Unclaimed files are left untouched on destruction") {
+    QTemporaryDir folder;
+
+    REQUIRE(folder.isValid());
+
+    auto filename = folder.filePath("not_a_library.so");
+    QFile file(filename);
+
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    file.write("not a shared library");
+    file.close();
+
+    {
+      sss::extsystem::LibraryPrefetcher prefetcher(QStringList{filename});
+
+      prefetcher.Start();
+    }
+
+    CHECK(QFile::exists(filename));
+  }
+
+#if defined(Q_OS_LINUX)
+  TEST_CASE("Prefetched files are read into the page cache") {
+    QTemporaryDir folder;
+
+    REQUIRE(folder.isValid());
+
+    auto filename = folder.filePath("not_a_library.so");
+    QFile file(filename);
+
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    file.write(QByteArray(1024 * 1024, 'x'));
+    file.close();
+
+    size_t page_count = 0;
+
+    EvictFromPageCache(filename);
+
+    // tmpfs 等没有后备存储的文件系统无法丢弃页面
+    if (ResidentPages(filename, page_count) == page_count) {
+      MESSAGE("The temporary folder cannot be evicted from the page cache, skipping the residency check");
+      return;
+    }
+
+    sss::extsystem::LibraryPrefetcher prefetcher(QStringList{filename});
+
+    prefetcher.Start();
+    prefetcher.Wait();
+
+    CHECK(ResidentPages(filename, page_count) == page_count);
+  }
+
+#if defined(DS_RUNTIME_INSTALL_PLUGIN)
+  TEST_CASE("Prefetched libraries are opened before the main thread loads them") {
+    QTemporaryDir folder;
+
+    REQUIRE(folder.isValid());
+
+    // 复制到新路径，使库在本测试之前一定没有被打开
+    auto filename = folder.filePath("prefetched_plugin.so");
+
+    REQUIRE(QFile::copy(DS_RUNTIME_INSTALL_PLUGIN, filename));
+    REQUIRE_FALSE(IsLibraryLoaded(filename));
+
+    sss::extsystem::LibraryPrefetcher prefetcher(QStringList{filename});
+
+    prefetcher.Start();
+    prefetcher.Wait();
+
+    CHECK(IsLibraryLoaded(filename));
+  }
+#endif
+#endif
+}
@@ -0,0 +1,181 @@
+#include <doctest/doctest.h>
+#include <extsystem/Component.h>
+#include <extsystem/ComponentLoader.h>
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtGlobal>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#if defined(Q_OS_WIN)
+// clang-format off
+#include <windows.h>
+#include <psapi.h>
+// clang-format on
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+namespace {
+// 生命周期的各个阶段，按执行顺序排列
+constexpr const char* kPhases[] = {"add_components_ms", "load_components_ms", "unload_components_ms"};
+
+// 生成插件的参数及其环境变量，基线按全部参数分别保存
+constexpr const char* kParameters[][2] = {{"fan_out", "DS_LOADER_BENCHMARK_FAN_OUT"},
+                                          {"fan_in", "DS_LOADER_BENCHMARK_FAN_IN"},
+                                          {"metadata_bytes", "DS_LOADER_BENCHMARK_METADATA_BYTES"},
+                                          {"init_cost_us", "DS_LOADER_BENCHMARK_INIT_COST_US"}};
+
+// 返回进程的峰值常驻内存（KB）
+auto PeakRssKb() -> qint64 {
+#if defined(Q_OS_WIN)
+  PROCESS_MEMORY_COUNTERS counters{};
+
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return static_cast<qint64>(counters.PeakWorkingSetSize / 1024);
+  }
+
+  return -1;
+#elif defined(Q_OS_UNIX)
+  struct rusage usage {};
+
+  getrusage(RUSAGE_SELF, &usage);
+
+#if defined(Q_OS_MACOS)
+  return static_cast<qint64>(usage.ru_maxrss / 1024);
+#else
+  return static_cast<qint64>(usage.ru_maxrss);
+#endif
+#else
+  return -1;
+#endif
+}
+
+auto Median(std::vector<double> values) -> double {
+  std::sort(values.begin(), values.end());
+
+  return values.empty() ? 0.0 : values.at(values.size() / 2);
+}
+
+auto ElapsedMs(const QElapsedTimer& timer) -> double { return static_cast<double>(timer.nsecsElapsed()) / 1e6; }
+}  // namespace
+
+// 由 run_loader_benchmark 目标驱动（见 benchmark/loader_benchmark.cmake），未设置插件目录时跳过
+TEST_SUITE("ComponentLoader Lifecycle Benchmark") {
+  TEST_CASE("Generated plugins go through the full loader lifecycle") {
+    auto plugin_dir = qEnvironmentVariable("DS_LOADER_BENCHMARK_DIR");
+
+    if (plugin_dir.isEmpty()) {
+      MESSAGE("DS_LOADER_BENCHMARK_DIR is not set, build the run_loader_benchmark target to run this benchmark");
+      return;
+    }
+
+    auto iterations = qMax(1, qEnvironmentVariableIntValue("DS_LOADER_BENCHMARK_ITERATIONS"));
+    std::vector<double> phase_timings[std::size(kPhases)];
+    auto component_count = 0;
+    auto loaded_count = 0;
+
+    for (int iteration = 0; iteration < iterations; iteration++) {
+      sss::extsystem::ComponentLoader loader;
+      QElapsedTimer timer;
+
+      timer.start();
+      loader.AddComponents(QStringList{plugin_dir});
+      phase_timings[0].push_back(ElapsedMs(timer));
+
+      timer.restart();
+      loader.LoadComponents();
+      phase_timings[1].push_back(ElapsedMs(timer));
+
+      auto components = loader.Components();
+
+      component_count = static_cast<int>(components.size());
+      loaded_count = static_cast<int>(std::count_if(components.cbegin(), components.cend(),
+                                                    [](sss::extsystem::Component* component) {
+                                                      return component->IsLoaded();
+                                                    }));
+
+      timer.restart();
+      loader.UnloadComponents();
+      phase_timings[2].push_back(ElapsedMs(timer));
+    }
+
+    REQUIRE(component_count > 0);
+    CHECK(loaded_count == component_count);
+
+    QJsonObject results{{"components", component_count}, {"iterations", iterations}, {"peak_rss_kb", PeakRssKb()}};
+    auto baseline_key = QString("components=%1").arg(component_count);
+
+    for (const auto& parameter : kParameters) {
+      auto value = qEnvironmentVariableIntValue(parameter[1]);
+
+      results.insert(parameter[0], value);
+      baseline_key += QString(",%1=%2").arg(parameter[0]).arg(value);
+    }
+
+    for (size_t phase = 0; phase < std::size(kPhases); phase++) {
+      results.insert(kPhases[phase], Median(phase_timings[phase]));
+    }
+
+    auto results_json = QJsonDocument(results).toJson(QJsonDocument::Compact);
+
+    MESSAGE(results_json.toStdString());
+
+    auto output_filename = qEnvironmentVariable("DS_LOADER_BENCHMARK_OUTPUT");
+
+    if (!output_filename.isEmpty()) {
+      QFile output_file(output_filename);
+
+      if (output_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        output_file.write(results_json);
+      }
+    }
+
+    // 基线文件以参数组合为键保存各组参数的结果，只在显式请求时写入
+
+    auto baseline_filename = qEnvironmentVariable("DS_LOADER_BENCHMARK_BASELINE");
+
+    if (baseline_filename.isEmpty()) {
+      return;
+    }
+
+    QFile baseline_file(baseline_filename);
+    QJsonObject baselines;
+
+    if (baseline_file.open(QIODevice::ReadOnly)) {
+      baselines = QJsonDocument::fromJson(baseline_file.readAll()).object();
+      baseline_file.close();
+    }
+
+    if (qEnvironmentVariableIsSet("DS_LOADER_BENCHMARK_UPDATE_BASELINE")) {
+      baselines.insert(baseline_key, results);
+
+      REQUIRE(baseline_file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+      baseline_file.write(QJsonDocument(baselines).toJson());
+
+      MESSAGE("Baseline for " << baseline_key.toStdString() << " written to " << baseline_filename.toStdString());
+      return;
+    }
+
+    if (!baselines.contains(baseline_key)) {
+      MESSAGE("No baseline for " << baseline_key.toStdString()
+                                 << ", build the update_loader_benchmark_baseline target to record one");
+      return;
+    }
+
+    auto baseline = baselines.value(baseline_key).toObject();
+    auto threshold = qEnvironmentVariable("DS_LOADER_BENCHMARK_THRESHOLD", "1.25").toDouble();
+
+    for (const auto* phase : kPhases) {
+      auto baseline_ms = baseline.value(phase).toDouble();
+      auto current_ms = results.value(phase).toDouble();
+
+      INFO(phase << ": " << current_ms << "ms, baseline " << baseline_ms << "ms, threshold " << threshold);
+      CHECK(current_ms <= baseline_ms * threshold);
+    }
+  }
+}
@@ -0,0 +1,58 @@
+#include <doctest/doctest.h>
+#include <extsystem/IComponentManager.h>
+#include <extsystem/ServiceTracker.h>
+
+#include <QList>
+
+#include "test_classes.h"
+
+TEST_SUITE("ServiceTracker") {
+  TEST_CASE("Tracker follows registrations and reports arrivals and departures") {
+    sss::extsystem::IComponentManager* manager = sss::extsystem::IComponentManager::GetInstance();
+    // 清除之前的状态
+    QList<QObject*> current_objects = manager->AllObjects();
+    for (QObject* obj : current_objects) {
+      manager->RemoveObject(obj);
+    }
+
+    auto* early_service = new TestServiceObject(nullptr);
+    manager->AddObject(early_service);
+
+    QList<ITestService*> added_services;
+    QList<ITestService*> removed_services;
+
+    sss::extsystem::ServiceTracker<ITestService> tracker(
+        [&added_services](ITestService* service) { added_services.append(service); },
+        [&removed_services](ITestService* service) { removed_services.append(service); });
+
+    // 构造时已存在的服务也会回调
+    CHECK(tracker.Get() == qobject_cast<ITestService*>(early_service));
+    CHECK(added_services == QList<ITestService*>{qobject_cast<ITestService*>(early_service)});
+
+    // 无关对象不会触发回调
+    auto* unrelated_obj = new MyCustomObject(nullptr);
+    manager->AddObject(unrelated_obj);
+    CHECK(added_services.size() == 1);
+
+    // 稍后到达的服务
+    auto* late_service = new TestServiceObject(nullptr);
+    manager->AddObject(late_service);
+    CHECK(added_services.size() == 2);
+    CHECK(tracker.Services().size() == 2);
+    CHECK(tracker.Get() == qobject_cast<ITestService*>(early_service));
+
+    // 第一个服务离开后，跟踪器切换到下一个
+    manager->RemoveObject(early_service);
+    CHECK(removed_services == QList<ITestService*>{qobject_cast<ITestService*>(early_service)});
+    CHECK(tracker.Get() == qobject_cast<ITestService*>(late_service));
+
+    manager->RemoveObject(late_service);
+    manager->RemoveObject(unrelated_obj);
+    CHECK_FALSE(tracker);
+    CHECK(removed_services.size() == 2);
+
+    delete early_service;
+    delete late_service;
+    delete unrelated_obj;
+  }
+}
@@ -0,0 +1,73 @@
+#include <doctest/doctest.h>
+#include <extsystem/StartupTrace.h>
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+TEST_SUITE("StartupTrace") {
+  TEST_CASE("Spans are ignored while tracing is disabled") {
+    CHECK_FALSE(sss::extsystem::StartupTrace::IsEnabled());
+
+    { sss::extsystem::StartupTrace::Span span("ignored", "test"); }
+
+    // 跟踪关闭时不生成名称和参数
+    auto details_called = false;
+
+    {
+      sss::extsystem::StartupTrace::Span span(
+          [&](QJsonObject&) {
+            details_called = true;
+            return QString("ignored");
+          },
+          "test");
+    }
+
+    CHECK_FALSE(details_called);
+
+    CHECK_FALSE(sss::extsystem::StartupTrace::Finish());
+  }
+
+  TEST_CASE("Finished traces are written as Chrome trace JSON") {
+    QTemporaryDir temp_dir;
+    REQUIRE(temp_dir.isValid());
+
+    auto trace_filename = temp_dir.filePath("startup.json");
+
+    sss::extsystem::StartupTrace::Start(trace_filename);
+    REQUIRE(sss::extsystem::StartupTrace::IsEnabled());
+
+    { sss::extsystem::StartupTrace::Span span("InitialiseEvent test", "init", QJsonObject{{"component", "test"}}); }
+    {
+      sss::extsystem::StartupTrace::Span span(
+          [](QJsonObject& args) {
+            args.insert("library", "libtest.so");
+            return QString("Load test");
+          },
+          "load");
+    }
+    sss::extsystem::StartupTrace::AddSpan("First window show", "ui", 0, 10);
+
+    REQUIRE(sss::extsystem::StartupTrace::Finish());
+    CHECK_FALSE(sss::extsystem::StartupTrace::IsEnabled());
+
+    QFile trace_file(trace_filename);
+    REQUIRE(trace_file.open(QIODevice::ReadOnly));
+
+    auto trace = QJsonDocument::fromJson(trace_file.readAll()).object();
+    QStringList span_names;
+
+    for (const auto& event : trace["traceEvents"].toArray()) {
+      auto event_object = event.toObject();
+
+      if (event_object["ph"].toString() == "X") {
+        span_names.append(event_object["name"].toString());
+        CHECK(event_object["dur"].toDouble() >= 0);
+      }
+    }
+
+    CHECK(span_names == QStringList{"InitialiseEvent test", "Load test", "First window show"});
+  }
+}
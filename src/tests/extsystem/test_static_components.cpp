@@ -0,0 +1,304 @@
+// 测试插件以 Qt 静态插件的形式编译进测试程序，moc 生成 qt_static_plugin_StaticTestComponent()
+#define QT_STATICPLUGIN
+
+#include <doctest/doctest.h>
+#include <extsystem/Component.h>
+#include <extsystem/ComponentLoader.h>
+#include <extsystem/IComponent.h>
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QFuture>
+#include <QFutureInterface>
+#include <QObject>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <QtPlugin>
+#include <algorithm>
+#include <vector>
+
+#include "benchmark/BenchmarkGate.h"
+
+class StaticTestComponent : public QObject, public sss::extsystem::IComponent {
+  Q_OBJECT
+  Q_PLUGIN_METADATA(IID SSSComponentInterfaceIID FILE "static_component.json")
+  Q_INTERFACES(sss::extsystem::IComponent)
+
+ public:
+  static inline int initialise_count = 0;
+  static inline int finalise_count = 0;
+  static inline bool initialise_async = false;
+  static inline bool async_finished = false;
+  static inline bool async_finished_before_initialisation_finished = false;
+
+  auto InitialiseEvent() -> void override { initialise_count++; }
+
+  auto InitialiseAsyncEvent() -> QFuture<void> override {
+    if (!initialise_async) {
+      return {};
+    }
+
+    QFutureInterface<void> future_interface;
+
+    future_interface.reportStarted();
+
+    // 只有组件加载器在等待期间处理事件时计时器才会触发
+    QTimer::singleShot(10, [future_interface]() mutable {
+      async_finished = true;
+      future_interface.reportFinished();
+    });
+
+    return future_interface.future();
+  }
+
+  auto InitialisationFinishedEvent() -> void override {
+    async_finished_before_initialisation_finished = async_finished;
+  }
+
+  auto FinaliseEvent() -> void override { finalise_count++; }
+};
+
+Q_IMPORT_PLUGIN(StaticTestComponent)
+Q_IMPORT_PLUGIN(UnnamedTestComponent)
+
+namespace {
+auto FindComponent(sss::extsystem::ComponentLoader& loader, const QString& name) -> sss::extsystem::Component* {
+  for (auto* component : loader.Components()) {
+    if (component->Name() == name) {
+      return component;
+    }
+  }
+
+  return nullptr;
+}
+}  // namespace
+
+TEST_SUITE("ComponentLoader") {
+  TEST_CASE("Static components go through the regular lifecycle") {
+    StaticTestComponent::initialise_count = 0;
+    StaticTestComponent::finalise_count = 0;
+
+    sss::extsystem::ComponentLoader loader;
+    loader.AddStaticComponents();
+
+    auto* component = FindComponent(loader, "StaticTestComponent");
+    REQUIRE(component != nullptr);
+    CHECK(component->Filename() == "static:StaticTestComponent");
+
+    loader.LoadComponents();
+
+    CHECK(component->IsLoaded());
+    CHECK(StaticTestComponent::initialise_count == 1);
+
+    loader.UnloadComponents();
+
+    CHECK(StaticTestComponent::finalise_count == 1);
+  }
+
+  TEST_CASE("Components without a name in their metadata are identified by their plugin class name") {
+    sss::extsystem::ComponentLoader loader;
+    loader.AddStaticComponents();
+
+    auto* component = FindComponent(loader, "UnnamedTestComponent");
+    REQUIRE(component != nullptr);
+    CHECK(component->Descriptor().Name() == "UnnamedTestComponent");
+    CHECK(component->Descriptor().Identifier() == "unnamedtestcomponent.3d-scantech.com");
+
+    // 与应用程序的 disabledComponents 设置相同，按标识符禁用组件
+    loader.LoadComponents([](sss::extsystem::Component* candidate) -> bool {
+      return candidate->Descriptor().Identifier() != "unnamedtestcomponent.3d-scantech.com";
+    });
+
+    CHECK_FALSE(loader.ActivateTrigger(sss::extsystem::ComponentLoader::ActivationTrigger::kMode, "tests.unnamed"));
+    CHECK_FALSE(component->IsLoaded());
+    CHECK((component->LoadStatus() & sss::extsystem::ComponentLoader::kDisabled) != 0);
+
+    loader.UnloadComponents();
+  }
+
+  TEST_CASE("Installing from a folder without new components leaves loaded components untouched") {
+    StaticTestComponent::initialise_count = 0;
+
+    QTemporaryDir temp_dir;
+    REQUIRE(temp_dir.isValid());
+
+    QFile file(temp_dir.filePath("not_a_component.so"));
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    file.write("This is not a real plugin.");
+    file.close();
+
+    sss::extsystem::ComponentLoader loader;
+    loader.AddStaticComponents();
+    loader.LoadComponents();
+
+    auto activated_count = 0;
+
+    QObject::connect(&loader, &sss::extsystem::ComponentLoader::ComponentsActivated,
+                     [&activated_count]() { activated_count++; });
+
+    CHECK(loader.InstallComponents(QStringList{temp_dir.path()}).isEmpty());
+    CHECK(loader.InstallComponents(QStringList{temp_dir.path()}).isEmpty());
+
+    CHECK(activated_count == 0);
+    CHECK(StaticTestComponent::initialise_count == 1);
+  }
+
+#if defined(DS_RUNTIME_INSTALL_PLUGIN)
+  TEST_CASE("Rejected libraries are not read again until they change") {
+    QTemporaryDir temp_dir;
+    REQUIRE(temp_dir.isValid());
+
+    auto filename = temp_dir.filePath(QFileInfo(DS_RUNTIME_INSTALL_PLUGIN).fileName());
+    REQUIRE(QFile::copy(DS_RUNTIME_INSTALL_PLUGIN, filename));
+
+    auto load_function_calls = 0;
+
+    sss::extsystem::ComponentLoader loader;
+    loader.LoadComponents([&load_function_calls](sss::extsystem::Component* component) -> bool {
+      if (component->Name() != "RuntimeInstall") {
+        return true;
+      }
+
+      load_function_calls++;
+
+      return false;
+    });
+
+    CHECK(loader.InstallComponents(QStringList{temp_dir.path()}).isEmpty());
+    CHECK(load_function_calls == 1);
+
+    // 文件夹变化但库没有变化时不再读取
+    CHECK(loader.InstallComponents(QStringList{temp_dir.path()}).isEmpty());
+    CHECK(load_function_calls == 1);
+
+    // 库文件变化后重新读取
+    QFile file(filename);
+    REQUIRE(file.open(QIODevice::Append));
+    file.write(QByteArray(1, '\0'));
+    file.close();
+
+    CHECK(loader.InstallComponents(QStringList{temp_dir.path()}).isEmpty());
+    CHECK(load_function_calls == 2);
+  }
+#endif
+
+  TEST_CASE("Fast shutdown skips finalisers that are not required on exit") {
+    StaticTestComponent::finalise_count = 0;
+
+    sss::extsystem::ComponentLoader loader;
+    loader.AddStaticComponents();
+    loader.LoadComponents();
+
+    auto* component = FindComponent(loader, "StaticTestComponent");
+    REQUIRE(component != nullptr);
+    CHECK_FALSE(component->FinalisesOnExit());
+
+    loader.SetShutdownPolicy(sss::extsystem::ComponentLoader::ShutdownPolicy::kFast, 1000);
+    loader.UnloadComponents();
+
+    CHECK(StaticTestComponent::finalise_count == 0);
+  }
+
+  TEST_CASE("Asynchronous initialisation is awaited while events are processed") {
+    StaticTestComponent::initialise_async = true;
+    StaticTestComponent::async_finished = false;
+    StaticTestComponent::async_finished_before_initialisation_finished = false;
+
+    sss::extsystem::ComponentLoader loader;
+    loader.AddStaticComponents();
+
+    QList<int> progress;
+
+    QObject::connect(&loader, &sss::extsystem::ComponentLoader::InitialisationProgress,
+                     [&progress](sss::extsystem::Component* component, int initialised_count, int total_count) {
+                       CHECK(component->Name() == "StaticTestComponent");
+                       CHECK(total_count == 1);
+
+                       progress.append(initialised_count);
+                     });
+
+    loader.LoadComponents();
+
+    CHECK(StaticTestComponent::async_finished);
+    CHECK(StaticTestComponent::async_finished_before_initialisation_finished);
+    CHECK(progress == QList<int>{1});
+
+    loader.UnloadComponents();
+
+    StaticTestComponent::initialise_async = false;
+  }
+}
+
+// 基准测试组件由 benchmark/static_benchmark.cmake 生成，同一组组件分别编译为静态插件和共享库插件
+TEST_SUITE("ComponentLoader Benchmark") {
+  TEST_CASE("Static components start faster than the same components loaded from libraries") {
+    if (!BenchmarksEnabled()) {
+      return;
+    }
+
+#if defined(DS_STATIC_BENCHMARK_DIR)
+    constexpr auto kIterations = 5;
+
+    // 与应用程序启动相同：先添加静态组件，再并行扫描组件文件夹，然后加载并激活组件
+    auto start_components = [](const QString& mode, const QStringList& component_folders, int& activated_count) {
+      sss::extsystem::ComponentLoader loader;
+      QElapsedTimer timer;
+
+      timer.start();
+      loader.AddStaticComponents();
+
+      if (!component_folders.isEmpty()) {
+        loader.AddComponents(component_folders);
+      }
+
+      loader.LoadComponents();
+      loader.ActivateTrigger(sss::extsystem::ComponentLoader::ActivationTrigger::kMode, mode);
+
+      auto elapsed_us = timer.nsecsElapsed() / 1000;
+      auto components = loader.Components();
+
+      activated_count = static_cast<int>(std::count_if(
+          components.cbegin(), components.cend(), [&mode](sss::extsystem::Component* component) {
+            return component->IsLoaded() &&
+                   component->ActivationTriggers(sss::extsystem::ComponentLoader::ActivationTrigger::kMode)
+                       .contains(mode);
+          }));
+
+      loader.UnloadComponents();
+
+      return elapsed_us;
+    };
+
+    std::vector<qint64> static_timings;
+    std::vector<qint64> shared_timings;
+
+    for (int iteration = 0; iteration < kIterations; iteration++) {
+      auto static_count = 0;
+      auto shared_count = 0;
+
+      static_timings.push_back(start_components("tests.benchmark.static", QStringList(), static_count));
+      shared_timings.push_back(
+          start_components("tests.benchmark.shared", QStringList{DS_STATIC_BENCHMARK_DIR}, shared_count));
+
+      REQUIRE(static_count == DS_STATIC_BENCHMARK_COMPONENTS);
+      REQUIRE(shared_count == DS_STATIC_BENCHMARK_COMPONENTS);
+    }
+
+    std::sort(static_timings.begin(), static_timings.end());
+    std::sort(shared_timings.begin(), shared_timings.end());
+
+    auto static_us = static_timings.at(kIterations / 2);
+    auto shared_us = shared_timings.at(kIterations / 2);
+
+    MESSAGE(DS_STATIC_BENCHMARK_COMPONENTS << " components, median of " << kIterations << " runs: static " << static_us
+                                           << "us, shared libraries " << shared_us << "us");
+
+    CHECK(static_us <= shared_us);
+#else
+    MESSAGE("Configure with TESTS_BUILD_STATIC_BENCHMARK=ON on Linux to build the benchmark components");
+#endif
+  }
+}
+
+#include "test_static_components.moc"
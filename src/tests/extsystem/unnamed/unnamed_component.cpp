@@ -0,0 +1,16 @@
+// 测试插件以 Qt 静态插件的形式编译进测试程序，moc 生成 qt_static_plugin_UnnamedTestComponent()
+#define QT_STATICPLUGIN
+
+#include <extsystem/IComponent.h>
+
+#include <QObject>
+#include <QtPlugin>
+
+// 元数据中没有 "Name"，组件名称回退到插件类名；通过激活模式延迟加载，其他测试不会初始化它
+class UnnamedTestComponent : public QObject, public sss::extsystem::IComponent {
+  Q_OBJECT
+  Q_PLUGIN_METADATA(IID SSSComponentInterfaceIID FILE "unnamed_component.json")
+  Q_INTERFACES(sss::extsystem::IComponent)
+};
+
+#include "unnamed_component.moc"
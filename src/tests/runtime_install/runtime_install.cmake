@@ -0,0 +1,25 @@
+# 运行时安装测试插件：编译为独立的共享库，tests 程序将其复制到临时文件夹后通过 ComponentLoader::InstallComponents
+# 安装。插件中未定义的 extsystem 符号在加载时解析到 tests 程序导出的符号，因此与测试使用同一个组件管理器。
+#
+# 依赖可执行文件导出符号供插件使用，只在 Linux 上构建，其他平台跳过对应的测试。
+
+set(_runtime_install_source_dir "${CMAKE_CURRENT_BINARY_DIR}/runtime_install")
+
+configure_file(${CMAKE_CURRENT_LIST_DIR}/RuntimeInstallComponent.json
+               ${_runtime_install_source_dir}/RuntimeInstallComponent.json COPYONLY)
+configure_file(${CMAKE_CURRENT_LIST_DIR}/RuntimeInstallComponent.cpp.in
+               ${_runtime_install_source_dir}/RuntimeInstallComponent.cpp COPYONLY)
+
+add_library(runtime_install_plugin MODULE ${_runtime_install_source_dir}/RuntimeInstallComponent.cpp)
+target_include_directories(runtime_install_plugin PRIVATE ${CMAKE_CURRENT_SOURCE_DIR}/../extsystem/include
+                                                          ${CMAKE_CURRENT_SOURCE_DIR}/../dscore/include)
+target_link_libraries(runtime_install_plugin PRIVATE Qt5::Widgets)
+target_compile_features(runtime_install_plugin PRIVATE cxx_std_17)
+set_target_properties(
+  runtime_install_plugin
+  PROPERTIES AUTOMOC ON
+             LIBRARY_OUTPUT_DIRECTORY "${CMAKE_BINARY_DIR}/$<CONFIG>/runtime_install_plugin")
+
+set_target_properties(${PROJECT_NAME} PROPERTIES ENABLE_EXPORTS ON)
+add_dependencies(${PROJECT_NAME} runtime_install_plugin)
+target_compile_definitions(${PROJECT_NAME} PRIVATE DS_RUNTIME_INSTALL_PLUGIN="$<TARGET_FILE:runtime_install_plugin>")
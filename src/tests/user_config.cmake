@@ -21,3 +21,35 @@ target_include_directories(${PROJECT_NAME} PRIVATE ${CMAKE_SOURCE_DIR}/src/extsy
 
 # 设置用户自定义编译定义，根据需要添加
 # list(APPEND PROJECT_COMPILE_DEFINITIONS MY_DEFINE=1 MY_FLAG)
+
+# LibraryPrefetcher 在工作线程中用 dlopen 预先打开组件库
+if(CMAKE_DL_LIBS)
+  target_link_libraries(${PROJECT_NAME} PRIVATE ${CMAKE_DL_LIBS})
+endif()
+
+# 进程内基准测试默认跳过，run_benchmarks 目标设置 DS_RUN_BENCHMARKS 后只运行名称以 Benchmark 结尾的测试套件
+add_custom_target(
+  run_benchmarks
+  COMMAND ${CMAKE_COMMAND} -E env "DS_RUN_BENCHMARKS=1" $<TARGET_FILE:${PROJECT_NAME}> "--test-suite=*Benchmark"
+  DEPENDS ${PROJECT_NAME}
+  USES_TERMINAL VERBATIM
+  COMMENT "Running the in-process benchmarks")
+
+# 运行时安装测试使用的共享库插件，见 runtime_install/runtime_install.cmake
+if(CMAKE_SYSTEM_NAME STREQUAL "Linux")
+  include(${CMAKE_CURRENT_SOURCE_DIR}/runtime_install/runtime_install.cmake)
+endif()
+
+# 组件加载器基准测试（生成插件并提供 run_loader_benchmark 目标），见 benchmark/loader_benchmark.cmake
+option(TESTS_BUILD_LOADER_BENCHMARK "Generate benchmark plugins and the run_loader_benchmark target" OFF)
+
+if(TESTS_BUILD_LOADER_BENCHMARK)
+  include(${CMAKE_CURRENT_SOURCE_DIR}/benchmark/loader_benchmark.cmake)
+endif()
+
+# 同一组组件的静态插件与共享库插件的启动耗时对比，见 benchmark/static_benchmark.cmake
+option(TESTS_BUILD_STATIC_BENCHMARK "Build the components compared by the static component benchmark" OFF)
+
+if(TESTS_BUILD_STATIC_BENCHMARK AND CMAKE_SYSTEM_NAME STREQUAL "Linux")
+  include(${CMAKE_CURRENT_SOURCE_DIR}/benchmark/static_benchmark.cmake)
+endif()
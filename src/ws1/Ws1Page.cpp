@@ -22,15 +22,15 @@
 
 namespace sss::ws1 {
 
-Ws1Page::Ws1Page(int context_id, QObject* parent) : sss::dscore::IMode(parent), context_id_(context_id) {
+Ws1Page::Ws1Page(int context_id, QObject* parent)
+    : sss::dscore::IMode(parent),
+      context_id_(context_id),
+      // 连接到主题服务（包括稍后才注册的主题服务）
+      theme_service_([this](sss::dscore::IThemeService* theme_service) {
+        connect(theme_service, &sss::dscore::IThemeService::ThemeChanged, this, &Ws1Page::UpdateIcons);
+      }) {
   SPDLOG_INFO("Ws1Page (Mode) constructor called.");
 
-  // 连接到主题服务
-  auto* theme_service = sss::extsystem::GetTObject<sss::dscore::IThemeService>();
-  if (theme_service != nullptr) {
-    connect(theme_service, &sss::dscore::IThemeService::ThemeChanged, this, &Ws1Page::UpdateIcons);
-  }
-
   auto* lang_service = sss::extsystem::GetTObject<sss::dscore::ILanguageService>();
   if (lang_service != nullptr) {
     connect(lang_service, &sss::dscore::ILanguageService::LanguageChanged, this,
@@ -63,9 +63,8 @@ Ws1Page::~Ws1Page() {
 QString Ws1Page::Id() const { return "ws1.mode"; }
 QString Ws1Page::Title() const { return Ws1Strings::WorkspaceTitle(); }
 QIcon Ws1Page::Icon() const {
-  auto* theme_service = sss::extsystem::GetTObject<sss::dscore::IThemeService>();
-  if (theme_service != nullptr) {
-    return theme_service->GetIcon(":/ws1/resources/icons", "workspace1.svg");
+  if (theme_service_) {
+    return theme_service_->GetIcon(":/ws1/resources/icons", "workspace1.svg");
   }
   return {};  // 如果主题服务不可用则返回空图标
 }
@@ -105,9 +104,8 @@ void Ws1Page::Activate() {
   QTimer::singleShot(500, [workbench, this]() { workbench->ShowNotification(Ws1Strings::WelcomeMessage(), 3000); });
 
   // 更新图标
-  auto* theme_service = sss::extsystem::GetTObject<sss::dscore::IThemeService>();
-  if ((theme_service != nullptr) && (theme_service->Theme() != nullptr)) {
-    UpdateIcons(theme_service->Theme()->Id());
+  if (theme_service_ && (theme_service_->Theme() != nullptr)) {
+    UpdateIcons(theme_service_->Theme()->Id());
   } else {
     UpdateIcons("light");
   }
@@ -165,12 +163,11 @@ void Ws1Page::setupDefaultUi() {
 }
 
 void Ws1Page::UpdateIcons(const QString& /*theme_id*/) {
-  auto* theme_service = sss::extsystem::GetTObject<sss::dscore::IThemeService>();
-  if (theme_service == nullptr) return;
+  if (!theme_service_) return;
 
   const QString base_path = ":/ws1/resources/icons";
-  if (enable_button_ != nullptr) enable_button_->setIcon(theme_service->GetIcon(base_path, "action_enable.svg"));
-  if (disable_button_ != nullptr) disable_button_->setIcon(theme_service->GetIcon(base_path, "action_disable.svg"));
+  if (enable_button_ != nullptr) enable_button_->setIcon(theme_service_->GetIcon(base_path, "action_enable.svg"));
+  if (disable_button_ != nullptr) disable_button_->setIcon(theme_service_->GetIcon(base_path, "action_disable.svg"));
 }
 
 void Ws1Page::SetSubContextId(int id) { sub_context_id_ = id; }
@@ -4,6 +4,8 @@
 #include <QPointer>
 
 #include "dscore/IMode.h"
+#include "dscore/IThemeService.h"
+#include "extsystem/ServiceTracker.h"
 
 QT_BEGIN_NAMESPACE
 class QStandardItemModel;
@@ -66,6 +68,8 @@ class Ws1Page : public sss::dscore::IMode {
 
   int context_id_ = 0;
   int sub_context_id_ = 0;
+
+  sss::extsystem::ServiceTracker<sss::dscore::IThemeService> theme_service_;
 };
 
 }  // namespace sss::ws1